@@ -0,0 +1,305 @@
+/**
+ **********************************************************************************************************************
+ * @file         adc_stream.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Binary streaming of decimated ADC samples over debug UART.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+
+#include "adc_stream.h"
+
+#include "periph/uart.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** ADC stream thread attributes. */
+const osThreadAttr_t adc_stream_thread_attr =
+{
+    .name = "ADC_STREAM",
+    .stack_size = 256,
+    .priority = osPriorityBelowNormal,
+};
+
+#define ADC_STREAM_PERIOD       1   //!< Pass period in ms, every pass sends at most one frame per channel.
+#define ADC_STREAM_SETTLE       3   //!< Time in ms for changed filter to take effect, longer than DMA block.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Thread flag set when stream is started. */
+#define ADC_STREAM_FLAG_START   0x0001U
+/** Bytes of frame header. */
+#define ADC_STREAM_HEADER       6
+/** Bytes of largest frame. */
+#define ADC_STREAM_FRAME_SIZE   (ADC_STREAM_HEADER + 2 * ADC_STREAM_SAMPLES + 1)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/* Stream thread ID */
+static osThreadId_t adc_stream_thread_id = NULL;
+/* Streamed channels */
+static volatile uint32_t adc_stream_mask = 0;
+/* Channels switched to raw conversions */
+static volatile uint32_t adc_stream_raw = 0;
+/* Filters of raw streamed channels, restored on stop */
+static adc_filter_cfg_t adc_stream_filter[ADC_ID_LAST];
+/* Stream readers, separate from other readers of channels */
+static adc_reader_t adc_stream_reader[ADC_ID_LAST];
+/* Expected sequence number of next sample of each channel */
+static uint16_t adc_stream_seq[ADC_ID_LAST];
+/* Frame being sent */
+static uint8_t adc_stream_frame[ADC_STREAM_FRAME_SIZE];
+/* Statistics */
+static adc_stream_stats_t adc_stream_stats;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void adc_stream_thread(void *arguments);
+static bool adc_stream_send(adc_id_t id);
+static void adc_stream_restore(void);
+static uint8_t adc_stream_crc(const uint8_t *data, uint32_t size);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool adc_stream_init(void)
+{
+    if((adc_stream_thread_id = osThreadNew(&adc_stream_thread, NULL, &adc_stream_thread_attr)) == NULL)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool adc_stream_start(uint32_t mask, bool raw)
+{
+    adc_filter_cfg_t cfg = {.filter = ADC_FILTER_BOXCAR};
+    uint8_t id = 0;
+
+    if(adc_stream_thread_id == NULL || mask == 0 || mask >= (1UL << ADC_ID_LAST))
+    {
+        return false;
+    }
+
+    adc_stream_mask = 0;
+    adc_stream_restore();
+    for(id = 0; raw && id < ADC_ID_LAST; id++)
+    {
+        if((mask & (1UL << id)) == 0)
+        {
+            continue;
+        }
+        adc_get_filter((adc_id_t)id, &adc_stream_filter[id]);
+        cfg.rate = adc_get_input_rate((adc_id_t)id);
+        if(adc_set_filter((adc_id_t)id, &cfg) == false)
+        {
+            adc_stream_restore();
+            return false;
+        }
+        adc_stream_raw |= 1UL << id;
+    }
+    if(raw)
+    {
+        /* Samples of old filter are not tagged as raw */
+        osDelay(ADC_STREAM_SETTLE);
+    }
+
+    adc_stream_mask = mask;
+    osThreadFlagsSet(adc_stream_thread_id, ADC_STREAM_FLAG_START);
+
+    return true;
+}
+
+void adc_stream_stop(void)
+{
+    adc_stream_mask = 0;
+    adc_stream_restore();
+
+    return;
+}
+
+uint32_t adc_stream_get_mask(void)
+{
+    return adc_stream_mask;
+}
+
+void adc_stream_get_stats(adc_stream_stats_t *stats)
+{
+    *stats = adc_stream_stats;
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void adc_stream_thread(void *arguments)
+{
+    uint32_t mask = 0;
+    uint32_t tick = 0;
+    uint8_t id = 0;
+    bool first = false;
+
+    while(1)
+    {
+        if(adc_stream_mask == 0)
+        {
+            osThreadFlagsWait(ADC_STREAM_FLAG_START, osFlagsWaitAny, osWaitForever);
+            continue;
+        }
+        /* Started or restarted with other channels */
+        first = (osThreadFlagsClear(ADC_STREAM_FLAG_START) & ADC_STREAM_FLAG_START) != 0;
+        if(first)
+        {
+            memset(&adc_stream_stats, 0, sizeof(adc_stream_stats));
+            tick = osKernelGetTickCount();
+            /* Stream starts with samples taken from now on */
+            for(id = 0; id < ADC_ID_LAST; id++)
+            {
+                adc_reader_init(&adc_stream_reader[id], (adc_id_t)id);
+                adc_stream_seq[id] = adc_stream_reader[id].tail;
+            }
+        }
+
+        mask = adc_stream_mask;
+        for(id = 0; id < ADC_ID_LAST; id++)
+        {
+            if((mask & (1UL << id)) == 0)
+            {
+                continue;
+            }
+            if(uart_0_tx_free() < ADC_STREAM_FRAME_SIZE)
+            {
+                adc_stream_stats.stalls++;
+                break;
+            }
+            adc_stream_send((adc_id_t)id);
+        }
+
+        tick += ADC_STREAM_PERIOD;
+        if((int32_t)(tick - osKernelGetTickCount()) <= 0)
+        {
+            /* Fell behind, do not try to catch up */
+            tick = osKernelGetTickCount() + ADC_STREAM_PERIOD;
+        }
+        osDelayUntil(tick);
+    }
+}
+
+/**
+ * @brief   Read new samples of channel and queue them as single frame.
+ *
+ * @param   id      ADC ID.
+ *
+ * @return  True if frame was queued.
+ */
+static bool adc_stream_send(adc_id_t id)
+{
+    uint16_t samples[ADC_STREAM_SAMPLES];
+    uint16_t count = 0;
+    uint16_t seq = 0;
+    uint16_t i = 0;
+    uint8_t *frame = adc_stream_frame;
+
+    if((count = adc_read(&adc_stream_reader[id], samples, ADC_STREAM_SAMPLES, &seq)) == 0)
+    {
+        return false;
+    }
+    adc_stream_stats.lost += (uint16_t)(seq - adc_stream_seq[id]);
+    adc_stream_seq[id] = seq + count;
+
+    frame[0] = ADC_STREAM_SYNC_0;
+    frame[1] = ADC_STREAM_SYNC_1;
+    frame[2] = (uint8_t)id | ((adc_stream_raw & (1UL << id)) ? ADC_STREAM_RAW : 0);
+    frame[3] = (uint8_t)count;
+    frame[4] = (uint8_t)seq;
+    frame[5] = (uint8_t)(seq >> 8);
+    for(i = 0; i < count; i++)
+    {
+        frame[ADC_STREAM_HEADER + 2 * i] = (uint8_t)samples[i];
+        frame[ADC_STREAM_HEADER + 2 * i + 1] = (uint8_t)(samples[i] >> 8);
+    }
+    frame[ADC_STREAM_HEADER + 2 * count] = adc_stream_crc(&frame[2], ADC_STREAM_HEADER - 2 + 2 * count);
+    uart_0_send_rb(frame, ADC_STREAM_HEADER + 2 * count + 1);
+
+    adc_stream_stats.frames++;
+    adc_stream_stats.samples += count;
+
+    return true;
+}
+
+/**
+ * @brief   Calculate CRC-8 with polynomial 0x07 and initial value 0.
+ *
+ * @param   data    Data.
+ * @param   size    Data size in bytes.
+ *
+ * @return  CRC.
+ */
+static uint8_t adc_stream_crc(const uint8_t *data, uint32_t size)
+{
+    uint8_t crc = 0;
+    uint8_t bit = 0;
+
+    while(size--)
+    {
+        crc ^= *data++;
+        for(bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief   Restore filters of raw streamed channels.
+ */
+static void adc_stream_restore(void)
+{
+    uint8_t id = 0;
+
+    for(id = 0; id < ADC_ID_LAST; id++)
+    {
+        if(adc_stream_raw & (1UL << id))
+        {
+            adc_set_filter((adc_id_t)id, &adc_stream_filter[id]);
+        }
+    }
+    adc_stream_raw = 0;
+
+    return;
+}
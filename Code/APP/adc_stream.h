@@ -0,0 +1,126 @@
+/**
+ **********************************************************************************************************************
+ * @file        adc_stream.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Binary streaming of decimated ADC samples over debug UART.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef ADC_STREAM_H_
+#define ADC_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "periph/adc.h"
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+/*
+ * Frame, multi-byte fields are little endian:
+ *  0   ADC_STREAM_SYNC_0
+ *  1   ADC_STREAM_SYNC_1
+ *  2   ADC ID, see @ref adc_id_t, ORed with ADC_STREAM_RAW in raw mode.
+ *  3   Sample count n, 1 to ADC_STREAM_SAMPLES.
+ *  4   Sequence number of first sample (16 bits), samples of channel are numbered continuously.
+ *  6   n samples (16 bits), 12 + filter bits.
+ *  6+2n CRC-8 (polynomial 0x07, initial 0) of bytes 2 to 5+2n.
+ * Samples are decimated filter output of channel (see adc_set_filter). In raw mode stream switches every streamed
+ * channel to boxcar of single conversion, so samples are raw 12 bit conversions, and restores channel filter when
+ * stopped. UART carries about 5000 samples per second, faster channels show gaps counted as lost samples. Debug lines
+ * share UART transmit ring with frames and land between them, decoder skips them by sync bytes and CRC.
+ * Tools/adc_stream.py decodes frames to CSV or NPY.
+ */
+#define ADC_STREAM_SYNC_0       0xA5    //!< First sync byte of frame.
+#define ADC_STREAM_SYNC_1       0x5A    //!< Second sync byte of frame.
+#define ADC_STREAM_SAMPLES      16      //!< Maximum samples per frame.
+#define ADC_STREAM_RAW          0x80    //!< ID flag of frames with raw conversions.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Stream statistics since last start.
+ */
+typedef struct
+{
+    uint32_t frames;        //!< Frames sent.
+    uint32_t samples;       //!< Samples sent.
+    uint32_t lost;          //!< Samples dropped by ADC before stream read them.
+    uint32_t stalls;        //!< Passes that found UART transmit buffer full.
+} adc_stream_stats_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize stream and start its thread. Thread sleeps until stream is started.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool adc_stream_init(void);
+
+/**
+ * @brief   Start streaming selected channels. Restarting resets statistics and restores filters of previous raw
+ *          stream. Other readers of raw streamed channels get raw conversions too until stream is stopped.
+ *
+ * @param   mask    Bit (1 << id) set for every streamed channel, see @ref adc_id_t.
+ * @param   raw     Stream raw conversions instead of filter output.
+ *
+ * @return  False if mask is empty or has unknown channels, or raw filter could not be set.
+ */
+bool adc_stream_start(uint32_t mask, bool raw);
+
+/**
+ * @brief   Stop streaming and restore filters of raw streamed channels.
+ */
+void adc_stream_stop(void);
+
+/**
+ * @brief   Get streamed channels.
+ *
+ * @return  Channel mask, 0 if stream is stopped.
+ */
+uint32_t adc_stream_get_mask(void);
+
+/**
+ * @brief   Get stream statistics.
+ *
+ * @param   stats   Pointer to structure where statistics will be copied.
+ */
+void adc_stream_get_stats(adc_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_STREAM_H_ */
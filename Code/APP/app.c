@@ -27,9 +27,12 @@
 #include "chip.h"
 #include "cmsis_os2.h"
 
+#include "adc_stream.h"
 #include "app.h"
 #include "debug.h"
+#include "i2c_sched.h"
 #include "indication.h"
+#include "spi_bus.h"
 #include "bsp.h"
 
 #include "cli/cli_app.h"
@@ -103,7 +106,7 @@ int main(void)
     DEBUG_BOOT(" # DS-2 Controller #");
     DEBUG_BOOT(" * Booting.");
     DEBUG_BOOT("%-15.15s %s %s", "Build:", __DATE__, __TIME__);
-    DEBUG_BOOT("%-15.15s %ld Hz.", "Core Clock:", SystemCoreClock);
+    DEBUG_BOOT("%-15.15s %u Hz.", "Core Clock:", SystemCoreClock);
     
     // Setup and initialize peripherals.
     DEBUG_BOOT("%-15.15s ok.", "BSP:");
@@ -181,10 +184,16 @@ static void app_thread(void *arguments)
     DEBUG_INIT("%-15.15s ok.", "Ultrasonic:");
     ret = joystick_init();
     DEBUG_INIT("%-15.15s %s.", "Joystick:", ret == false ? "err" : "ok");
+    ret = i2c_sched_init();
+    DEBUG_INIT("%-15.15s %s.", "I2C sched:", ret == false ? "err" : "ok");
     //ret = sensors_init();
     //DEBUG_INIT("%-15.15s %s.", "Sensors:", ret == false ? "err" : "ok");
     ret = motor_init();
     DEBUG_INIT("%-15.15s %s.", "Motor:", ret == false ? "err" : "ok");
+    ret = spi_bus_init();
+    DEBUG_INIT("%-15.15s %s.", "SPI bus:", ret == false ? "err" : "ok");
+    ret = adc_stream_init();
+    DEBUG_INIT("%-15.15s %s.", "ADC stream:", ret == false ? "err" : "ok");
     ret = display_init();
     DEBUG_INIT("%-15.15s %s.", "Display:", ret == false ? "err" : "ok");
 
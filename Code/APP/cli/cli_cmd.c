@@ -26,17 +26,28 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "cmsis_os2.h"
+
 #include "cli_cmd.h"
 #include "cli.h"
 
 #include "debug.h"
 #include "servo/servo.h"
+#include "display/ssd1306_vpanel.h"
 #include "common.h"
+#include "cpu_load.h"
+#include "spi_bus.h"
+#include "i2c_sched.h"
+#include "adc_stream.h"
+#include "sensors/filters.h"
+#include "motor/motor.h"
 #include "bsp.h"
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
+#define CLI_CMD_FILTERS_COUNT   64      //!< Filter updates timed by info command.
+#define CLI_CMD_FILTERS_FRAC    4       //!< Fraction bits of timed filter input, like motor and light sensor.
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -76,6 +87,24 @@ const cli_cmd_t cli_cmd_list[CLI_CMD_COUNT] =
         cli_cmd_pointer_cb,
         2,
     },
+    {
+        (const uint8_t *)"screen",
+        (const uint8_t *)"screen    Dump display content as PBM image.",
+        cli_cmd_screen_cb,
+        0,
+    },
+    {
+        (const uint8_t *)"stream",
+        (const uint8_t *)"stream    Binary ADC stream: $start $id..., $raw $id..., $stop or status.",
+        cli_cmd_stream_cb,
+        -1,
+    },
+    {
+        (const uint8_t *)"motor",
+        (const uint8_t *)"motor     Motor loop: $current $id $mA, $neutral $id, $reset or status.",
+        cli_cmd_motor_cb,
+        -1,
+    },
 };
 
 /**********************************************************************************************************************
@@ -85,6 +114,10 @@ const cli_cmd_t cli_cmd_list[CLI_CMD_COUNT] =
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+#if SSD1306_VPANEL
+static void cli_cmd_screen_writer(const uint8_t *data, uint32_t size);
+#endif
+static void cli_cmd_filters_cycles(uint32_t *low_pass, uint32_t *kalman);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -114,11 +147,34 @@ bool cli_cmd_help_cb(uint8_t *data, size_t size, const uint8_t *cmd)
 
 bool cli_cmd_info_cb(uint8_t *data, size_t size, const uint8_t *cmd)
 {
+    const char *names[SPI_BUS_DEVICE_LAST] = {"display", "radio"};
+    char tmp[FMT_FIXED_SIZE];
+    spi_bus_stats_t stats;
+    i2c_sched_stats_t i2c_stats;
+    spi_bus_device_t device = SPI_BUS_DEVICE_DISPLAY;
+    uint32_t uptime = osKernelGetTickCount();
+    uint32_t cycles[2] = {0};
+
     UNUSED_VARIABLE(cmd);
 
     DEBUG("Device ...... DS-2 Controller");
     DEBUG("Build ....... %s %s", __DATE__, __TIME__);
-    DEBUG("Core Clock .. %ld MHz.", SystemCoreClock);
+    DEBUG("Core Clock .. %u MHz.", SystemCoreClock / 1000000);
+    DEBUG("CPU Load .... %s %%", fmt_fixed(tmp, cpu_load_get(), 1));
+    for(device = SPI_BUS_DEVICE_DISPLAY; device < SPI_BUS_DEVICE_LAST; device++)
+    {
+        spi_bus_get_stats(device, &stats);
+        /* Busy us per uptime ms gives 0.1 % units */
+        DEBUG("SPI %-8.8s busy %s %%, %u grants, wait max %u us, avg %u us.", names[device],
+            fmt_fixed(tmp, uptime == 0 ? 0 : (uint32_t)(stats.busy_us / uptime), 1), stats.count, stats.wait_max_us,
+            stats.count == 0 ? 0 : (uint32_t)(stats.wait_us / stats.count));
+    }
+    i2c_sched_get_stats(&i2c_stats);
+    DEBUG("I2C busy %s %%, %u xfers, %u nacks, %u timeouts, %u errors, %u misses, latency max %u ms.",
+        fmt_fixed(tmp, uptime == 0 ? 0 : (uint32_t)(i2c_stats.busy_us / uptime), 1), i2c_stats.count,
+        i2c_stats.nacks, i2c_stats.timeouts, i2c_stats.errors, i2c_stats.misses, i2c_stats.latency_max_ms);
+    cli_cmd_filters_cycles(&cycles[0], &cycles[1]);
+    DEBUG("Filters ..... low pass Q %u, Kalman Q %u cycles.", cycles[0], cycles[1]);
 
     return false;
 }
@@ -208,3 +264,182 @@ bool cli_cmd_pointer_cb(uint8_t *data, size_t size, const uint8_t *cmd)
 
     return false;
 }
+
+bool cli_cmd_screen_cb(uint8_t *data, size_t size, const uint8_t *cmd)
+{
+    UNUSED_VARIABLE(cmd);
+
+#if SSD1306_VPANEL
+    ssd1306_vpanel_dump(cli_cmd_screen_writer, SSD1306_VPANEL_FORMAT_PBM);
+#else
+    DEBUG("Display mirror is disabled.");
+#endif
+
+    return false;
+}
+
+bool cli_cmd_stream_cb(uint8_t *data, size_t size, const uint8_t *cmd)
+{
+    uint8_t ptr_size = 0;
+    uint8_t *ptr = NULL;
+    uint8_t i = 2;
+    int id = 0;
+    uint32_t mask = 0;
+    bool raw = false;
+    adc_stream_stats_t stats;
+
+    // No $action parameter shows status.
+    if((ptr = (uint8_t *)cli_get_parameter(cmd, 1, &ptr_size)) == NULL)
+    {
+        adc_stream_get_stats(&stats);
+        DEBUG("Stream mask 0x%02X, %u frames, %u samples, %u lost, %u stalls.", adc_stream_get_mask(),
+            stats.frames, stats.samples, stats.lost, stats.stalls);
+        return false;
+    }
+    if(memcmp(ptr, "stop", ptr_size) == 0)
+    {
+        adc_stream_stop();
+        DEBUG("Stream stopped.");
+        return false;
+    }
+    raw = memcmp(ptr, "raw", ptr_size) == 0;
+    if(memcmp(ptr, "start", ptr_size) != 0 && raw == false)
+    {
+        return false;
+    }
+
+    // Check $id parameters
+    while((ptr = (uint8_t *)cli_get_parameter(cmd, i++, &ptr_size)) != NULL)
+    {
+        id = atoi((char *)ptr);
+        if(id < 0 || id >= ADC_ID_LAST)
+        {
+            DEBUG("Unknown ADC %d.", id);
+            return false;
+        }
+        mask |= 1UL << id;
+    }
+    if(adc_stream_start(mask, raw) == true)
+    {
+        DEBUG("Stream started, mask 0x%02X%s.", mask, raw ? ", raw" : "");
+    }
+    else
+    {
+        DEBUG("Stream start failed.");
+    }
+
+    return false;
+}
+
+bool cli_cmd_motor_cb(uint8_t *data, size_t size, const uint8_t *cmd)
+{
+    uint8_t ptr_size = 0;
+    uint8_t *ptr = NULL;
+    int id = 0;
+    uint8_t i = 0;
+    bool neutral = false;
+    motor_stats_t stats;
+
+    // No $action parameter shows status.
+    if((ptr = (uint8_t *)cli_get_parameter(cmd, 1, &ptr_size)) == NULL)
+    {
+        motor_get_stats(&stats);
+        DEBUG("Loop ........ %u periods, %u overruns, %u stale, %u faults, jitter max %u us.", stats.loops,
+            stats.overruns, stats.stale, stats.faults, stats.jitter_max);
+        DEBUG("Execution ... avg %u us, max %u us.", stats.exec_avg, stats.exec_max);
+        for(i = 0; i < MOTOR_ID_LAST; i++)
+        {
+            DEBUG("Motor %u ..... mode %u, duty %d permille, current %u/%d mA, speed %d/%d %%, samples %u.", i,
+                motor_get_mode((motor_id_t)i), motor_get_duty((motor_id_t)i), motor_get_current((motor_id_t)i),
+                motor_get_current_target((motor_id_t)i), motor_get_speed_current((motor_id_t)i),
+                motor_get_speed_target((motor_id_t)i), motor_get_samples((motor_id_t)i));
+        }
+        return false;
+    }
+    if(memcmp(ptr, "reset", ptr_size) == 0)
+    {
+        motor_reset_stats();
+        DEBUG("Motor loop statistics reset.");
+        return false;
+    }
+    neutral = memcmp(ptr, "neutral", ptr_size) == 0;
+    if(neutral == false && memcmp(ptr, "current", ptr_size) != 0)
+    {
+        return false;
+    }
+
+    // Check $id parameter
+    if((ptr = (uint8_t *)cli_get_parameter(cmd, 2, &ptr_size)) == NULL)
+    {
+        return false;
+    }
+    id = atoi((char *)ptr);
+    if(id < 0 || id >= MOTOR_ID_LAST)
+    {
+        DEBUG("Unknown motor %d.", id);
+        return false;
+    }
+
+    if(neutral == true)
+    {
+        motor_neutral((motor_id_t)id);
+        DEBUG("Motor %d neutral.", id);
+        return false;
+    }
+
+    // Check $mA parameter
+    if((ptr = (uint8_t *)cli_get_parameter(cmd, 3, &ptr_size)) == NULL)
+    {
+        return false;
+    }
+    motor_set_current((motor_id_t)id, (int16_t)atoi((char *)ptr));
+    DEBUG("Motor %d current %d mA.", id, motor_get_current_target((motor_id_t)id));
+
+    return false;
+}
+
+#if SSD1306_VPANEL
+static void cli_cmd_screen_writer(const uint8_t *data, uint32_t size)
+{
+    /* Lines end with '\n', DEBUG adds its own line end */
+    DEBUG("%.*s", (int)(size - 1), data);
+
+    return;
+}
+#endif
+
+/**
+ * @brief   Time fixed-point filters with DWT cycle counter on noisy 12 bit ramp. Accuracy is checked by host test.
+ *
+ * @param   low_pass    Average cycles of @ref filter_low_pass_q().
+ * @param   kalman      Average cycles of @ref filters_kalman_q_update().
+ */
+static void cli_cmd_filters_cycles(uint32_t *low_pass, uint32_t *kalman)
+{
+    filters_low_pass_q_t lp = {.cut_off = FILTERS_Q15(0.25)};
+    filters_kalman_q_t kf = filter_kalman_q_init(1 << 8, 1 << 14, 1 << 16, 0);
+    uint32_t start = 0;
+    int32_t input = 0;
+    uint16_t i = 0;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    *low_pass = 0;
+    *kalman = 0;
+    for(i = 0; i < CLI_CMD_FILTERS_COUNT; i++)
+    {
+        input = ((i * 16 + (i * 7919) % 509) & 0xFFF) << CLI_CMD_FILTERS_FRAC;
+
+        start = DWT->CYCCNT;
+        filter_low_pass_q(&lp, input);
+        *low_pass += DWT->CYCCNT - start;
+        start = DWT->CYCCNT;
+        filters_kalman_q_update(&kf, input);
+        *kalman += DWT->CYCCNT - start;
+    }
+    *low_pass /= CLI_CMD_FILTERS_COUNT;
+    *kalman /= CLI_CMD_FILTERS_COUNT;
+
+    return;
+}
@@ -33,7 +33,7 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
-#define CLI_CMD_COUNT       4  //!< Maximum count of commands in CLI.
+#define CLI_CMD_COUNT       7  //!< Maximum count of commands in CLI.
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -54,6 +54,9 @@ bool cli_cmd_help_cb(uint8_t *data, size_t size, const uint8_t *cmd);
 bool cli_cmd_info_cb(uint8_t *data, size_t size, const uint8_t *cmd);
 bool cli_cmd_servo_cb(uint8_t *data, size_t size, const uint8_t *cmd);
 bool cli_cmd_pointer_cb(uint8_t *data, size_t size, const uint8_t *cmd);
+bool cli_cmd_screen_cb(uint8_t *data, size_t size, const uint8_t *cmd);
+bool cli_cmd_stream_cb(uint8_t *data, size_t size, const uint8_t *cmd);
+bool cli_cmd_motor_cb(uint8_t *data, size_t size, const uint8_t *cmd);
 
 #ifdef __cplusplus
 }
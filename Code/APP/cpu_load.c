@@ -0,0 +1,99 @@
+/**
+ **********************************************************************************************************************
+ * @file         cpu_load.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        CPU load measurement in idle thread.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+#include "chip.h"
+#include "cmsis_os2.h"
+
+#include "cpu_load.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** CPU load of last window, 0.1 % units. */
+static volatile uint32_t cpu_load = 0;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+uint32_t cpu_load_get(void)
+{
+    return cpu_load;
+}
+
+/**
+ * @brief   Idle thread, replaces weak RTX one. Sleeps until interrupt and counts time spent sleeping.
+ *          Interrupts are masked around WFI, so timer is read before woken up thread runs and its time is not
+ *          counted as idle.
+ */
+__NO_RETURN void osRtxIdleThread(void *argument)
+{
+    uint32_t window = (uint32_t)(((uint64_t)osKernelGetSysTimerFreq() * CPU_LOAD_WINDOW) / 1000);
+    uint32_t window_start = osKernelGetSysTimerCount();
+    uint32_t idle = 0;
+    uint32_t start = 0;
+    uint32_t now = 0;
+
+    (void)argument;
+
+    for(;;)
+    {
+        __disable_irq();
+        start = osKernelGetSysTimerCount();
+        __WFI();
+        now = osKernelGetSysTimerCount();
+        __enable_irq();
+
+        idle += now - start;
+        if(now - window_start >= window)
+        {
+            cpu_load = 1000 - (uint32_t)(((uint64_t)idle * 1000) / (now - window_start));
+            window_start = now;
+            idle = 0;
+        }
+    }
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
@@ -20,7 +20,6 @@
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
-#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdarg.h>
@@ -29,6 +28,7 @@
 #include "cmsis_os2.h"
 
 #include "debug.h"
+#include "fmt.h"
 
 /**********************************************************************************************************************
  * Private constants
@@ -75,9 +75,8 @@ void debug_send(const char *fmt, ...)
     va_list args;
 
     va_start(args, fmt);
-    i = vsnprintf((char*)debug_buffer, DEBUG_BUFFER_SIZE - 1, fmt, args);
-    debug_buffer[i] = 0x00;     // Make sure its zero terminated
-    uart_0_send(debug_buffer, i);
+    i = fmt_vsnprintf((char*)debug_buffer, DEBUG_BUFFER_SIZE, fmt, args);
+    uart_0_send_rb(debug_buffer, i);
     va_end(args);
 
     return;
@@ -91,9 +90,9 @@ void debug_send_os(const char *fmt, ...)
     if (osSemaphoreAcquire(debug_lock_id, DEBUG_LOCK_TIMEOUT) >= 0)
     {
         va_start(args, fmt);
-        i = vsnprintf((char*)debug_buffer, DEBUG_BUFFER_SIZE - 1, fmt, args);
-        debug_buffer[i] = 0x00;     // Make sure its zero terminated
-        uart_0_send(debug_buffer, i);
+        i = fmt_vsnprintf((char*)debug_buffer, DEBUG_BUFFER_SIZE, fmt, args);
+        /* Same transmit ring as ADC stream, lines land between frames */
+        uart_0_send_rb(debug_buffer, i);
         va_end(args);
         osSemaphoreRelease(debug_lock_id);
     }
@@ -29,6 +29,8 @@ extern "C" {
  *********************************************************************************************************************/
 #include <stdbool.h>
 
+#include "fmt.h"
+
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
@@ -54,8 +56,8 @@ extern "C" {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 bool debug_init(void);
-void debug_send(const char *fmt, ...);
-void debug_send_os(const char *fmt, ...);
+void debug_send(const char *fmt, ...) FMT_CHECK(1, 2);
+void debug_send_os(const char *fmt, ...) FMT_CHECK(1, 2);
 void debug_send_blocking(uint8_t *data, uint32_t size);
 
 #ifdef __cplusplus
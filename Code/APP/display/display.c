@@ -22,11 +22,11 @@
  *********************************************************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
 #include <string.h>
 
 #include "display/display.h"
 #include "display/ssd1306.h"
+#include "display/widget.h"
 
 #include "sensors/sensors.h"
 #include "sensors/joystick.h"
@@ -34,6 +34,8 @@
 
 #include "cmsis_os2.h"
 #include "bsp.h"
+#include "fmt.h"
+#include "common.h"
 
 /**********************************************************************************************************************
  * Private constants
@@ -43,6 +45,7 @@
 #define DISPLAY_LINE_Y_2    29
 #define DISPLAY_LINE_Y_3    40
 #define DISPLAY_LINE_Y_4    51
+#define DISPLAY_LINE_CHARS  17
 
 /** Display thread attributes. */
 const osThreadAttr_t display_thread_attr =
@@ -52,6 +55,17 @@ const osThreadAttr_t display_thread_attr =
     .priority = osPriorityNormal,
 };
 
+/** Display timer attributes. */
+const osTimerAttr_t display_timer_attr =
+{
+    .name = "DISPLAY",
+};
+
+#define DISPLAY_FLAG_MENU   0x0001U //!< Menu changed.
+#define DISPLAY_FLAG_TIMER  0x0002U //!< Menu refresh period elapsed.
+#define DISPLAY_FLAG_DATA   0x0004U //!< Shown data changed.
+#define DISPLAY_FLAG_ALL    (DISPLAY_FLAG_MENU | DISPLAY_FLAG_TIMER | DISPLAY_FLAG_DATA)
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
@@ -59,49 +73,152 @@ const osThreadAttr_t display_thread_attr =
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
-typedef void (*display_cb_t)(display_menu_id_t id);
-
 typedef struct
 {
-    uint32_t period;
-    display_cb_t cb;
+    const char *title;      //!< Header title, no header when NULL.
+    bool frame;             //!< Draw frame around screen.
+    uint32_t period;        //!< Refresh period in ms, 0 to draw only once.
+    widget_t *widgets;      //!< Widgets of menu.
+    uint32_t count;         //!< Number of widgets.
     bool enable;
     bool init;
 } display_menu_t;
 
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void display_menu_header(const char *str);
+
+static int32_t display_get_clock(uint32_t arg);
+static int32_t display_get_joystick(uint32_t arg);
+static int32_t display_get_joystick_vector(uint32_t arg);
+static void display_joystick_cb(joystick_id_t id, bool active);
+static int32_t display_get_speed_current(uint32_t arg);
+static int32_t display_get_speed_target(uint32_t arg);
+static int32_t display_get_motor_current(uint32_t arg);
+static int32_t display_get_core_clock(uint32_t arg);
+static int32_t display_get_temperature(uint32_t arg);
+static int32_t display_get_flush_time(uint32_t arg);
+#if DISPLAY_EXTRA
+static int32_t display_get_sensor(uint32_t arg);
+#endif // DISPLAY_EXTRA
+
+static void display_format_time(char *buffer, uint32_t size, int32_t value);
+static void display_format_date(char *buffer, uint32_t size, int32_t value);
+static void display_format_temperature(char *buffer, uint32_t size, int32_t value);
+
+static void display_timer_cb(void *arguments);
+static void display_contrast_control(void);
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 /** Display thread ID. */
 osThreadId_t display_thread_id;
+/** Display refresh timer ID. */
+osTimerId_t display_timer_id;
+/** Last contrast set, light level is mapped to it. */
+static uint16_t display_contrast = UINT16_MAX;
 
-volatile display_menu_id_t display_menu_id = DISPLAY_MENU_ID_WELCOME;
-volatile display_menu_t display_menus[DISPLAY_MENU_ID_LAST] = {0};
+static widget_t display_widgets_welcome[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 40, .y = 20, .font = &fonts_11x18, .text = "DS-2"},
+    {.type = WIDGET_TYPE_LABEL, .x = 25, .y = 40, .font = &fonts_7x10, .text = "Controller"},
+};
 
-/**********************************************************************************************************************
- * Exported variables
- *********************************************************************************************************************/
+static widget_t display_widgets_clock[] =
+{
+    {.type = WIDGET_TYPE_NUMBER, .x = 20, .y = 23, .font = &fonts_11x18, .format = display_format_time, .chars = 8,
+        .get = display_get_clock, .arg = 1},
+    {.type = WIDGET_TYPE_NUMBER, .x = 29, .y = 44, .font = &fonts_7x10, .format = display_format_date, .chars = 10,
+        .get = display_get_clock, .arg = 86400},
+};
 
-/**********************************************************************************************************************
- * Prototypes of local functions
- *********************************************************************************************************************/
-static void display_menu_init(display_menu_id_t id, uint32_t period, display_cb_t cb);
+#if DISPLAY_EXTRA
+static widget_t display_widgets_light[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 46, .y = 10, .font = &fonts_7x10, .text = "Light"},
+    {.type = WIDGET_TYPE_LABEL, .x = 56, .y = 44, .font = &fonts_7x10, .text = "lx."},
+    {.type = WIDGET_TYPE_NUMBER, .x = 3, .y = 23, .font = &fonts_11x18, .align = WIDGET_ALIGN_CENTER,
+        .chars = 11, .get = display_get_sensor, .arg = DISPLAY_MENU_ID_LIGHT},
+};
+
+static widget_t display_widgets_temperature[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 25, .y = 10, .font = &fonts_7x10, .text = "Temperature"},
+    {.type = WIDGET_TYPE_LABEL, .x = 48, .y = 44, .font = &fonts_7x10, .text = "degC."},
+    {.type = WIDGET_TYPE_NUMBER, .x = 3, .y = 23, .font = &fonts_11x18, .align = WIDGET_ALIGN_CENTER,
+        .chars = 11, .get = display_get_sensor, .arg = DISPLAY_MENU_ID_TEMPERATURE},
+};
+
+static widget_t display_widgets_humidity[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 36, .y = 10, .font = &fonts_7x10, .text = "Humidity"},
+    {.type = WIDGET_TYPE_LABEL, .x = 60, .y = 44, .font = &fonts_7x10, .text = "%"},
+    {.type = WIDGET_TYPE_NUMBER, .x = 3, .y = 23, .font = &fonts_11x18, .align = WIDGET_ALIGN_CENTER,
+        .chars = 11, .get = display_get_sensor, .arg = DISPLAY_MENU_ID_HUMIDITY},
+};
+#endif // DISPLAY_EXTRA
 
-static void display_menu_header(display_menu_id_t id, uint8_t *str);
+static widget_t display_widgets_joystick[] =
+{
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_1, .font = &fonts_7x10, .text = "X:  ",
+        .chars = DISPLAY_LINE_CHARS, .get = display_get_joystick, .arg = 0},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_2, .font = &fonts_7x10, .text = "Y:  ",
+        .chars = DISPLAY_LINE_CHARS, .get = display_get_joystick, .arg = 1},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_3, .font = &fonts_7x10, .text = "V:  ",
+        .chars = 9, .get = display_get_joystick_vector, .arg = 0},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X + 9 * 7, .y = DISPLAY_LINE_Y_3, .font = &fonts_7x10,
+        .chars = 8, .get = display_get_joystick_vector, .arg = 1},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_4, .font = &fonts_7x10, .text = "SW: ",
+        .chars = 9, .get = display_get_joystick, .arg = 2},
+};
+
+static widget_t display_widgets_motor[] =
+{
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_1, .font = &fonts_7x10, .text = "L.S: ",
+        .chars = 10, .get = display_get_speed_current, .arg = MOTOR_ID_LEFT},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X + 10 * 7, .y = DISPLAY_LINE_Y_1, .font = &fonts_7x10,
+        .text = "/ ", .chars = 7, .get = display_get_speed_target, .arg = MOTOR_ID_LEFT},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_2, .font = &fonts_7x10, .text = "L.C: ",
+        .suffix = " mA.", .chars = DISPLAY_LINE_CHARS, .get = display_get_motor_current, .arg = MOTOR_ID_LEFT},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_3, .font = &fonts_7x10, .text = "R.S: ",
+        .chars = 10, .get = display_get_speed_current, .arg = MOTOR_ID_RIGHT},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X + 10 * 7, .y = DISPLAY_LINE_Y_3, .font = &fonts_7x10,
+        .text = "/ ", .chars = 7, .get = display_get_speed_target, .arg = MOTOR_ID_RIGHT},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_4, .font = &fonts_7x10, .text = "R.C: ",
+        .suffix = " mA.", .chars = DISPLAY_LINE_CHARS, .get = display_get_motor_current, .arg = MOTOR_ID_RIGHT},
+};
 
-static void display_meniu_cb_welcome(display_menu_id_t id);
-static void display_meniu_cb_clock(display_menu_id_t id);
+static widget_t display_widgets_info[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_1, .font = &fonts_7x10, .text = "Ver: 1.1-a1"},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_2, .font = &fonts_7x10,
+        .text = "Clk: ", .suffix = " MHz.", .chars = DISPLAY_LINE_CHARS, .get = display_get_core_clock},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_3, .font = &fonts_7x10,
+        .format = display_format_temperature, .chars = DISPLAY_LINE_CHARS, .get = display_get_temperature},
+    {.type = WIDGET_TYPE_NUMBER, .x = DISPLAY_LINE_X, .y = DISPLAY_LINE_Y_4, .font = &fonts_7x10,
+        .text = "Fls: ", .suffix = " us.", .chars = DISPLAY_LINE_CHARS, .get = display_get_flush_time},
+};
+
+volatile display_menu_id_t display_menu_id = DISPLAY_MENU_ID_WELCOME;
+volatile display_menu_t display_menus[DISPLAY_MENU_ID_LAST] =
+{
+    [DISPLAY_MENU_ID_WELCOME] = {.period = 0, WIDGET_LIST(display_widgets_welcome)},
+    [DISPLAY_MENU_ID_CLOCK] = {.title = "Clock", .period = 1000, WIDGET_LIST(display_widgets_clock)},
 #if DISPLAY_EXTRA
-static void display_meniu_cb_light(display_menu_id_t id);
-static void display_meniu_cb_temperature(display_menu_id_t id);
-static void display_meniu_cb_humidity(display_menu_id_t id);
+    [DISPLAY_MENU_ID_LIGHT] = {.frame = true, .period = 100, WIDGET_LIST(display_widgets_light)},
+    [DISPLAY_MENU_ID_TEMPERATURE] = {.frame = true, .period = 100, WIDGET_LIST(display_widgets_temperature)},
+    [DISPLAY_MENU_ID_HUMIDITY] = {.frame = true, .period = 100, WIDGET_LIST(display_widgets_humidity)},
 #endif // DISPLAY_EXTRA
-static void display_meniu_cb_joystick(display_menu_id_t id);
-static void display_meniu_cb_motor(display_menu_id_t id);
-static void display_meniu_cb_info(display_menu_id_t id);
+    [DISPLAY_MENU_ID_JOYSTICK] = {.title = "Joystick", .period = 50, WIDGET_LIST(display_widgets_joystick)},
+    [DISPLAY_MENU_ID_MOTOR] = {.title = "Motor", .period = 50, WIDGET_LIST(display_widgets_motor)},
+    [DISPLAY_MENU_ID_INFO] = {.title = "Info", .period = 1000, WIDGET_LIST(display_widgets_info)},
+};
 
-static void display_delay(display_menu_id_t id);
-static void display_contrast_control(void);
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
 
 /**********************************************************************************************************************
  * Exported functions
@@ -112,19 +229,14 @@ bool display_init(void)
     {
         return false;
     }
-    
-    display_menu_init(DISPLAY_MENU_ID_WELCOME, 0, display_meniu_cb_welcome);
-    display_menu_init(DISPLAY_MENU_ID_CLOCK, 1000, display_meniu_cb_clock);
-#if DISPLAY_EXTRA
-    display_menu_init(DISPLAY_MENU_ID_LIGHT, 100, display_meniu_cb_light);
-    display_menu_init(DISPLAY_MENU_ID_TEMPERATURE, 100, display_meniu_cb_temperature);
-    display_menu_init(DISPLAY_MENU_ID_HUMIDITY, 100, display_meniu_cb_humidity);
-#endif // DISPLAY_EXTRA
-    display_menu_init(DISPLAY_MENU_ID_JOYSTICK, 50, display_meniu_cb_joystick);
-    display_menu_init(DISPLAY_MENU_ID_MOTOR, 50, display_meniu_cb_motor);
-    display_menu_init(DISPLAY_MENU_ID_INFO, 1000, display_meniu_cb_info);
 
     display_menu_set(DISPLAY_MENU_ID_WELCOME);
+    joystick_set_cb(JOYSTICK_ID_1, display_joystick_cb);
+
+    if((display_timer_id = osTimerNew(&display_timer_cb, osTimerPeriodic, NULL, &display_timer_attr)) == NULL)
+    {
+        return false;
+    }
 
     // Create display thread.
     if((display_thread_id = osThreadNew(&display_thread, NULL, &display_thread_attr)) == NULL)
@@ -139,6 +251,8 @@ bool display_init(void)
 void display_thread(void *arguments)
 {
     display_menu_id_t id = DISPLAY_MENU_ID_WELCOME;
+    uint32_t flags = DISPLAY_FLAG_MENU | DISPLAY_FLAG_DATA;
+    bool update = false;
 
     osDelay(500);
     ssd1306_update_screen();
@@ -147,29 +261,58 @@ void display_thread(void *arguments)
     while(1)
     {
         id = display_menu_id;
+        if(flags & DISPLAY_FLAG_MENU)
+        {
+            /* Refresh timer follows period of shown menu */
+            osTimerStop(display_timer_id);
+            if(display_menus[id].period)
+            {
+                osTimerStart(display_timer_id, display_menus[id].period);
+            }
+        }
+        if(flags & DISPLAY_FLAG_DATA)
+        {
+            display_contrast_control();
+        }
+
         if(display_menus[id].enable == true)
         {
+            update = false;
             if(display_menus[id].init == false)
             {
                 ssd1306_fill(SSD1306_COLOR_BLACK);
+                if(display_menus[id].frame == true)
+                {
+                    ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
+                }
+                if(display_menus[id].title != NULL)
+                {
+                    display_menu_header(display_menus[id].title);
+                }
+                widget_reset(display_menus[id].widgets, display_menus[id].count);
+                update = true;
             }
-            if(display_menus[id].cb != NULL)
+            /* Only widgets with changed values are redrawn and sent */
+            if(widget_update(display_menus[id].widgets, display_menus[id].count) == true)
             {
-                display_menus[id].cb(id);
+                update = true;
             }
-            if(display_menus[id].period)
+            if(update == true)
             {
-                display_delay(id);
+                ssd1306_update_screen();
             }
-            else
+            if(display_menus[id].period == 0)
             {
                 display_menus[id].enable = false;
             }
             display_menus[id].init = true;
         }
-        else
+
+        /* Sleep until menu change, refresh period or data change */
+        flags = osThreadFlagsWait(DISPLAY_FLAG_ALL, osFlagsWaitAny, osWaitForever);
+        if(flags & osFlagsError)
         {
-            display_delay(id);
+            flags = 0;
         }
     }
 }
@@ -182,266 +325,170 @@ void display_menu_set(display_menu_id_t id)
     display_menus[id].init = false;
     __enable_irq();
 
+    if(display_thread_id != NULL)
+    {
+        osThreadFlagsSet(display_thread_id, DISPLAY_FLAG_MENU);
+    }
+
     return;
 }
 
-/**********************************************************************************************************************
- * Private functions
- *********************************************************************************************************************/
-static void display_menu_init(display_menu_id_t id, uint32_t period, display_cb_t cb)
+void display_notify(void)
 {
-    display_menus[id].period = period;
-    display_menus[id].cb = cb;
-    display_menus[id].enable = false;
-    display_menus[id].init = false;
+    if(display_thread_id != NULL)
+    {
+        osThreadFlagsSet(display_thread_id, DISPLAY_FLAG_DATA);
+    }
 
     return;
 }
 
-static void display_menu_header(display_menu_id_t id, uint8_t *str)
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void display_menu_header(const char *str)
 {
     uint8_t tmp[24] = {0};
 
-    if(display_menus[id].init == false)
-    {
-        //ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
-        //ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH, 13, SSD1306_COLOR_WHITE);
-        //ssd1306_draw_filled_rectangle(0, 0, SSD1306_WIDTH, 13, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(0, 13, SSD1306_WIDTH, 13, SSD1306_COLOR_WHITE);
 
-        ssd1306_draw_line(0, 13, SSD1306_WIDTH, 13, SSD1306_COLOR_WHITE);
-
-        snprintf((char *)tmp, 24, "< %-13.13s >", str);
-        ssd1306_goto_xy(4, 1);
-        ssd1306_puts((uint8_t *)tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-        ssd1306_update_screen();
-    }
+    fmt_snprintf((char *)tmp, 24, "< %-13.13s >", str);
+    ssd1306_goto_xy(4, 1);
+    ssd1306_puts((uint8_t *)tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
 
     return;
 }
 
-static void display_meniu_cb_welcome(display_menu_id_t id)
+static int32_t display_get_clock(uint32_t arg)
 {
-    //ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
-
-    ssd1306_goto_xy(40, 20);
-    ssd1306_puts((uint8_t *)"DS-2", &fonts_11x18, SSD1306_COLOR_WHITE);
-    ssd1306_goto_xy(25, 40);
-    ssd1306_puts((uint8_t *)"Controller", &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    ssd1306_update_screen();
+    /* Argument is resolution in seconds, so widget changes only when shown part changes */
+    return rtc_get() / arg;
+}
 
-    return;
+static int32_t display_get_joystick(uint32_t arg)
+{
+    switch(arg)
+    {
+        case 0:
+            return joystick_get_x(JOYSTICK_ID_1);
+        case 1:
+            return joystick_get_y(JOYSTICK_ID_1);
+        default:
+            return joystick_get_sw(JOYSTICK_ID_1);
+    }
 }
 
-static void display_meniu_cb_clock(display_menu_id_t id)
+static int32_t display_get_joystick_vector(uint32_t arg)
 {
-    uint8_t tmp[16] = {0};
-    uint32_t timestamp = rtc_get();
-    struct tm clock = {0};
+    int32_t magn = 0;
+    int32_t dir = 0;
 
-    ConvertRtcTime(timestamp, &clock);
+    joystick_get_vector(JOYSTICK_ID_1, &magn, &dir);
 
-    display_menu_header(id, "Clock");
+    return arg == 0 ? magn : dir;
+}
 
-    ssd1306_goto_xy(20, 23);
-    snprintf((char *)tmp, sizeof(tmp), "%02d:%02d:%02d", clock.tm_hour, clock.tm_min, clock.tm_sec);
-    ssd1306_puts((uint8_t *)tmp, &fonts_11x18, SSD1306_COLOR_WHITE);
-    ssd1306_goto_xy(29, 44);
-    snprintf((char *)tmp, sizeof(tmp), "%04d-%02d-%02d", clock.tm_year + TM_YEAR_BASE, clock.tm_mon + 1, clock.tm_mday);
-    ssd1306_puts((uint8_t *)tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
+/**
+ * @brief   Redraw right away when stick leaves or returns to dead zone instead of waiting for refresh period.
+ */
+static void display_joystick_cb(joystick_id_t id, bool active)
+{
+    UNUSED_PARAMETER(id);
+    UNUSED_PARAMETER(active);
 
-    ssd1306_update_screen();
+    display_notify();
 
     return;
 }
 
-#if DISPLAY_EXTRA
-static void display_meniu_cb_light(display_menu_id_t id)
+static int32_t display_get_speed_current(uint32_t arg)
 {
-    uint8_t tmp[16] = {0};
-    uint8_t offset_x = 0;
-    uint16_t value = sensors_data.light.value_lp;
+    return motor_get_speed_current((motor_id_t)arg);
+}
 
-    if(display_menus[id].init == false)
-    {
-        ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(46, 10);
-        ssd1306_puts((uint8_t *)"Light", &fonts_7x10, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(56, 44);
-        ssd1306_puts((uint8_t *)"lx.", &fonts_7x10, SSD1306_COLOR_WHITE);
-    }
+static int32_t display_get_speed_target(uint32_t arg)
+{
+    return motor_get_speed_target((motor_id_t)arg);
+}
 
-    snprintf((char *)tmp, 18, "%d", value);
-    offset_x = (128 - (strlen((char *)tmp)  * 11)) / 2;
-    ssd1306_goto_xy(3, 23);
-    ssd1306_puts((uint8_t *)"            ", &fonts_11x18, SSD1306_COLOR_WHITE);
-    snprintf((char *)tmp, sizeof(tmp), "%d", value);
-    ssd1306_goto_xy(offset_x, 23);
-    ssd1306_puts((uint8_t *)tmp, &fonts_11x18, SSD1306_COLOR_WHITE);
+static int32_t display_get_motor_current(uint32_t arg)
+{
+    return motor_get_current((motor_id_t)arg);
+}
 
-    ssd1306_update_screen();
+static int32_t display_get_core_clock(uint32_t arg)
+{
+    UNUSED_PARAMETER(arg);
 
-    return;
+    return SystemCoreClock / 1000000;
 }
 
-static void display_meniu_cb_temperature(display_menu_id_t id)
+static int32_t display_get_temperature(uint32_t arg)
 {
-    uint8_t tmp[16] = {0};
-    uint8_t offset_x = 0;
-    uint16_t value = sensors_data.temperature.value;
+    UNUSED_PARAMETER(arg);
 
-    if(display_menus[id].init == false)
-    {
-        ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(25, 10);
-        ssd1306_puts((uint8_t *)"Temperature", &fonts_7x10, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(48, 44);
-        ssd1306_puts((uint8_t *)"degC.", &fonts_7x10, SSD1306_COLOR_WHITE);
-    }
+    /* Hundredths of degree */
+    return adc_get_temperature();
+}
 
-    snprintf((char *)tmp, 18, "%d", value);
-    offset_x = (128 - (strlen((char *)tmp)  * 11)) / 2;
-    ssd1306_goto_xy(3, 23);
-    ssd1306_puts((uint8_t *)"            ", &fonts_11x18, SSD1306_COLOR_WHITE);
-    snprintf((char *)tmp, sizeof(tmp), "%d", value);
-    ssd1306_goto_xy(offset_x, 23);
-    ssd1306_puts((uint8_t *)tmp, &fonts_11x18, SSD1306_COLOR_WHITE);
+static int32_t display_get_flush_time(uint32_t arg)
+{
+    ssd1306_stats_t stats = {0};
 
-    ssd1306_update_screen();
+    UNUSED_PARAMETER(arg);
 
-    return;
+    ssd1306_get_stats(&stats);
+
+    return stats.time_max_us;
 }
 
-static void display_meniu_cb_humidity(display_menu_id_t id)
+#if DISPLAY_EXTRA
+static int32_t display_get_sensor(uint32_t arg)
 {
-    uint8_t tmp[16] = {0};
-    uint8_t offset_x = 0;
-    uint16_t value = sensors_data.humidity.value;
-
-    if(display_menus[id].init == false)
+    switch(arg)
     {
-        ssd1306_draw_rectangle(0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(36, 10);
-        ssd1306_puts((uint8_t *)"Humidity", &fonts_7x10, SSD1306_COLOR_WHITE);
-        ssd1306_goto_xy(60, 44);
-        ssd1306_puts((uint8_t *)"%", &fonts_7x10, SSD1306_COLOR_WHITE);
+        case DISPLAY_MENU_ID_LIGHT:
+            return sensors_data.light.value_lp;
+        case DISPLAY_MENU_ID_TEMPERATURE:
+            return (uint16_t)sensors_data.temperature.value;
+        default:
+            return sensors_data.humidity.value;
     }
-
-
-    snprintf((char *)tmp, 18, "%d", value);
-    offset_x = (128 - (strlen((char *)tmp)  * 11)) / 2;
-    ssd1306_goto_xy(3, 23);
-    ssd1306_puts((uint8_t *)"            ", &fonts_11x18, SSD1306_COLOR_WHITE);
-    snprintf((char *)tmp, sizeof(tmp), "%d", value);
-    ssd1306_goto_xy(offset_x, 23);
-    ssd1306_puts((uint8_t *)tmp, &fonts_11x18, SSD1306_COLOR_WHITE);
-
-    ssd1306_update_screen();
-
-    return;
 }
 #endif // DISPLAY_EXTRA
 
-static void display_meniu_cb_joystick(display_menu_id_t id)
+static void display_format_time(char *buffer, uint32_t size, int32_t value)
 {
-    uint8_t tmp[18] = {0};
-    int32_t magn = 0;
-    int32_t dir = 0;
-
-    display_menu_header(id, "Joystick");
-
-    snprintf((char *)tmp, 18, "X:  %d       ", joystick_get_x(JOYSTICK_ID_1));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_1);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "Y:  %d       ", joystick_get_y(JOYSTICK_ID_1));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_2);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    joystick_get_vector(JOYSTICK_ID_1, &magn, &dir);
-    snprintf((char *)tmp, 18, "V:  %d %d      ", magn, dir);
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_3);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "SW: %01d   ", joystick_get_sw(JOYSTICK_ID_1));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_4);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
+    struct tm clock = {0};
 
-    ssd1306_update_screen();
+    ConvertRtcTime(value, &clock);
+    fmt_snprintf(buffer, size, "%02d:%02d:%02d", clock.tm_hour, clock.tm_min, clock.tm_sec);
 
     return;
 }
 
-static void display_meniu_cb_motor(display_menu_id_t id)
+static void display_format_date(char *buffer, uint32_t size, int32_t value)
 {
-    uint8_t tmp[18] = {0};
-
-    display_menu_header(id, "Motor");
-
-    snprintf((char *)tmp, 18, "L.S: %d / %d   ", motor_get_speed_current(MOTOR_ID_LEFT), motor_get_speed_target(MOTOR_ID_LEFT));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_1);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "L.C: %d mA.    ", motor_get_current(MOTOR_ID_LEFT));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_2);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "R.S: %d / %d   ", motor_get_speed_current(MOTOR_ID_RIGHT), motor_get_speed_target(MOTOR_ID_RIGHT));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_3);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "R.C: %d mA.    ", motor_get_current(MOTOR_ID_RIGHT));
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_4);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
+    struct tm clock = {0};
 
-    ssd1306_update_screen();
+    ConvertRtcTime(value * 86400, &clock);
+    fmt_snprintf(buffer, size, "%04d-%02d-%02d", clock.tm_year + TM_YEAR_BASE, clock.tm_mon + 1, clock.tm_mday);
 
     return;
 }
 
-static void display_meniu_cb_info(display_menu_id_t id)
+static void display_format_temperature(char *buffer, uint32_t size, int32_t value)
 {
-    uint8_t tmp[18] = {0};
+    char tmp[FMT_FIXED_SIZE];
 
-    display_menu_header(id, "Info");
-
-    snprintf((char *)tmp, 18, "Ver: 1.1-a1");
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_1);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "Clk: %ld MHz.", SystemCoreClock / 1000000);
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_2);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    snprintf((char *)tmp, 18, "Tmp: %.02f degC.", adc_get_temperature());
-    ssd1306_goto_xy(DISPLAY_LINE_X, DISPLAY_LINE_Y_3);
-    ssd1306_puts(tmp, &fonts_7x10, SSD1306_COLOR_WHITE);
-
-    ssd1306_update_screen();
+    fmt_snprintf(buffer, size, "Tmp: %s degC.", fmt_fixed(tmp, value, 2));
 
     return;
 }
 
-static void display_delay(display_menu_id_t id)
+static void display_timer_cb(void *arguments)
 {
-    static uint32_t c = 0;
-    uint32_t delay = display_menus[id].period;
-
-    while(delay--)
-    {
-        osDelay(1);
-        c++;
-        if(c > 100)
-        {
-            c = 0;
-            display_contrast_control();
-        }
-        if(id != display_menu_id)
-        {
-            break;
-        }
-    }
+    osThreadFlagsSet(display_thread_id, DISPLAY_FLAG_TIMER);
 
     return;
 }
@@ -455,7 +502,11 @@ static void display_contrast_control(void)
         ligh_level = (sensors_data.light.value_lp * 256 / 512);
         ligh_level = ligh_level > 255 ? 255 : ligh_level;
         //ligh_level = sensors_data.light.value_lp > 255 ? 255 : sensors_data.light.value_lp;
-        ssd1306_set_contrast(ligh_level);
+        if(ligh_level != display_contrast)
+        {
+            display_contrast = ligh_level;
+            ssd1306_set_contrast(ligh_level);
+        }
     }
 
     return;
@@ -66,6 +66,11 @@ bool display_init(void);
 void display_thread(void *arguments);
 void display_menu_set(display_menu_id_t id);
 
+/**
+ * @brief   Notify display that shown data changed. Wakes display thread to redraw changed widgets and adjust contrast.
+ */
+void display_notify(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,8 @@
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
+#if FONTS_ROW_FONTS
+/* Row fonts are source for Tools/fontc.py, page packed versions are in fonts_packed.c */
 const uint16_t fonts_7x10_data[] =
 {
     0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // sp
@@ -357,6 +359,7 @@ fonts_t fonts_16x26 =
     26,
     fonts_16x26_data
 };
+#endif // FONTS_ROW_FONTS
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -364,6 +367,8 @@ fonts_t fonts_16x26 =
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static uint32_t fonts_get_glyph_index(fonts_t *font, uint8_t ch);
+static void fonts_rle_decode(const uint8_t *src, uint8_t *dst, uint32_t size);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -378,6 +383,128 @@ uint8_t *fonts_get_string_size(uint8_t *str, fonts_size_t *font_size, fonts_t *f
     return str;
 }
 
+void fonts_get_glyph_columns(fonts_t *font, uint8_t ch, uint32_t *columns)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t row = 0;
+    uint32_t index = fonts_get_glyph_index(font, ch);
+    uint32_t pages = (font->font_height + 7) / 8;
+    uint32_t size = pages * font->font_width;
+    const uint16_t *data = NULL;
+    const uint8_t *bytes = NULL;
+    uint8_t buffer[FONTS_MAX_WIDTH * FONTS_MAX_PAGES];
+
+    memset(columns, 0, font->font_width * sizeof(uint32_t));
+
+    if(index == UINT32_MAX)
+    {
+        return;
+    }
+
+    switch(font->format)
+    {
+        case FONTS_FORMAT_ROWS:
+            /* Rows are stored MSB first, transpose them to columns */
+            data = &font->data[index * font->font_height];
+            for(i = 0; i < font->font_height; i++)
+            {
+                row = data[i];
+                for(j = 0; row != 0; j++, row = (row << 1) & 0xFFFF)
+                {
+                    if(row & 0x8000)
+                    {
+                        columns[j] |= 1UL << i;
+                    }
+                }
+            }
+            return;
+        case FONTS_FORMAT_PAGES:
+            bytes = &font->pages[index * size];
+            break;
+        case FONTS_FORMAT_PAGES_RLE:
+            fonts_rle_decode(&font->pages[font->offsets[index]], buffer, size);
+            bytes = buffer;
+            break;
+        default:
+            return;
+    }
+
+    /* Page bytes are already in column order, just stack them */
+    for(i = 0; i < pages; i++)
+    {
+        for(j = 0; j < font->font_width; j++)
+        {
+            columns[j] |= (uint32_t)bytes[i * font->font_width + j] << (i * 8);
+        }
+    }
+
+    return;
+}
+
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+/**
+ * @brief   Get index of glyph in font data.
+ *
+ * @param   font    Pointer to @ref fonts_t font.
+ * @param   ch      Character to find.
+ *
+ * @return  Index of glyph, UINT32_MAX if font has no such character.
+ */
+static uint32_t fonts_get_glyph_index(fonts_t *font, uint8_t ch)
+{
+    const char *p = NULL;
+
+    if(ch < 32 || ch > 126)
+    {
+        return UINT32_MAX;
+    }
+    if(font->charset == NULL)
+    {
+        return ch - 32;
+    }
+
+    p = strchr(font->charset, ch);
+    if(p == NULL)
+    {
+        return UINT32_MAX;
+    }
+
+    return p - font->charset;
+}
+
+/**
+ * @brief   Decode run length encoded glyph written by Tools/fontc.py.
+ *
+ * @param   src     Encoded data.
+ * @param   dst     Buffer for decoded data.
+ * @param   size    Size of decoded glyph in bytes.
+ */
+static void fonts_rle_decode(const uint8_t *src, uint8_t *dst, uint32_t size)
+{
+    uint32_t n = 0;
+    uint32_t i = 0;
+
+    while(i < size)
+    {
+        n = (*src & 0x7F) + 1;
+        if(n > size - i)
+        {
+            n = size - i;
+        }
+        if(*src++ & 0x80)
+        {
+            memset(&dst[i], *src++, n);
+        }
+        else
+        {
+            memcpy(&dst[i], src, n);
+            src += n;
+        }
+        i += n;
+    }
+
+    return;
+}
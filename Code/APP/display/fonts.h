@@ -31,6 +31,13 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
+#define FONTS_MAX_WIDTH     16  //!< Widest glyph of all fonts in pixels.
+#define FONTS_MAX_HEIGHT    32  //!< Tallest possible glyph, one column must fit 32 bits.
+#define FONTS_MAX_PAGES     (FONTS_MAX_HEIGHT / 8)  //!< Pages of tallest glyph.
+
+#ifndef FONTS_ROW_FONTS
+#define FONTS_ROW_FONTS     0   //!< Build row fonts from fonts.c instead of page packed fonts from fonts_packed.c.
+#endif
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -40,14 +47,28 @@ extern "C" {
  * Exported types
  *********************************************************************************************************************/
 
+/**
+ * @brief   Font data formats.
+ */
+typedef enum
+{
+    FONTS_FORMAT_ROWS = 0,      /*!< One uint16_t per row, MSB is left pixel */
+    FONTS_FORMAT_PAGES,         /*!< Page bytes, all columns of page 0 first, bit 0 is top row of page */
+    FONTS_FORMAT_PAGES_RLE,     /*!< Page bytes compressed with run length encoding, see Tools/fontc.py */
+} fonts_format_t;
+
 /**
  * @brief   Font structure used on my LCD libraries
  */
 typedef struct
 {
-    uint8_t font_width;     /*!< Font width in pixels */
-    uint8_t font_height;    /*!< Font height in pixels */
-    const uint16_t *data;   /*!< Pointer to data font data array */
+    uint8_t font_width;         /*!< Font width in pixels */
+    uint8_t font_height;        /*!< Font height in pixels */
+    const uint16_t *data;       /*!< Pointer to data font data array, @ref FONTS_FORMAT_ROWS only */
+    fonts_format_t format;      /*!< Format of font data */
+    const uint8_t *pages;       /*!< Pointer to page packed glyphs */
+    const uint16_t *offsets;    /*!< Offset of each glyph in pages, @ref FONTS_FORMAT_PAGES_RLE only */
+    const char *charset;        /*!< Characters present in font, NULL when font has all of ASCII 32-126 */
 } fonts_t;
 
 /**
@@ -64,7 +85,9 @@ typedef struct
  *********************************************************************************************************************/
 extern fonts_t fonts_7x10;
 extern fonts_t fonts_11x18;
+#if FONTS_ROW_FONTS
 extern fonts_t fonts_16x26;
+#endif
 
 /**********************************************************************************************************************
  * Prototypes of exported functions
@@ -80,6 +103,16 @@ extern fonts_t fonts_16x26;
  */
 uint8_t *fonts_get_string_size(uint8_t *str, fonts_size_t *font_size, fonts_t *font);
 
+/**
+ * @brief   Get glyph of character as columns. Bit 0 of column is top row of glyph, same as in SSD1306 page byte.
+ *          Characters missing in font give empty columns.
+ *
+ * @param   font    Pointer to @ref fonts_t font to use.
+ * @param   ch      Character to get.
+ * @param   columns Array of at least @ref FONTS_MAX_WIDTH columns to fill, font_width of them are written.
+ */
+void fonts_get_glyph_columns(fonts_t *font, uint8_t ch, uint32_t *columns);
+
 #ifdef __cplusplus
 }
 #endif
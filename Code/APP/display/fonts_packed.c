@@ -0,0 +1,155 @@
+/**
+ **********************************************************************************************************************
+ * @file        fonts_packed.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Page packed fonts. Generated by Tools/fontc.py, do not edit.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+#include "fonts.h"
+
+#if !FONTS_ROW_FONTS
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+/* fontc.py --rle --font "fonts_7x10:7x10" --font "fonts_11x18:11x18: -.0123456789:DS" */
+
+/* 7x10, 95 glyphs, 1075 bytes, RLE */
+static const uint8_t fonts_7x10_pages[] =
+{
+    0x8D, 0x00, 0x82, 0x00, 0x00, 0xBF, 0x89, 0x00, 0x81, 0x00, 0x02, 0x07, 0x00, 0x07, 0x88, 0x00,
+    0x05, 0x00, 0xF4, 0x2F, 0x24, 0xF4, 0x2F, 0x87, 0x00, 0x05, 0x00, 0x66, 0x89, 0xFF, 0x89, 0x72,
+    0x83, 0x00, 0x00, 0x01, 0x82, 0x00, 0x05, 0x00, 0x26, 0x19, 0x6E, 0x94, 0x62, 0x87, 0x00, 0x05,
+    0x00, 0x60, 0x96, 0x99, 0x66, 0x90, 0x87, 0x00, 0x82, 0x00, 0x00, 0x07, 0x89, 0x00, 0x81, 0x00,
+    0x02, 0xFC, 0x02, 0x01, 0x84, 0x00, 0x01, 0x01, 0x02, 0x81, 0x00, 0x81, 0x00, 0x02, 0x01, 0x02,
+    0xFC, 0x83, 0x00, 0x01, 0x02, 0x01, 0x82, 0x00, 0x81, 0x00, 0x02, 0x0A, 0x07, 0x0A, 0x88, 0x00,
+    0x00, 0x00, 0x81, 0x10, 0x00, 0x7C, 0x81, 0x10, 0x87, 0x00, 0x82, 0x00, 0x00, 0x80, 0x85, 0x00,
+    0x00, 0x03, 0x82, 0x00, 0x81, 0x00, 0x82, 0x20, 0x88, 0x00, 0x82, 0x00, 0x00, 0x80, 0x89, 0x00,
+    0x81, 0x00, 0x02, 0xC0, 0x3C, 0x03, 0x88, 0x00, 0x05, 0x00, 0x7E, 0x81, 0x89, 0x81, 0x7E, 0x87,
+    0x00, 0x03, 0x00, 0x04, 0x02, 0xFF, 0x89, 0x00, 0x05, 0x00, 0x86, 0xC1, 0xA1, 0x91, 0x8E, 0x87,
+    0x00, 0x02, 0x00, 0x42, 0x81, 0x81, 0x89, 0x00, 0x76, 0x87, 0x00, 0x05, 0x00, 0x30, 0x2C, 0x22,
+    0xFF, 0x20, 0x87, 0x00, 0x01, 0x00, 0x4F, 0x82, 0x89, 0x00, 0x71, 0x87, 0x00, 0x01, 0x00, 0x7E,
+    0x82, 0x89, 0x00, 0x72, 0x87, 0x00, 0x05, 0x00, 0x01, 0xE1, 0x19, 0x05, 0x03, 0x87, 0x00, 0x01,
+    0x00, 0x76, 0x82, 0x89, 0x00, 0x76, 0x87, 0x00, 0x01, 0x00, 0x4E, 0x82, 0x91, 0x00, 0x7E, 0x87,
+    0x00, 0x82, 0x00, 0x00, 0x84, 0x89, 0x00, 0x82, 0x00, 0x00, 0x88, 0x85, 0x00, 0x00, 0x03, 0x82,
+    0x00, 0x01, 0x00, 0x10, 0x81, 0x28, 0x81, 0x44, 0x87, 0x00, 0x00, 0x00, 0x84, 0x28, 0x87, 0x00,
+    0x00, 0x00, 0x81, 0x44, 0x81, 0x28, 0x00, 0x10, 0x87, 0x00, 0x05, 0x00, 0x02, 0x01, 0xB1, 0x09,
+    0x06, 0x87, 0x00, 0x05, 0x00, 0x7E, 0x81, 0x99, 0x95, 0x1E, 0x87, 0x00, 0x05, 0x00, 0xE0, 0x3E,
+    0x21, 0x3E, 0xE0, 0x87, 0x00, 0x01, 0x00, 0xFF, 0x82, 0x89, 0x00, 0x76, 0x87, 0x00, 0x01, 0x00,
+    0x7E, 0x82, 0x81, 0x00, 0x42, 0x87, 0x00, 0x01, 0x00, 0xFF, 0x81, 0x81, 0x01, 0x42, 0x3C, 0x87,
+    0x00, 0x01, 0x00, 0xFF, 0x83, 0x89, 0x87, 0x00, 0x01, 0x00, 0xFF, 0x82, 0x09, 0x00, 0x01, 0x87,
+    0x00, 0x02, 0x00, 0x7E, 0x81, 0x81, 0x91, 0x00, 0x72, 0x87, 0x00, 0x01, 0x00, 0xFF, 0x82, 0x08,
+    0x00, 0xFF, 0x87, 0x00, 0x81, 0x00, 0x02, 0x81, 0xFF, 0x81, 0x88, 0x00, 0x01, 0x00, 0x40, 0x82,
+    0x80, 0x00, 0x7F, 0x87, 0x00, 0x05, 0x00, 0xFF, 0x08, 0x14, 0x62, 0x81, 0x87, 0x00, 0x01, 0x00,
+    0xFF, 0x83, 0x80, 0x87, 0x00, 0x05, 0x00, 0xFF, 0x06, 0x08, 0x06, 0xFF, 0x87, 0x00, 0x05, 0x00,
+    0xFF, 0x06, 0x18, 0x60, 0xFF, 0x87, 0x00, 0x01, 0x00, 0x7E, 0x82, 0x81, 0x00, 0x7E, 0x87, 0x00,
+    0x01, 0x00, 0xFF, 0x82, 0x11, 0x00, 0x0E, 0x87, 0x00, 0x05, 0x00, 0x7E, 0x81, 0xC1, 0x81, 0x7E,
+    0x85, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00, 0xFF, 0x81, 0x11, 0x01, 0x71, 0x8E, 0x87, 0x00, 0x01,
+    0x00, 0x46, 0x81, 0x89, 0x01, 0x91, 0x62, 0x87, 0x00, 0x00, 0x00, 0x81, 0x01, 0x00, 0xFF, 0x81,
+    0x01, 0x87, 0x00, 0x01, 0x00, 0x7F, 0x82, 0x80, 0x00, 0x7F, 0x87, 0x00, 0x05, 0x00, 0x07, 0x38,
+    0xC0, 0x38, 0x07, 0x87, 0x00, 0x05, 0x00, 0x3F, 0xE0, 0x1C, 0xE0, 0x3F, 0x87, 0x00, 0x05, 0x00,
+    0x81, 0x66, 0x18, 0x66, 0x81, 0x87, 0x00, 0x05, 0x00, 0x03, 0x0C, 0xF0, 0x0C, 0x03, 0x87, 0x00,
+    0x05, 0x00, 0xC1, 0xA1, 0x99, 0x85, 0x83, 0x87, 0x00, 0x82, 0x00, 0x01, 0xFF, 0x01, 0x84, 0x00,
+    0x01, 0x03, 0x02, 0x81, 0x00, 0x81, 0x00, 0x02, 0x03, 0x3C, 0xC0, 0x88, 0x00, 0x81, 0x00, 0x01,
+    0x01, 0xFF, 0x84, 0x00, 0x01, 0x02, 0x03, 0x82, 0x00, 0x05, 0x00, 0x08, 0x06, 0x01, 0x06, 0x08,
+    0x87, 0x00, 0x86, 0x00, 0x86, 0x02, 0x81, 0x00, 0x01, 0x01, 0x02, 0x89, 0x00, 0x01, 0x00, 0x68,
+    0x81, 0x94, 0x01, 0x54, 0xF8, 0x87, 0x00, 0x02, 0x00, 0xFF, 0x48, 0x81, 0x84, 0x00, 0x78, 0x87,
+    0x00, 0x01, 0x00, 0x78, 0x82, 0x84, 0x00, 0x48, 0x87, 0x00, 0x01, 0x00, 0x78, 0x81, 0x84, 0x01,
+    0x48, 0xFF, 0x87, 0x00, 0x01, 0x00, 0x78, 0x82, 0x94, 0x00, 0x58, 0x87, 0x00, 0x00, 0x00, 0x81,
+    0x04, 0x00, 0xFE, 0x81, 0x05, 0x87, 0x00, 0x01, 0x00, 0x78, 0x81, 0x84, 0x01, 0x48, 0xFC, 0x81,
+    0x00, 0x83, 0x02, 0x01, 0x01, 0x00, 0x02, 0x00, 0xFF, 0x08, 0x81, 0x04, 0x00, 0xF8, 0x87, 0x00,
+    0x00, 0x00, 0x81, 0x04, 0x00, 0xFD, 0x89, 0x00, 0x00, 0x00, 0x81, 0x04, 0x00, 0xFD, 0x82, 0x00,
+    0x82, 0x02, 0x00, 0x01, 0x82, 0x00, 0x05, 0x00, 0xFF, 0x10, 0x28, 0x44, 0x80, 0x87, 0x00, 0x00,
+    0x00, 0x81, 0x01, 0x00, 0xFF, 0x89, 0x00, 0x05, 0x00, 0xFC, 0x04, 0xFC, 0x04, 0xF8, 0x87, 0x00,
+    0x02, 0x00, 0xFC, 0x08, 0x81, 0x04, 0x00, 0xF8, 0x87, 0x00, 0x01, 0x00, 0x78, 0x82, 0x84, 0x00,
+    0x78, 0x87, 0x00, 0x02, 0x00, 0xFC, 0x48, 0x81, 0x84, 0x00, 0x78, 0x81, 0x00, 0x00, 0x03, 0x84,
+    0x00, 0x01, 0x00, 0x78, 0x81, 0x84, 0x01, 0x48, 0xFC, 0x85, 0x00, 0x01, 0x03, 0x00, 0x02, 0x00,
+    0xFC, 0x08, 0x81, 0x04, 0x00, 0x08, 0x87, 0x00, 0x01, 0x00, 0x48, 0x81, 0x94, 0x01, 0xA4, 0x48,
+    0x87, 0x00, 0x02, 0x00, 0x04, 0x7F, 0x81, 0x84, 0x88, 0x00, 0x01, 0x00, 0x7C, 0x81, 0x80, 0x01,
+    0x40, 0xFC, 0x87, 0x00, 0x05, 0x00, 0x0C, 0x70, 0x80, 0x70, 0x0C, 0x87, 0x00, 0x05, 0x00, 0x3C,
+    0xE0, 0x1C, 0xE0, 0x3C, 0x87, 0x00, 0x05, 0x00, 0x84, 0x48, 0x30, 0x48, 0x84, 0x87, 0x00, 0x05,
+    0x00, 0x0C, 0x30, 0xC0, 0x30, 0x0C, 0x81, 0x00, 0x81, 0x02, 0x00, 0x01, 0x82, 0x00, 0x05, 0x00,
+    0xC4, 0xA4, 0x94, 0x8C, 0x84, 0x87, 0x00, 0x81, 0x00, 0x02, 0x30, 0xCF, 0x01, 0x84, 0x00, 0x01,
+    0x03, 0x02, 0x81, 0x00, 0x82, 0x00, 0x00, 0xFF, 0x85, 0x00, 0x00, 0x03, 0x82, 0x00, 0x81, 0x00,
+    0x02, 0x01, 0xCF, 0x30, 0x83, 0x00, 0x01, 0x02, 0x03, 0x82, 0x00, 0x01, 0x00, 0x18, 0x81, 0x08,
+    0x01, 0x10, 0x18, 0x87, 0x00,
+};
+
+static const uint16_t fonts_7x10_offsets[] =
+{
+    0, 2, 8, 16, 25, 38, 47, 56, 62, 75, 88, 96,
+    106, 116, 122, 128, 136, 145, 152, 161, 171, 180, 189, 198,
+    207, 216, 225, 231, 241, 250, 256, 266, 275, 284, 293, 302,
+    311, 321, 328, 337, 347, 356, 364, 373, 382, 389, 398, 407,
+    416, 425, 437, 447, 457, 467, 476, 485, 494, 503, 512, 521,
+    533, 541, 553, 562, 566, 573, 583, 593, 602, 612, 621, 631,
+    646, 656, 664, 678, 687, 695, 704, 714, 723, 737, 750, 760,
+    770, 778, 788, 797, 806, 815, 830, 839, 852, 862, 875,
+};
+
+fonts_t fonts_7x10 =
+{
+    .font_width = 7,
+    .font_height = 10,
+    .format = FONTS_FORMAT_PAGES_RLE,
+    .pages = fonts_7x10_pages,
+    .offsets = fonts_7x10_offsets,
+};
+
+/* 11x18, 16 glyphs, 323 bytes, RLE */
+static const uint8_t fonts_11x18_pages[] =
+{
+    0xA0, 0x00, 0x8D, 0x00, 0x83, 0x06, 0x8E, 0x00, 0x8E, 0x00, 0x81, 0x60, 0x8F, 0x00, 0x03, 0x00,
+    0xF0, 0xFC, 0x0E, 0x81, 0x86, 0x02, 0x0E, 0xFC, 0xF0, 0x82, 0x00, 0x02, 0x0F, 0x3F, 0x70, 0x81,
+    0x61, 0x02, 0x70, 0x3F, 0x0F, 0x8C, 0x00, 0x81, 0x00, 0x02, 0x30, 0x18, 0x0C, 0x81, 0xFE, 0x88,
+    0x00, 0x81, 0x7F, 0x8E, 0x00, 0x03, 0x00, 0x38, 0x3C, 0x0E, 0x81, 0x06, 0x02, 0x8E, 0xFC, 0x78,
+    0x82, 0x00, 0x05, 0x70, 0x78, 0x6C, 0x66, 0x63, 0x61, 0x81, 0x60, 0x8C, 0x00, 0x03, 0x00, 0x18,
+    0x1C, 0x06, 0x81, 0xC6, 0x01, 0xFC, 0x38, 0x83, 0x00, 0x02, 0x18, 0x38, 0x70, 0x81, 0x60, 0x02,
+    0x71, 0x3F, 0x1E, 0x8C, 0x00, 0x81, 0x00, 0x02, 0x80, 0xF0, 0x3C, 0x81, 0xFE, 0x84, 0x00, 0x03,
+    0x0E, 0x0F, 0x0D, 0x0C, 0x81, 0x7F, 0x81, 0x0C, 0x8C, 0x00, 0x00, 0x00, 0x81, 0xFE, 0x00, 0x86,
+    0x82, 0xC6, 0x00, 0x86, 0x83, 0x00, 0x02, 0x19, 0x39, 0x70, 0x81, 0x60, 0x02, 0x71, 0x3F, 0x1F,
+    0x8C, 0x00, 0x03, 0x00, 0xF0, 0xFC, 0x8E, 0x81, 0xC6, 0x02, 0xCE, 0x9C, 0x18, 0x82, 0x00, 0x02,
+    0x0F, 0x3F, 0x71, 0x81, 0x60, 0x02, 0x71, 0x3F, 0x1F, 0x8C, 0x00, 0x00, 0x00, 0x83, 0x06, 0x03,
+    0xC6, 0xF6, 0x3E, 0x0E, 0x84, 0x00, 0x02, 0x70, 0x7F, 0x07, 0x8F, 0x00, 0x02, 0x00, 0x38, 0x7C,
+    0x82, 0x86, 0x02, 0x8E, 0x7C, 0x38, 0x82, 0x00, 0x01, 0x1E, 0x3F, 0x83, 0x61, 0x01, 0x3F, 0x1E,
+    0x8C, 0x00, 0x03, 0x00, 0xF8, 0xFC, 0x8E, 0x81, 0x06, 0x02, 0x8E, 0xFC, 0xF0, 0x82, 0x00, 0x02,
+    0x18, 0x39, 0x73, 0x81, 0x63, 0x02, 0x71, 0x3F, 0x0F, 0x8C, 0x00, 0x83, 0x00, 0x81, 0x60, 0x88,
+    0x00, 0x81, 0x60, 0x8F, 0x00, 0x00, 0x00, 0x81, 0xFE, 0x82, 0x06, 0x02, 0x1C, 0xFC, 0xF0, 0x82,
+    0x00, 0x81, 0x7F, 0x82, 0x60, 0x02, 0x38, 0x1F, 0x07, 0x8C, 0x00, 0x81, 0x00, 0x02, 0x78, 0xFC,
+    0xC6, 0x81, 0x86, 0x01, 0x1C, 0x18, 0x82, 0x00, 0x07, 0x0C, 0x3C, 0x70, 0x60, 0x61, 0x63, 0x3F,
+    0x1E, 0x8C, 0x00,
+};
+
+static const uint16_t fonts_11x18_offsets[] =
+{
+    0, 2, 8, 14, 39, 53, 77, 101, 122, 146, 171, 188,
+    210, 235, 245, 267,
+};
+
+fonts_t fonts_11x18 =
+{
+    .font_width = 11,
+    .font_height = 18,
+    .format = FONTS_FORMAT_PAGES_RLE,
+    .pages = fonts_11x18_pages,
+    .offsets = fonts_11x18_offsets,
+    .charset = " -.0123456789:DS",
+};
+
+#endif // !FONTS_ROW_FONTS
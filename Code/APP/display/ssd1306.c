@@ -24,16 +24,53 @@
 #include <string.h>
 
 #include "ssd1306.h"
+#include "common.h"
 
 #include "periph/i2c.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "periph/dma.h"
+#include "display/ssd1306_vpanel.h"
+#include "spi_bus.h"
+#include "i2c_sched.h"
 
 #include "cmsis_os2.h"
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
+/* Panel setup, sent in one command burst */
+static const uint8_t ssd1306_init_cmds[] =
+{
+    0xAE,       // Display off
+    0x20,       // Set memory addressing mode: 00 - horizontal, 01 - vertical, 10 - page (reset)
+    SSD1306_HORIZONTAL_ADDRESSING ? 0x00 : 0x02,
+    0xB0,       // Set page start address for page addressing mode, 0-7
+    0xC8,       // Set COM output scan direction
+    0x00,       // Set low column address
+    0x10,       // Set high column address
+    0x40,       // Set start line address
+    0x81,       // Set contrast control register
+    0xFF,
+    0xA1,       // Set segment re-map 0 to 127
+    0xA6,       // Set normal display
+    0xA8,       // Set multiplex ratio (1 to 64)
+    0x3F,
+    0xA4,       // 0xA4 - output follows RAM content, 0xA5 - output ignores RAM content
+    0xD3,       // Set display offset
+    0x00,       // Not offset
+    0xD5,       // Set display clock divide ratio/oscillator frequency
+    0xF0,       // Set divide ratio
+    0xD9,       // Set pre-charge period
+    0x22,
+    0xDA,       // Set COM pins hardware configuration
+    0x12,
+    0xDB,       // Set VCOMH
+    0x20,       // 0x20 - 0.77xVcc
+    0x8D,       // Set DC-DC enable
+    0x14,
+    0xAF,       // Turn on SSD1306 panel
+};
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -45,17 +82,54 @@
 //#define SSD1306_WRITEDATA(data)             i2c_write_reg((SSD1306_I2C_ADDR >> 1), 0x40, (data))
 /** Absolute value. */
 #define ABS(x)   ((x) > 0 ? (x) : -(x))
+/** Number of 8 pixel high pages in display RAM. */
+#define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+/** Thread flag set when frame flush is complete. */
+#define SSD1306_FLUSH_FLAG      0x1000U
+/** Maximum time to wait for frame flush in ms. */
+#define SSD1306_FLUSH_TIMEOUT   100
+/** I2C scheduler priority, sensor reads go ahead of frame data. */
+#define SSD1306_I2C_PRIORITY    0
 
 
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
+/**
+ * @brief   Columns of a single page changed since last flush. Page is clean when x_min > x_max.
+ */
+typedef struct
+{
+    uint8_t x_min;  //!< First changed column.
+    uint8_t x_max;  //!< Last changed column.
+} ssd1306_dirty_t;
 
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
-/* SSD1306 data buffer */
+/* SSD1306 data buffer, all drawing goes here */
 static uint8_t ssd1306_buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8 + 1];
+/* SSD1306 front buffer, owned by flush in progress */
+static uint8_t ssd1306_front[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
+/* SSD1306 dirty regions per page */
+static ssd1306_dirty_t ssd1306_dirty[SSD1306_PAGES];
+
+/* SSD1306 frame flush state */
+static struct
+{
+#if SSD1306_HORIZONTAL_ADDRESSING
+    uint8_t window[6];                      //!< Address window commands for packed front buffer.
+#else
+    ssd1306_dirty_t dirty[SSD1306_PAGES];   //!< Regions of front buffer still to send.
+    uint8_t commands[3];                    //!< Address commands of page being sent.
+    bool data;                              //!< Address of page is sent, its data goes next.
+#endif
+    volatile bool busy;                     //!< Flush in progress.
+    uint8_t page;                           //!< Page being sent.
+    osThreadId_t volatile thread;           //!< Thread waiting for completion, NULL if none.
+    uint32_t start;                         //!< System timer count at flush start.
+    ssd1306_stats_t stats;                  //!< Flush statistics.
+} ssd1306_flush;
 
 typedef struct {
     uint16_t current_x;
@@ -76,42 +150,34 @@ static ssd1306_t ssd1306_data = {0};
  * Prototypes of local functions
  *********************************************************************************************************************/
 static void ssd1306_write_cmd(uint8_t command);
-static void ssd1306_write_data(uint8_t *data, uint16_t size);
+static void ssd1306_write_cmds(const uint8_t *commands, uint8_t count);
+static void ssd1306_io_select(bool select);
+static void ssd1306_io_write_cmds(const uint8_t *commands, uint8_t count);
+static bool ssd1306_io_write_cmds_async(uint8_t *commands, uint8_t count);
+static bool ssd1306_io_write_data(uint8_t *data, uint16_t size);
+#if SSD1306_DRV_MODE == 1
+static bool ssd1306_io_i2c_write(uint8_t control, const uint8_t *data, uint16_t size);
+#endif
+static void ssd1306_flush_next(void);
+static void ssd1306_flush_done(bool error);
+static void ssd1306_flush_wait(void);
+static inline void ssd1306_dirty_mark(uint16_t x, uint16_t page);
+static void ssd1306_dirty_mark_all(void);
+static void ssd1306_blit_column(uint16_t x, uint16_t y, uint32_t bits, uint8_t height, ssd1306_color_t c);
+static void ssd1306_fill_area(int16_t x0, int16_t y0, int16_t x1, int16_t y1, ssd1306_color_t c);
+static void ssd1306_edge_scan(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, int16_t *x_min, int16_t *x_max);
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
 bool ssd1306_init(void)
 {
+#if SSD1306_VPANEL
+    ssd1306_vpanel_reset();
+#endif
+
     /* Init LCD */
-    ssd1306_write_cmd(0xAE); //display off
-    ssd1306_write_cmd(0x20); //Set Memory Addressing Mode
-    ssd1306_write_cmd(0x10); //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
-    ssd1306_write_cmd(0xB0); //Set Page Start Address for Page Addressing Mode,0-7
-    ssd1306_write_cmd(0xC8); //Set COM Output Scan Direction
-    ssd1306_write_cmd(0x00); //---set low column address
-    ssd1306_write_cmd(0x10); //---set high column address
-    ssd1306_write_cmd(0x40); //--set start line address
-    ssd1306_write_cmd(0x81); //--set contrast control register
-    ssd1306_write_cmd(0xFF);
-    ssd1306_write_cmd(0xA1); //--set segment re-map 0 to 127
-    ssd1306_write_cmd(0xA6); //--set normal display
-    ssd1306_write_cmd(0xA8); //--set multiplex ratio(1 to 64)
-    ssd1306_write_cmd(0x3F); //
-    ssd1306_write_cmd(0xA4); //0xa4,Output follows RAM content;0xa5,Output ignores RAM content
-    ssd1306_write_cmd(0xD3); //-set display offset
-    ssd1306_write_cmd(0x00); //-not offset
-    ssd1306_write_cmd(0xD5); //--set display clock divide ratio/oscillator frequency
-    ssd1306_write_cmd(0xF0); //--set divide ratio
-    ssd1306_write_cmd(0xD9); //--set pre-charge period
-    ssd1306_write_cmd(0x22); //
-    ssd1306_write_cmd(0xDA); //--set com pins hardware configuration
-    ssd1306_write_cmd(0x12);
-    ssd1306_write_cmd(0xDB); //--set vcomh
-    ssd1306_write_cmd(0x20); //0x20,0.77xVcc
-    ssd1306_write_cmd(0x8D); //--set DC-DC enable
-    ssd1306_write_cmd(0x14); //
-    ssd1306_write_cmd(0xAF); //--turn on SSD1306 panel
+    ssd1306_write_cmds(ssd1306_init_cmds, sizeof(ssd1306_init_cmds));
 
     /* Clear screen */
     ssd1306_fill(SSD1306_COLOR_BLACK);
@@ -132,18 +198,18 @@ bool ssd1306_init(void)
 
 void ssd1306_display_on(void)
 {
-    ssd1306_write_cmd(0x8D);
-    ssd1306_write_cmd(0x14);
-    ssd1306_write_cmd(0xAF);
+    const uint8_t commands[] = {0x8D, 0x14, 0xAF};
+
+    ssd1306_write_cmds(commands, sizeof(commands));
 
     return;
 }
 
 void ssd1306_display_off(void)
 {
-    ssd1306_write_cmd(0x8D);
-    ssd1306_write_cmd(0x10);
-    ssd1306_write_cmd(0xAE);
+    const uint8_t commands[] = {0x8D, 0x10, 0xAE};
+
+    ssd1306_write_cmds(commands, sizeof(commands));
 
     return;
 }
@@ -164,8 +230,9 @@ void ssd1306_display_normal(void)
 
 void ssd1306_set_contrast(uint8_t contrast)
 {
-    ssd1306_write_cmd(0x81);
-    ssd1306_write_cmd(contrast);
+    const uint8_t commands[] = {0x81, contrast};
+
+    ssd1306_write_cmds(commands, sizeof(commands));
 
     return;
 }
@@ -197,6 +264,7 @@ void ss1306_orientation_flip_v(void)
         ssd1306_write_cmd(0xA0 | 0x00);
     }
     ssd1306_write_cmd(0xC8);
+    ssd1306_dirty_mark_all();
 
     return;
 }
@@ -204,16 +272,101 @@ void ss1306_orientation_flip_v(void)
 void ssd1306_update_screen(void)
 {
     uint8_t y = 0;
+    uint32_t bytes = 0;
+#if SSD1306_HORIZONTAL_ADDRESSING
+    ssd1306_dirty_t area = {UINT8_MAX, 0};
+    uint8_t page_min = UINT8_MAX;
+    uint8_t page_max = 0;
+#endif
+
+    /* Front buffer can be touched only when previous flush is done */
+    ssd1306_flush_wait();
 
-    for(y = 0; y < SSD1306_HEIGHT / 8; y++)
+#if SSD1306_HORIZONTAL_ADDRESSING
+    /* Bounding window of all changes */
+    for(y = 0; y < SSD1306_PAGES; y++)
     {
-        ssd1306_write_cmd(0xB0 + y);
-        ssd1306_write_cmd(0x02);
-        ssd1306_write_cmd(0x10);
+        if(ssd1306_dirty[y].x_min > ssd1306_dirty[y].x_max)
+        {
+            continue;
+        }
+        page_min = MIN(page_min, y);
+        page_max = y;
+        area.x_min = MIN(area.x_min, ssd1306_dirty[y].x_min);
+        area.x_max = MAX(area.x_max, ssd1306_dirty[y].x_max);
+        ssd1306_dirty[y].x_min = UINT8_MAX;
+        ssd1306_dirty[y].x_max = 0;
+    }
+    if(page_min > page_max)
+    {
+        return;
+    }
 
-        ssd1306_write_data(&ssd1306_buffer[SSD1306_WIDTH * y], SSD1306_WIDTH);
+    /* Pack window to front buffer in the order panel fills it, drawing can continue while it is sent */
+    for(y = page_min; y <= page_max; y++)
+    {
+        memcpy(&ssd1306_front[bytes], &ssd1306_buffer[SSD1306_WIDTH * y + area.x_min], area.x_max - area.x_min + 1);
+        bytes += area.x_max - area.x_min + 1;
+    }
+    ssd1306_flush.window[0] = 0x21;
+    ssd1306_flush.window[1] = area.x_min + SSD1306_COLUMN_OFFSET;
+    ssd1306_flush.window[2] = area.x_max + SSD1306_COLUMN_OFFSET;
+    ssd1306_flush.window[3] = 0x22;
+    ssd1306_flush.window[4] = page_min;
+    ssd1306_flush.window[5] = page_max;
+#else
+    /* Move changed regions to front buffer, drawing can continue while they are sent */
+    for(y = 0; y < SSD1306_PAGES; y++)
+    {
+        ssd1306_flush.dirty[y] = ssd1306_dirty[y];
+        if(ssd1306_dirty[y].x_min > ssd1306_dirty[y].x_max)
+        {
+            continue;
+        }
+        memcpy(&ssd1306_front[SSD1306_WIDTH * y + ssd1306_dirty[y].x_min],
+            &ssd1306_buffer[SSD1306_WIDTH * y + ssd1306_dirty[y].x_min],
+            ssd1306_dirty[y].x_max - ssd1306_dirty[y].x_min + 1);
+        bytes += ssd1306_dirty[y].x_max - ssd1306_dirty[y].x_min + 1;
+        ssd1306_dirty[y].x_min = UINT8_MAX;
+        ssd1306_dirty[y].x_max = 0;
+    }
+    if(bytes == 0)
+    {
+        return;
     }
-    osDelay(1);
+#endif
+
+    /* Whole frame goes out under single chip select */
+    ssd1306_flush.stats.bytes = bytes;
+    ssd1306_flush.start = osKernelGetSysTimerCount();
+    ssd1306_flush.page = 0;
+#if !SSD1306_HORIZONTAL_ADDRESSING
+    ssd1306_flush.data = false;
+#endif
+    ssd1306_flush.busy = true;
+    ssd1306_io_select(true);
+    ssd1306_flush_next();
+
+    return;
+}
+
+void ssd1306_update_screen_wait(void)
+{
+    ssd1306_flush_wait();
+
+    return;
+}
+
+void ssd1306_get_stats(ssd1306_stats_t *stats)
+{
+    *stats = ssd1306_flush.stats;
+
+    return;
+}
+
+void ssd1306_invalidate(void)
+{
+    ssd1306_dirty_mark_all();
 
     return;
 }
@@ -230,6 +383,7 @@ void ssd1306_toggle_invert(void)
     {
         ssd1306_buffer[i] = ~ssd1306_buffer[i];
     }
+    ssd1306_dirty_mark_all();
 
     return;
 }
@@ -238,12 +392,16 @@ void ssd1306_fill(ssd1306_color_t color)
 {
     /* Set memory */
     memset(ssd1306_buffer, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF, sizeof(ssd1306_buffer));
+    ssd1306_dirty_mark_all();
 
     return;
 }
 
 void ssd1306_draw_pixel(uint16_t x, uint16_t y, ssd1306_color_t c)
 {
+    uint8_t *byte = NULL;
+    uint8_t value = 0;
+
     if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
     {
         /* Error */
@@ -257,13 +415,21 @@ void ssd1306_draw_pixel(uint16_t x, uint16_t y, ssd1306_color_t c)
     }
 
     /* Set color */
+    byte = &ssd1306_buffer[x + (y / 8) * SSD1306_WIDTH];
     if(c == SSD1306_COLOR_WHITE)
     {
-        ssd1306_buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+        value = *byte | (1 << (y % 8));
     }
     else
     {
-        ssd1306_buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+        value = *byte & ~(1 << (y % 8));
+    }
+
+    /* Track only real changes, redrawing the same content costs nothing on flush */
+    if(value != *byte)
+    {
+        *byte = value;
+        ssd1306_dirty_mark(x, y / 8);
     }
 
     return;
@@ -280,9 +446,8 @@ void ssd1306_goto_xy(uint16_t x, uint16_t y)
 
 uint8_t ssd1306_putc(uint8_t ch, fonts_t *font, ssd1306_color_t color)
 {
-    uint32_t i = 0;
-    uint32_t b = 0;
     uint32_t j = 0;
+    uint32_t columns[FONTS_MAX_WIDTH];
 
     /* Check available space in LCD */
     if(SSD1306_WIDTH <= (ssd1306_data.current_x + font->font_width)
@@ -292,21 +457,11 @@ uint8_t ssd1306_putc(uint8_t ch, fonts_t *font, ssd1306_color_t color)
         return 0;
     }
 
-    /* Go through font */
-    for(i = 0; i < font->font_height; i++)
+    /* Write glyph column by column, each touches at most few page bytes */
+    fonts_get_glyph_columns(font, ch, columns);
+    for(j = 0; j < font->font_width; j++)
     {
-        b = font->data[(ch - 32) * font->font_height + i];
-        for(j = 0; j < font->font_width; j++)
-        {
-            if((b << j) & 0x8000)
-            {
-                ssd1306_draw_pixel(ssd1306_data.current_x + j, (ssd1306_data.current_y + i), (ssd1306_color_t)color);
-            }
-            else
-            {
-                ssd1306_draw_pixel(ssd1306_data.current_x + j, (ssd1306_data.current_y + i), (ssd1306_color_t)!color);
-            }
-        }
+        ssd1306_blit_column(ssd1306_data.current_x + j, ssd1306_data.current_y, columns[j], font->font_height, color);
     }
 
     /* Increase pointer */
@@ -344,7 +499,6 @@ void ssd1306_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ssd13
     int16_t sy = 0;
     int16_t err = 0;
     int16_t e2 = 0;
-    int16_t i = 0;
     int16_t tmp = 0;
 
     /* Check for overflow */
@@ -388,10 +542,7 @@ void ssd1306_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ssd13
         }
 
         /* Vertical line */
-        for(i = y0; i <= y1; i++)
-        {
-            ssd1306_draw_pixel(x0, i, c);
-        }
+        ssd1306_fill_area(x0, y0, x0, y1, c);
 
         /* Return from function */
         return;
@@ -414,10 +565,7 @@ void ssd1306_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ssd13
         }
 
         /* Horizontal line */
-        for(i = x0; i <= x1; i++)
-        {
-            ssd1306_draw_pixel(i, y0, c);
-        }
+        ssd1306_fill_area(x0, y0, x1, y0, c);
 
         /* Return from function */
         return;
@@ -476,8 +624,6 @@ void ssd1306_draw_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1
 
 void ssd1306_draw_filled_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1306_color_t c)
 {
-    uint8_t i = 0;
-
     /* Check input parameters */
     if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
     {
@@ -495,12 +641,8 @@ void ssd1306_draw_filled_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t
         h = SSD1306_HEIGHT - y;
     }
 
-    /* Draw lines */
-    for(i = 0; i <= h; i++)
-    {
-        /* Draw lines */
-        ssd1306_draw_line(x, y + i, x + w, y + i, c);
-    }
+    /* Fill page by page, area is clipped to screen */
+    ssd1306_fill_area(x, y, x + w, y + h, c);
 
     return;
 }
@@ -517,79 +659,27 @@ void ssd1306_draw_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, u
 
 void ssd1306_draw_filled_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, ssd1306_color_t c)
 {
-    int16_t deltax = 0;
-    int16_t deltay = 0;
-    int16_t x = 0;
+    int16_t x_min[SSD1306_HEIGHT];
+    int16_t x_max[SSD1306_HEIGHT];
     int16_t y = 0;
-    int16_t xinc1 = 0;
-    int16_t xinc2 = 0;
-    int16_t yinc1 = 0;
-    int16_t yinc2 = 0;
-    int16_t den = 0;
-    int16_t num = 0;
-    int16_t numadd = 0;
-    int16_t numpixels = 0;
-    int16_t curpixel = 0;
-
-    deltax = ABS(x2 - x1);
-    deltay = ABS(y2 - y1);
-    x = x1;
-    y = y1;
-
-    if(x2 >= x1)
-    {
-        xinc1 = 1;
-        xinc2 = 1;
-    }
-    else
-    {
-        xinc1 = -1;
-        xinc2 = -1;
-    }
 
-    if(y2 >= y1)
-    {
-        yinc1 = 1;
-        yinc2 = 1;
-    }
-    else
+    for(y = 0; y < SSD1306_HEIGHT; y++)
     {
-        yinc1 = -1;
-        yinc2 = -1;
+        x_min[y] = SSD1306_WIDTH;
+        x_max[y] = -1;
     }
 
-    if(deltax >= deltay)
-    {
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    }
-    else
-    {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
-    }
+    /* Collect horizontal extent of edges on every scanline, then fill scanlines */
+    ssd1306_edge_scan(x1, y1, x2, y2, x_min, x_max);
+    ssd1306_edge_scan(x2, y2, x3, y3, x_min, x_max);
+    ssd1306_edge_scan(x3, y3, x1, y1, x_min, x_max);
 
-    for(curpixel = 0; curpixel <= numpixels; curpixel++)
+    for(y = 0; y < SSD1306_HEIGHT; y++)
     {
-        ssd1306_draw_line(x, y, x3, y3, c);
-
-        num += numadd;
-        if(num >= den)
+        if(x_min[y] <= x_max[y])
         {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
+            ssd1306_fill_area(x_min[y], y, x_max[y], y, c);
         }
-        x += xinc2;
-        y += yinc2;
     }
 
     return;
@@ -644,9 +734,7 @@ void ssd1306_draw_filled_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color
 
     ssd1306_draw_pixel(x0, y0 + r, c);
     ssd1306_draw_pixel(x0, y0 - r, c);
-    ssd1306_draw_pixel(x0 + r, y0, c);
-    ssd1306_draw_pixel(x0 - r, y0, c);
-    ssd1306_draw_line(x0 - r, y0, x0 + r, y0, c);
+    ssd1306_fill_area(x0 - r, y0, x0 + r, y0, c);
 
     while(x < y)
     {
@@ -660,11 +748,15 @@ void ssd1306_draw_filled_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color
         ddF_x += 2;
         f += ddF_x;
 
-        ssd1306_draw_line(x0 - x, y0 + y, x0 + x, y0 + y, c);
-        ssd1306_draw_line(x0 + x, y0 - y, x0 - x, y0 - y, c);
+        /* Rows y0 +- y only get wider while y stays, fill them once at last width */
+        if(f >= 0 || x >= y)
+        {
+            ssd1306_fill_area(x0 - x, y0 + y, x0 + x, y0 + y, c);
+            ssd1306_fill_area(x0 - x, y0 - y, x0 + x, y0 - y, c);
+        }
 
-        ssd1306_draw_line(x0 + y, y0 + x, x0 - y, y0 + x, c);
-        ssd1306_draw_line(x0 + y, y0 - x, x0 - y, y0 - x, c);
+        ssd1306_fill_area(x0 - y, y0 + x, x0 + y, y0 + x, c);
+        ssd1306_fill_area(x0 - y, y0 - x, x0 + y, y0 - x, c);
     }
 
     return;
@@ -675,30 +767,491 @@ void ssd1306_draw_filled_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color
  *********************************************************************************************************************/
 static void ssd1306_write_cmd(uint8_t command)
 {
-#if SSD1306_DRV_MODE
-    i2c_write_reg((SSD1306_I2C_ADDR >> 1), 0x00, (command));
+    ssd1306_write_cmds(&command, 1);
+
+    return;
+}
+
+static void ssd1306_write_cmds(const uint8_t *commands, uint8_t count)
+{
+    /* Commands must not interleave with frame data */
+    ssd1306_flush_wait();
+    ssd1306_io_select(true);
+    ssd1306_io_write_cmds(commands, count);
+    ssd1306_io_select(false);
+
+    return;
+}
+
+static void ssd1306_io_select(bool select)
+{
+#if SSD1306_DRV_MODE == 0
+    /* Bus takes care of chip select, release may come from DMA interrupt */
+    if(select)
+    {
+        spi_bus_acquire(SPI_BUS_DEVICE_DISPLAY, osWaitForever);
+    }
+    else
+    {
+        spi_bus_release(SPI_BUS_DEVICE_DISPLAY);
+    }
+#else
+    UNUSED_VARIABLE(select);
+#endif
+
+    return;
+}
+
+/**
+ * @brief   Send command burst, panel must be selected.
+ *
+ * @param   commands    Command bytes with their arguments.
+ * @param   count       Number of bytes.
+ */
+static void ssd1306_io_write_cmds(const uint8_t *commands, uint8_t count)
+{
+#if SSD1306_VPANEL
+    uint8_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        ssd1306_vpanel_cmd(commands[i]);
+    }
+#endif
+#if SSD1306_DRV_MODE == 2
+#elif SSD1306_DRV_MODE == 1
+    ssd1306_io_i2c_write(0x00, commands, count);
 #else
-    gpio_output_high(GPIO_DISPLAY_SELECT);
+    /* Blocking write returns when last byte is shifted out, D/C can be changed right after it */
     gpio_output_low(GPIO_DISPLAY_DC);
-    gpio_output_low(GPIO_DISPLAY_SELECT);
-    spi_0_write_buffer(&command, 1);
-    gpio_output_high(GPIO_DISPLAY_SELECT);
+    spi_0_write_buffer(commands, count);
 #endif
 
     return;
 }
 
-static void ssd1306_write_data(uint8_t *data, uint16_t size)
+/**
+ * @brief   Send command burst of frame flush, panel must be selected. Over SPI commands go by DMA like frame data,
+ *          so flush completion interrupt never waits for a blocking write. D/C is a GPIO, so it is switched between
+ *          DMA transfers, after previous one is shifted out.
+ *
+ * @param   commands    Command bytes, must stay valid until completion.
+ * @param   count       Number of bytes.
+ *
+ * @return  False if transfer could not be started.
+ */
+static bool ssd1306_io_write_cmds_async(uint8_t *commands, uint8_t count)
+{
+#if SSD1306_DRV_MODE == 0
+#if SSD1306_VPANEL
+    uint8_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        ssd1306_vpanel_cmd(commands[i]);
+    }
+#endif
+    gpio_output_low(GPIO_DISPLAY_DC);
+
+    return spi_0_write_buffer_dma(commands, count, ssd1306_flush_done);
+#else
+    ssd1306_io_write_cmds(commands, count);
+    ssd1306_flush_done(false);
+
+    return true;
+#endif
+}
+
+static bool ssd1306_io_write_data(uint8_t *data, uint16_t size)
 {
-#if SSD1306_DRV_MODE
-    i2c_write_reg_multi((SSD1306_I2C_ADDR >> 1), 0x40, data, size);
+#if SSD1306_VPANEL
+    ssd1306_vpanel_data(data, size);
+#endif
+#if SSD1306_DRV_MODE == 2
+    ssd1306_flush_done(false);
+#elif SSD1306_DRV_MODE == 1
+    ssd1306_flush_done(ssd1306_io_i2c_write(0x40, data, size) == false);
 #else
-    gpio_output_high(GPIO_DISPLAY_SELECT);
     gpio_output_high(GPIO_DISPLAY_DC);
-    gpio_output_low(GPIO_DISPLAY_SELECT);
-    spi_0_write_buffer(data, size);
-    gpio_output_high(GPIO_DISPLAY_SELECT);
+    if(spi_0_write_buffer_dma(data, size, ssd1306_flush_done) == false)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+#if SSD1306_DRV_MODE == 1
+/**
+ * @brief   Write control byte followed by data as one I2C scheduler job.
+ *
+ * @param   control Control byte, 0x00 for commands, 0x40 for data.
+ * @param   data    Bytes to send after control byte.
+ * @param   size    Number of bytes.
+ *
+ * @return  True if transfer succeeded.
+ */
+static bool ssd1306_io_i2c_write(uint8_t control, const uint8_t *data, uint16_t size)
+{
+    i2c_xfer_t xfer = {.addr = (SSD1306_I2C_ADDR >> 1), .tx = &control, .tx_size = 1, .data = data, .data_size = size};
+
+    return i2c_sched_xfer(&xfer, SSD1306_I2C_PRIORITY) == I2C_STATUS_OK;
+}
+#endif
+
+/**
+ * @brief   Send next part of front buffer: whole window in horizontal addressing mode, otherwise next dirty page.
+ *          Runs in thread context for first part and in DMA interrupt for others.
+ */
+static void ssd1306_flush_next(void)
+{
+    uint32_t time = 0;
+#if SSD1306_HORIZONTAL_ADDRESSING
+
+    /* Window commands first, then whole window data */
+    if(ssd1306_flush.page == 0)
+    {
+        ssd1306_flush.page = 1;
+        if(ssd1306_io_write_cmds_async(ssd1306_flush.window, sizeof(ssd1306_flush.window)) == true)
+        {
+            return;
+        }
+    }
+    else if(ssd1306_flush.page == 1)
+    {
+        ssd1306_flush.page = SSD1306_PAGES;
+        if(ssd1306_io_write_data(ssd1306_front, ssd1306_flush.stats.bytes) == true)
+        {
+            return;
+        }
+    }
+#else
+    uint8_t y = 0;
+    uint8_t column = 0;
+
+    if(ssd1306_flush.data)
+    {
+        /* Address of page is sent, now its data */
+        ssd1306_flush.data = false;
+        y = ssd1306_flush.page - 1;
+        if(ssd1306_io_write_data(&ssd1306_front[SSD1306_WIDTH * y + ssd1306_flush.dirty[y].x_min],
+            ssd1306_flush.dirty[y].x_max - ssd1306_flush.dirty[y].x_min + 1) == true)
+        {
+            return;
+        }
+    }
+    else
+    {
+        for(y = ssd1306_flush.page; y < SSD1306_PAGES; y++)
+        {
+            if(ssd1306_flush.dirty[y].x_min <= ssd1306_flush.dirty[y].x_max)
+            {
+                break;
+            }
+        }
+        if(y < SSD1306_PAGES)
+        {
+            ssd1306_flush.page = y + 1;
+            ssd1306_flush.data = true;
+            column = ssd1306_flush.dirty[y].x_min + SSD1306_COLUMN_OFFSET;
+            ssd1306_flush.commands[0] = 0xB0 + y;
+            ssd1306_flush.commands[1] = 0x00 | (column & 0x0F);
+            ssd1306_flush.commands[2] = 0x10 | (column >> 4);
+            if(ssd1306_io_write_cmds_async(ssd1306_flush.commands, sizeof(ssd1306_flush.commands)) == true)
+            {
+                return;
+            }
+        }
+    }
 #endif
 
+    /* All is sent (or transfer failed) */
+    ssd1306_io_select(false);
+    time = (osKernelGetSysTimerCount() - ssd1306_flush.start) / (osKernelGetSysTimerFreq() / 1000000);
+    ssd1306_flush.stats.time_us = time;
+    if(time > ssd1306_flush.stats.time_max_us)
+    {
+        ssd1306_flush.stats.time_max_us = time;
+    }
+    ssd1306_flush.stats.count++;
+    ssd1306_flush.busy = false;
+    if(ssd1306_flush.thread != NULL)
+    {
+        osThreadFlagsSet(ssd1306_flush.thread, SSD1306_FLUSH_FLAG);
+    }
+
+    return;
+}
+
+static void ssd1306_flush_done(bool error)
+{
+    if(error)
+    {
+        ssd1306_flush.stats.errors++;
+    }
+    ssd1306_flush_next();
+
+    return;
+}
+
+static void ssd1306_flush_wait(void)
+{
+    while(ssd1306_flush.busy)
+    {
+        /* Flush may be started by other thread, e.g. first frame by init, so waiter registers itself */
+        ssd1306_flush.thread = osThreadGetId();
+        if(ssd1306_flush.busy == false)
+        {
+            break;
+        }
+        if(osThreadFlagsWait(SSD1306_FLUSH_FLAG, osFlagsWaitAny, SSD1306_FLUSH_TIMEOUT) == (uint32_t)osErrorTimeout)
+        {
+            /* Transfer got lost, drop it and resend whole frame */
+#if SSD1306_DRV_MODE == 0
+            dma_abort(DMA_ID_SPI_0_TX);
+#endif
+            ssd1306_io_select(false);
+            ssd1306_flush.stats.errors++;
+            ssd1306_flush.busy = false;
+            ssd1306_dirty_mark_all();
+        }
+    }
+    ssd1306_flush.thread = NULL;
+
+    return;
+}
+
+static inline void ssd1306_dirty_mark(uint16_t x, uint16_t page)
+{
+    if(x < ssd1306_dirty[page].x_min)
+    {
+        ssd1306_dirty[page].x_min = x;
+    }
+    if(x > ssd1306_dirty[page].x_max)
+    {
+        ssd1306_dirty[page].x_max = x;
+    }
+
+    return;
+}
+
+static void ssd1306_dirty_mark_all(void)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < SSD1306_PAGES; i++)
+    {
+        ssd1306_dirty[i].x_min = 0;
+        ssd1306_dirty[i].x_max = SSD1306_WIDTH - 1;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Write single column of pixels. Set bits are drawn with color c, cleared bits with opposite color.
+ *
+ * @param   x       X location of column.
+ * @param   y       Y location of top pixel.
+ * @param   bits    Column pixels, bit 0 is top pixel.
+ * @param   height  Column height in pixels, up to 32.
+ * @param   c       Color of set bits. See @ref ssd1306_color_t.
+ */
+static void ssd1306_blit_column(uint16_t x, uint16_t y, uint32_t bits, uint8_t height, ssd1306_color_t c)
+{
+    uint32_t mask = height >= 32 ? UINT32_MAX : ((1UL << height) - 1);
+    uint8_t page = y / 8;
+    uint8_t shift = y % 8;
+    uint8_t *byte = NULL;
+    uint8_t m = 0;
+    uint8_t value = 0;
+
+    if(x >= SSD1306_WIDTH || page >= SSD1306_PAGES)
+    {
+        return;
+    }
+
+    /* Check if pixels are inverted */
+    if(ssd1306_data.inverted)
+    {
+        c = (ssd1306_color_t)!c;
+    }
+    /* Turn column into lit pixels */
+    bits = (c == SSD1306_COLOR_WHITE) ? (bits & mask) : (~bits & mask);
+
+    /* First page takes rows shifted by y offset, following ones take whole bytes */
+    m = (uint8_t)(mask << shift);
+    value = (uint8_t)(bits << shift);
+    mask >>= 8 - shift;
+    bits >>= 8 - shift;
+    while(1)
+    {
+        byte = &ssd1306_buffer[x + page * SSD1306_WIDTH];
+        value = (*byte & ~m) | (value & m);
+        if(value != *byte)
+        {
+            *byte = value;
+            ssd1306_dirty_mark(x, page);
+        }
+
+        page++;
+        if(mask == 0 || page >= SSD1306_PAGES)
+        {
+            break;
+        }
+        m = (uint8_t)mask;
+        value = (uint8_t)bits;
+        mask >>= 8;
+        bits >>= 8;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Fill area with color. Area is clipped to screen. Single row is horizontal span, single column is vertical
+ *          span. Every touched page is written with one byte mask per column.
+ *
+ * @param   x0  X of first corner.
+ * @param   y0  Y of first corner.
+ * @param   x1  X of opposite corner, included.
+ * @param   y1  Y of opposite corner, included.
+ * @param   c   Color to be used. See @ref ssd1306_color_t.
+ */
+static void ssd1306_fill_area(int16_t x0, int16_t y0, int16_t x1, int16_t y1, ssd1306_color_t c)
+{
+    int16_t tmp = 0;
+    int16_t x = 0;
+    int16_t first = 0;
+    int16_t last = 0;
+    uint8_t page = 0;
+    uint8_t mask = 0;
+    uint8_t set = 0;
+    uint8_t keep = 0;
+    uint8_t value = 0;
+    uint8_t *byte = NULL;
+
+    if(x1 < x0)
+    {
+        tmp = x1;
+        x1 = x0;
+        x0 = tmp;
+    }
+    if(y1 < y0)
+    {
+        tmp = y1;
+        y1 = y0;
+        y0 = tmp;
+    }
+
+    /* Clip to screen */
+    if(x1 < 0 || y1 < 0 || x0 >= SSD1306_WIDTH || y0 >= SSD1306_HEIGHT)
+    {
+        return;
+    }
+    x0 = x0 < 0 ? 0 : x0;
+    y0 = y0 < 0 ? 0 : y0;
+    x1 = x1 >= SSD1306_WIDTH ? SSD1306_WIDTH - 1 : x1;
+    y1 = y1 >= SSD1306_HEIGHT ? SSD1306_HEIGHT - 1 : y1;
+
+    /* Check if pixels are inverted */
+    if(ssd1306_data.inverted)
+    {
+        c = (ssd1306_color_t)!c;
+    }
+
+    for(page = y0 / 8; page <= y1 / 8; page++)
+    {
+        /* Edge pages take only rows inside area */
+        mask = 0xFF;
+        if(page == y0 / 8)
+        {
+            mask &= 0xFF << (y0 % 8);
+        }
+        if(page == y1 / 8)
+        {
+            mask &= 0xFF >> (7 - y1 % 8);
+        }
+
+        /* White sets masked bits, black clears them */
+        set = (c == SSD1306_COLOR_WHITE) ? mask : 0x00;
+        keep = ~mask;
+
+        first = -1;
+        byte = &ssd1306_buffer[x0 + page * SSD1306_WIDTH];
+        for(x = x0; x <= x1; x++, byte++)
+        {
+            value = (*byte & keep) | set;
+            if(value != *byte)
+            {
+                *byte = value;
+                first = first < 0 ? x : first;
+                last = x;
+            }
+        }
+
+        if(first >= 0)
+        {
+            ssd1306_dirty_mark(first, page);
+            ssd1306_dirty_mark(last, page);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief   Walk edge the same way as @ref ssd1306_draw_line and widen scanline extents with its pixels.
+ *
+ * @param   x0      X of edge start.
+ * @param   y0      Y of edge start.
+ * @param   x1      X of edge end.
+ * @param   y1      Y of edge end.
+ * @param   x_min   Leftmost pixel of every scanline.
+ * @param   x_max   Rightmost pixel of every scanline.
+ */
+static void ssd1306_edge_scan(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, int16_t *x_min, int16_t *x_max)
+{
+    int16_t dx = 0;
+    int16_t dy = 0;
+    int16_t sx = 0;
+    int16_t sy = 0;
+    int16_t err = 0;
+    int16_t e2 = 0;
+
+    /* Check for overflow */
+    x0 = MIN(x0, SSD1306_WIDTH - 1);
+    x1 = MIN(x1, SSD1306_WIDTH - 1);
+    y0 = MIN(y0, SSD1306_HEIGHT - 1);
+    y1 = MIN(y1, SSD1306_HEIGHT - 1);
+
+    dx = (x0 < x1) ? (x1 - x0) : (x0 - x1);
+    dy = (y0 < y1) ? (y1 - y0) : (y0 - y1);
+    sx = (x0 < x1) ? 1 : -1;
+    sy = (y0 < y1) ? 1 : -1;
+    err = ((dx > dy) ? dx : -dy) / 2;
+
+    while(1)
+    {
+        x_min[y0] = MIN(x_min[y0], (int16_t)x0);
+        x_max[y0] = MAX(x_max[y0], (int16_t)x0);
+        if(x0 == x1 && y0 == y1)
+        {
+            break;
+        }
+        e2 = err;
+        if(e2 > -dx)
+        {
+            err -= dy;
+            x0 += sx;
+        }
+        if(e2 < dy)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+
     return;
 }
@@ -48,7 +48,39 @@ extern "C" {
 #define SSD1306_HEIGHT          64
 #endif
 
-#define SSD1306_DRV_MODE        0   //!< Driver mode: 0 - SPI, 1 - I2C
+/** Driver mode: 0 - SPI, 1 - I2C, 2 - virtual panel only, no hardware */
+#ifndef SSD1306_DRV_MODE
+#define SSD1306_DRV_MODE        0
+#endif
+/**
+ * Mirror everything sent to display in virtual panel, see ssd1306_vpanel.h. Costs 1 KB RAM and time of every flush,
+ * so it is off on target unless enabled for debugging. Always on in virtual panel mode.
+ */
+#ifndef SSD1306_VPANEL
+#if SSD1306_DRV_MODE == 2
+#define SSD1306_VPANEL          1
+#else
+#define SSD1306_VPANEL          0
+#endif
+#endif
+#if SSD1306_DRV_MODE == 2 && !SSD1306_VPANEL
+#error "Virtual panel driver mode needs SSD1306_VPANEL"
+#endif
+/** Column offset of the visible area inside controller RAM. */
+#ifndef SSD1306_COLUMN_OFFSET
+#define SSD1306_COLUMN_OFFSET   2
+#endif
+/**
+ * Send changed area as one address window in horizontal addressing mode. SH1106 type controllers with 132 column RAM
+ * (the reason for column offset) support only page addressing, they get address commands per changed page instead.
+ */
+#ifndef SSD1306_HORIZONTAL_ADDRESSING
+#if SSD1306_COLUMN_OFFSET == 0
+#define SSD1306_HORIZONTAL_ADDRESSING   1
+#else
+#define SSD1306_HORIZONTAL_ADDRESSING   0
+#endif
+#endif
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -66,6 +98,18 @@ typedef enum
     SSD1306_COLOR_WHITE = 0x00, /*!< Pixel is set. Color depends on display */
 } ssd1306_color_t;
 
+/**
+ * @brief   SSD1306 frame flush statistics.
+ */
+typedef struct
+{
+    uint32_t count;         //!< Number of flushes since boot.
+    uint32_t errors;        //!< Number of failed or timed out flushes.
+    uint32_t bytes;         //!< Bytes of frame data sent by last flush.
+    uint32_t time_us;       //!< Duration of last flush in microseconds.
+    uint32_t time_max_us;   //!< Longest flush since boot in microseconds.
+} ssd1306_stats_t;
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -110,9 +154,30 @@ void ss1306_orientation_flip_v(void);
  * @brief   Updates buffer from internal RAM to display.
  *
  * @note    This function must be called each time you do some changes to display, to update buffer from RAM to display.
+ *          Only pages and columns changed since previous update are transmitted.
+ *          Changed data is copied to front buffer and sent by DMA in background, so function returns right away and
+ *          next frame can be drawn meanwhile. Completion is signalled to calling thread by thread flag, so display
+ *          must be updated from a single thread.
  */
 void ssd1306_update_screen(void);
 
+/**
+ * @brief   Blocks calling thread until frame flush started by @ref ssd1306_update_screen() is complete.
+ */
+void ssd1306_update_screen_wait(void);
+
+/**
+ * @brief   Get frame flush statistics.
+ *
+ * @param   stats   Pointer to statistics to fill. See @ref ssd1306_stats_t.
+ */
+void ssd1306_get_stats(ssd1306_stats_t *stats);
+
+/**
+ * @brief   Marks whole internal RAM as changed, so next @ref ssd1306_update_screen() sends a full frame.
+ */
+void ssd1306_invalidate(void);
+
 /**
  * @brief   Toggles pixels invertion inside internal RAM.
  *
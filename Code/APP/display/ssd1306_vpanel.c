@@ -0,0 +1,363 @@
+/**
+ **********************************************************************************************************************
+ * @file         ssd1306_vpanel.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Virtual SSD1306 panel.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "display/ssd1306_vpanel.h"
+#include "fmt.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef enum
+{
+    SSD1306_VPANEL_MODE_HORIZONTAL = 0,
+    SSD1306_VPANEL_MODE_VERTICAL = 1,
+    SSD1306_VPANEL_MODE_PAGE = 2,
+} ssd1306_vpanel_mode_t;
+
+typedef struct
+{
+    uint8_t ram[SSD1306_VPANEL_PAGES][SSD1306_VPANEL_COLUMNS];
+    ssd1306_vpanel_mode_t mode;
+    uint8_t page;
+    uint8_t column;
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t column_start;
+    uint8_t column_end;
+    uint8_t command;        //!< Command waiting for arguments.
+    uint8_t args;           //!< Arguments still expected.
+    uint8_t arg;            //!< Index of next argument.
+    bool inverted;
+    bool on;
+    uint8_t contrast;
+    ssd1306_vpanel_stats_t stats;
+} ssd1306_vpanel_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+#if SSD1306_VPANEL
+static ssd1306_vpanel_t ssd1306_vpanel;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static uint8_t ssd1306_vpanel_args(uint8_t command);
+static void ssd1306_vpanel_arg(uint8_t command, uint8_t index, uint8_t value);
+static void ssd1306_vpanel_advance(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void ssd1306_vpanel_reset(void)
+{
+    memset(&ssd1306_vpanel, 0, sizeof(ssd1306_vpanel));
+    ssd1306_vpanel.mode = SSD1306_VPANEL_MODE_PAGE;
+    ssd1306_vpanel.page_end = SSD1306_VPANEL_PAGES - 1;
+    ssd1306_vpanel.column_end = SSD1306_VPANEL_COLUMNS - 1;
+    ssd1306_vpanel.contrast = 0x7F;
+
+    return;
+}
+
+void ssd1306_vpanel_cmd(uint8_t command)
+{
+    ssd1306_vpanel.stats.commands++;
+
+    /* Argument of previous command */
+    if(ssd1306_vpanel.args)
+    {
+        ssd1306_vpanel_arg(ssd1306_vpanel.command, ssd1306_vpanel.arg++, command);
+        ssd1306_vpanel.args--;
+        return;
+    }
+
+    if(command <= 0x0F)
+    {
+        ssd1306_vpanel.column = (ssd1306_vpanel.column & 0xF0) | command;
+    }
+    else if(command <= 0x1F)
+    {
+        ssd1306_vpanel.column = (ssd1306_vpanel.column & 0x0F) | ((command & 0x0F) << 4);
+    }
+    else if(command >= 0xB0 && command <= 0xB7)
+    {
+        ssd1306_vpanel.page = command & 0x07;
+    }
+    else if(command == 0xA6 || command == 0xA7)
+    {
+        ssd1306_vpanel.inverted = command == 0xA7;
+    }
+    else if(command == 0xAE || command == 0xAF)
+    {
+        ssd1306_vpanel.on = command == 0xAF;
+    }
+    else
+    {
+        ssd1306_vpanel.command = command;
+        ssd1306_vpanel.args = ssd1306_vpanel_args(command);
+        ssd1306_vpanel.arg = 0;
+    }
+
+    return;
+}
+
+void ssd1306_vpanel_data(const uint8_t *data, uint32_t size)
+{
+    ssd1306_vpanel.stats.data += size;
+    while(size--)
+    {
+        if(ssd1306_vpanel.column < SSD1306_VPANEL_COLUMNS)
+        {
+            ssd1306_vpanel.ram[ssd1306_vpanel.page][ssd1306_vpanel.column] = *data;
+        }
+        data++;
+        ssd1306_vpanel_advance();
+    }
+
+    return;
+}
+
+bool ssd1306_vpanel_get_pixel(uint16_t x, uint16_t y)
+{
+    bool pixel = false;
+
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        return false;
+    }
+
+    pixel = (ssd1306_vpanel.ram[y / 8][x + SSD1306_COLUMN_OFFSET] >> (y % 8)) & 0x01;
+
+    return pixel != ssd1306_vpanel.inverted;
+}
+
+void ssd1306_vpanel_dump(ssd1306_vpanel_writer_t writer, ssd1306_vpanel_format_t format)
+{
+    uint8_t row[SSD1306_WIDTH + 1];
+    uint16_t x = 0;
+    uint16_t y = 0;
+    int len = 0;
+
+    len = fmt_snprintf((char *)row, sizeof(row), "%s\n%d %d\n%s", format == SSD1306_VPANEL_FORMAT_PGM ? "P5" : "P1",
+                   SSD1306_WIDTH, SSD1306_HEIGHT, format == SSD1306_VPANEL_FORMAT_PGM ? "255\n" : "");
+    writer(row, len);
+
+    for(y = 0; y < SSD1306_HEIGHT; y++)
+    {
+        for(x = 0; x < SSD1306_WIDTH; x++)
+        {
+            if(format == SSD1306_VPANEL_FORMAT_PGM)
+            {
+                row[x] = ssd1306_vpanel_get_pixel(x, y) ? 255 : 0;
+            }
+            else
+            {
+                /* In PBM 1 is black */
+                row[x] = ssd1306_vpanel_get_pixel(x, y) ? '0' : '1';
+            }
+        }
+        if(format == SSD1306_VPANEL_FORMAT_PGM)
+        {
+            writer(row, SSD1306_WIDTH);
+        }
+        else
+        {
+            row[SSD1306_WIDTH] = '\n';
+            writer(row, SSD1306_WIDTH + 1);
+        }
+    }
+
+    return;
+}
+
+uint32_t ssd1306_vpanel_compare(const uint8_t *image, uint32_t size)
+{
+    char header[24] = {0};
+    uint32_t len = 0;
+    uint32_t diff = 0;
+    uint16_t x = 0;
+    uint16_t y = 0;
+    bool pbm = size > 2 && image[1] == '1';
+    uint16_t stride = pbm ? SSD1306_WIDTH + 1 : SSD1306_WIDTH;
+    bool pixel = false;
+
+    len = fmt_snprintf(header, sizeof(header), pbm ? "P1\n%d %d\n" : "P5\n%d %d\n255\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    if(size != len + stride * SSD1306_HEIGHT || memcmp(image, header, len) != 0)
+    {
+        return UINT32_MAX;
+    }
+
+    image += len;
+    for(y = 0; y < SSD1306_HEIGHT; y++)
+    {
+        for(x = 0; x < SSD1306_WIDTH; x++)
+        {
+            /* In PBM 0 is white, lit pixel */
+            pixel = pbm ? image[x] == '0' : image[x] >= 128;
+            if(pixel != ssd1306_vpanel_get_pixel(x, y))
+            {
+                diff++;
+            }
+        }
+        image += stride;
+    }
+
+    return diff;
+}
+
+void ssd1306_vpanel_get_stats(ssd1306_vpanel_stats_t *stats)
+{
+    *stats = ssd1306_vpanel.stats;
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Get number of argument bytes following command.
+ */
+static uint8_t ssd1306_vpanel_args(uint8_t command)
+{
+    switch(command)
+    {
+        case 0x20:  // Memory addressing mode
+        case 0x81:  // Contrast
+        case 0x8D:  // Charge pump
+        case 0xA8:  // Multiplex ratio
+        case 0xD3:  // Display offset
+        case 0xD5:  // Clock divide
+        case 0xD9:  // Pre-charge period
+        case 0xDA:  // COM pins
+        case 0xDB:  // VCOMH
+            return 1;
+        case 0x21:  // Column address
+        case 0x22:  // Page address
+        case 0xA3:  // Vertical scroll area
+            return 2;
+        case 0x29:  // Vertical and horizontal scroll
+        case 0x2A:
+            return 5;
+        case 0x26:  // Horizontal scroll
+        case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void ssd1306_vpanel_arg(uint8_t command, uint8_t index, uint8_t value)
+{
+    switch(command)
+    {
+        case 0x20:
+            ssd1306_vpanel.mode = (ssd1306_vpanel_mode_t)(value & 0x03);
+            break;
+        case 0x21:
+            if(index == 0)
+            {
+                ssd1306_vpanel.column_start = value;
+                ssd1306_vpanel.column = value;
+            }
+            else
+            {
+                ssd1306_vpanel.column_end = value;
+            }
+            break;
+        case 0x22:
+            if(index == 0)
+            {
+                ssd1306_vpanel.page_start = value & 0x07;
+                ssd1306_vpanel.page = value & 0x07;
+            }
+            else
+            {
+                ssd1306_vpanel.page_end = value & 0x07;
+            }
+            break;
+        case 0x81:
+            ssd1306_vpanel.contrast = value;
+            break;
+        default:
+            break;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Move RAM pointer after data byte.
+ */
+static void ssd1306_vpanel_advance(void)
+{
+    switch(ssd1306_vpanel.mode)
+    {
+        case SSD1306_VPANEL_MODE_HORIZONTAL:
+            if(ssd1306_vpanel.column++ >= ssd1306_vpanel.column_end)
+            {
+                ssd1306_vpanel.column = ssd1306_vpanel.column_start;
+                if(ssd1306_vpanel.page++ >= ssd1306_vpanel.page_end)
+                {
+                    ssd1306_vpanel.page = ssd1306_vpanel.page_start;
+                }
+            }
+            break;
+        case SSD1306_VPANEL_MODE_VERTICAL:
+            if(ssd1306_vpanel.page++ >= ssd1306_vpanel.page_end)
+            {
+                ssd1306_vpanel.page = ssd1306_vpanel.page_start;
+                if(ssd1306_vpanel.column++ >= ssd1306_vpanel.column_end)
+                {
+                    ssd1306_vpanel.column = ssd1306_vpanel.column_start;
+                }
+            }
+            break;
+        default:
+            /* Page mode stays on page */
+            if(ssd1306_vpanel.column++ >= ssd1306_vpanel.column_end)
+            {
+                ssd1306_vpanel.column = ssd1306_vpanel.column_start;
+            }
+            break;
+    }
+
+    return;
+}
+#endif // SSD1306_VPANEL
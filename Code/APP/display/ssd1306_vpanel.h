@@ -0,0 +1,136 @@
+/**
+ **********************************************************************************************************************
+ * @file        ssd1306_vpanel.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Virtual SSD1306 panel. Decodes command and data stream sent to display into panel RAM.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SSD1306_VPANEL_H_
+#define SSD1306_VPANEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "display/ssd1306.h"
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define SSD1306_VPANEL_COLUMNS  132 //!< Columns of panel RAM, visible area starts at @ref SSD1306_COLUMN_OFFSET.
+#define SSD1306_VPANEL_PAGES    8   //!< Pages of panel RAM.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Frame dump formats.
+ */
+typedef enum
+{
+    SSD1306_VPANEL_FORMAT_PGM,  //!< Binary PGM (P5), 0 or 255 per pixel.
+    SSD1306_VPANEL_FORMAT_PBM,  //!< ASCII PBM (P1), one text line per row.
+} ssd1306_vpanel_format_t;
+
+/**
+ * @brief   Virtual panel statistics.
+ */
+typedef struct
+{
+    uint32_t commands;  //!< Command bytes received, including arguments.
+    uint32_t data;      //!< Data bytes received.
+} ssd1306_vpanel_stats_t;
+
+/** Receives dumped frame in chunks. */
+typedef void (*ssd1306_vpanel_writer_t)(const uint8_t *data, uint32_t size);
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Reset panel RAM and state to power on defaults.
+ */
+void ssd1306_vpanel_reset(void);
+
+/**
+ * @brief   Feed command byte sent to display.
+ *
+ * @param   command Command or command argument byte.
+ */
+void ssd1306_vpanel_cmd(uint8_t command);
+
+/**
+ * @brief   Feed data bytes sent to display. Bytes are written at RAM pointer, pointer advances by addressing mode.
+ *
+ * @param   data    Data bytes.
+ * @param   size    Number of bytes.
+ */
+void ssd1306_vpanel_data(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief   Get visible pixel as shown on panel, inversion included.
+ *
+ * @param   x   X of pixel.
+ * @param   y   Y of pixel.
+ *
+ * @return  True if pixel is lit.
+ */
+bool ssd1306_vpanel_get_pixel(uint16_t x, uint16_t y);
+
+/**
+ * @brief   Dump visible frame.
+ *
+ * @param   writer  Writer called with header and every row. In PBM format every chunk is one line ending with '\n'.
+ * @param   format  Output format. See @ref ssd1306_vpanel_format_t.
+ */
+void ssd1306_vpanel_dump(ssd1306_vpanel_writer_t writer, ssd1306_vpanel_format_t format);
+
+/**
+ * @brief   Compare visible frame with golden image in one of dump formats.
+ *
+ * @param   image   PGM (P5) image, pixel is lit when value is 128 or more, or PBM (P1) image as written by
+ *                  @ref ssd1306_vpanel_dump.
+ * @param   size    Size of image in bytes.
+ *
+ * @return  Number of different pixels, UINT32_MAX if image is not valid image of panel size.
+ */
+uint32_t ssd1306_vpanel_compare(const uint8_t *image, uint32_t size);
+
+/**
+ * @brief   Get virtual panel statistics.
+ *
+ * @param   stats   Pointer to statistics to fill. See @ref ssd1306_vpanel_stats_t.
+ */
+void ssd1306_vpanel_get_stats(ssd1306_vpanel_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSD1306_VPANEL_H_ */
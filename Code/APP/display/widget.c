@@ -0,0 +1,219 @@
+/**
+ **********************************************************************************************************************
+ * @file         widget.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Retained display widgets.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "display/widget.h"
+#include "display/ssd1306.h"
+#include "fmt.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define WIDGET_GAUGE_MARKER 3   //!< Width of gauge marker in pixels.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void widget_draw(widget_t *widget, int32_t value);
+static void widget_draw_number(widget_t *widget, int32_t value);
+static void widget_draw_bar(widget_t *widget, int32_t value);
+static void widget_draw_gauge(widget_t *widget, int32_t value);
+static int32_t widget_scale(widget_t *widget, int32_t value, int32_t size);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void widget_reset(widget_t *widgets, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        widgets[i].valid = false;
+    }
+
+    return;
+}
+
+bool widget_update(widget_t *widgets, uint32_t count)
+{
+    uint32_t i = 0;
+    int32_t value = 0;
+    bool drawn = false;
+
+    for(i = 0; i < count; i++)
+    {
+        value = widgets[i].get != NULL ? widgets[i].get(widgets[i].arg) : 0;
+        if(widgets[i].valid == true && widgets[i].value == value)
+        {
+            continue;
+        }
+
+        widget_draw(&widgets[i], value);
+        widgets[i].value = value;
+        widgets[i].valid = true;
+        drawn = true;
+    }
+
+    return drawn;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void widget_draw(widget_t *widget, int32_t value)
+{
+    switch(widget->type)
+    {
+        case WIDGET_TYPE_LABEL:
+            ssd1306_goto_xy(widget->x, widget->y);
+            ssd1306_puts((uint8_t *)widget->text, widget->font, SSD1306_COLOR_WHITE);
+            break;
+        case WIDGET_TYPE_NUMBER:
+            widget_draw_number(widget, value);
+            break;
+        case WIDGET_TYPE_BAR:
+            widget_draw_bar(widget, value);
+            break;
+        case WIDGET_TYPE_GAUGE:
+            widget_draw_gauge(widget, value);
+            break;
+        default:
+            break;
+    }
+
+    return;
+}
+
+static void widget_draw_number(widget_t *widget, int32_t value)
+{
+    char text[WIDGET_TEXT_MAX + 1] = {0};
+    char line[WIDGET_TEXT_MAX + 1] = {0};
+    uint32_t len = 0;
+    uint32_t chars = widget->chars > WIDGET_TEXT_MAX ? WIDGET_TEXT_MAX : widget->chars;
+    uint32_t pad = 0;
+
+    if(widget->format != NULL)
+    {
+        widget->format(text, sizeof(text), value);
+    }
+    else
+    {
+        fmt_snprintf(text, sizeof(text), "%s%d%s", widget->text != NULL ? widget->text : "", (int)value,
+                     widget->suffix != NULL ? widget->suffix : "");
+    }
+
+    /* Pad to fixed width, so longer previous value is erased */
+    len = strlen(text);
+    len = len > chars ? chars : len;
+    memset(line, ' ', chars);
+    switch(widget->align)
+    {
+        case WIDGET_ALIGN_RIGHT:
+            pad = chars - len;
+            break;
+        case WIDGET_ALIGN_CENTER:
+            pad = (chars - len) / 2;
+            break;
+        default:
+            break;
+    }
+    memcpy(&line[pad], text, len);
+
+    ssd1306_goto_xy(widget->x, widget->y);
+    ssd1306_puts((uint8_t *)line, widget->font, SSD1306_COLOR_WHITE);
+
+    return;
+}
+
+static void widget_draw_bar(widget_t *widget, int32_t value)
+{
+    int32_t fill = widget_scale(widget, value, widget->w - 2);
+
+    ssd1306_draw_rectangle(widget->x, widget->y, widget->w - 1, widget->h - 1, SSD1306_COLOR_WHITE);
+    if(fill > 0)
+    {
+        ssd1306_draw_filled_rectangle(widget->x + 1, widget->y + 1, fill - 1, widget->h - 3, SSD1306_COLOR_WHITE);
+    }
+    if(fill < widget->w - 2)
+    {
+        ssd1306_draw_filled_rectangle(widget->x + 1 + fill, widget->y + 1, widget->w - 3 - fill, widget->h - 3,
+                                      SSD1306_COLOR_BLACK);
+    }
+
+    return;
+}
+
+static void widget_draw_gauge(widget_t *widget, int32_t value)
+{
+    int32_t pos = widget_scale(widget, value, widget->w - WIDGET_GAUGE_MARKER);
+    uint8_t bottom = widget->y + widget->h - 1;
+
+    /* Scale with end and center ticks */
+    ssd1306_draw_filled_rectangle(widget->x, widget->y, widget->w - 1, widget->h - 2, SSD1306_COLOR_BLACK);
+    ssd1306_draw_line(widget->x, bottom, widget->x + widget->w - 1, bottom, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(widget->x, bottom - 2, widget->x, bottom, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(widget->x + widget->w / 2, bottom - 2, widget->x + widget->w / 2, bottom, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(widget->x + widget->w - 1, bottom - 2, widget->x + widget->w - 1, bottom, SSD1306_COLOR_WHITE);
+
+    /* Marker */
+    ssd1306_draw_filled_rectangle(widget->x + pos, widget->y, WIDGET_GAUGE_MARKER - 1, widget->h - 3,
+                                  SSD1306_COLOR_WHITE);
+
+    return;
+}
+
+/**
+ * @brief   Scale value from widget range to 0..size.
+ */
+static int32_t widget_scale(widget_t *widget, int32_t value, int32_t size)
+{
+    if(widget->max <= widget->min || value <= widget->min)
+    {
+        return 0;
+    }
+    if(value >= widget->max)
+    {
+        return size;
+    }
+
+    return (int32_t)(((int64_t)(value - widget->min) * size) / (widget->max - widget->min));
+}
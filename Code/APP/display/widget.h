@@ -0,0 +1,128 @@
+/**
+ **********************************************************************************************************************
+ * @file        widget.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Retained display widgets. Widgets remember last drawn value and redraw only when it changes.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef WIDGET_H_
+#define WIDGET_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "display/fonts.h"
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define WIDGET_TEXT_MAX     24  //!< Longest text of label or number widget.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/** Set widgets and count fields of structure from widget array. */
+#define WIDGET_LIST(list)   .widgets = (list), .count = sizeof(list) / sizeof((list)[0])
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Widget types.
+ */
+typedef enum
+{
+    WIDGET_TYPE_LABEL,  //!< Static text, drawn once.
+    WIDGET_TYPE_NUMBER, //!< Decimal value between prefix and suffix, padded to fixed number of characters.
+    WIDGET_TYPE_BAR,    //!< Horizontal bar filled from left in proportion to value.
+    WIDGET_TYPE_GAUGE,  //!< Horizontal scale with marker at value, center tick shows middle of range.
+} widget_type_t;
+
+/**
+ * @brief   Text alignment inside number widget.
+ */
+typedef enum
+{
+    WIDGET_ALIGN_LEFT,
+    WIDGET_ALIGN_RIGHT,
+    WIDGET_ALIGN_CENTER,
+} widget_align_t;
+
+/** Get value of widget, arg is taken from widget. */
+typedef int32_t (*widget_get_t)(uint32_t arg);
+/** Format value of number widget to text. */
+typedef void (*widget_format_t)(char *buffer, uint32_t size, int32_t value);
+
+/**
+ * @brief   Widget description and state.
+ */
+typedef struct
+{
+    widget_type_t type;     //!< Widget type.
+    uint8_t x;              //!< X of top left corner.
+    uint8_t y;              //!< Y of top left corner.
+    uint8_t w;              //!< Width of bar and gauge. Number width is chars times font width.
+    uint8_t h;              //!< Height of bar and gauge. Text height is font height.
+    fonts_t *font;          //!< Font of label and number.
+    const char *text;       //!< Label text or text before number. Can be NULL for number.
+    const char *suffix;     //!< Text after number. Can be NULL.
+    widget_format_t format; //!< Custom number formatting, used instead of text when set.
+    widget_align_t align;   //!< Number alignment.
+    uint8_t chars;          //!< Number width in characters, shorter text is padded with spaces.
+    widget_get_t get;       //!< Value getter.
+    uint32_t arg;           //!< Argument of getter.
+    int32_t min;            //!< Lowest value of bar and gauge.
+    int32_t max;            //!< Highest value of bar and gauge.
+    int32_t value;          //!< Last drawn value.
+    bool valid;             //!< Widget is drawn and value is valid.
+} widget_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Forget drawn state of widgets, so next @ref widget_update() draws all of them. Call when screen is cleared.
+ *
+ * @param   widgets Array of widgets.
+ * @param   count   Number of widgets.
+ */
+void widget_reset(widget_t *widgets, uint32_t count);
+
+/**
+ * @brief   Redraw widgets whose value changed since last draw. Only redrawn widgets change frame buffer.
+ *
+ * @param   widgets Array of widgets.
+ * @param   count   Number of widgets.
+ *
+ * @return  True if anything was drawn and screen needs update.
+ */
+bool widget_update(widget_t *widgets, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WIDGET_H_ */
@@ -0,0 +1,331 @@
+/**
+ **********************************************************************************************************************
+ * @file         i2c_sched.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        I2C bus scheduler for periodic and one-shot transfers.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "cmsis_os2.h"
+
+#include "i2c_sched.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** I2C scheduler thread attributes. */
+const osThreadAttr_t i2c_sched_thread_attr =
+{
+    .name = "I2C",
+    .stack_size = 512,
+    .priority = osPriorityAboveNormal,
+};
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Thread flag set when job is queued. */
+#define I2C_SCHED_FLAG_QUEUE    0x0001U
+/** Thread flag set to waiter of one-shot job. */
+#define I2C_SCHED_FLAG_DONE     0x4000U
+/** Thread flag set to thread removing job that was running. */
+#define I2C_SCHED_FLAG_REMOVED  0x8000U
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/* Scheduler thread ID */
+static osThreadId_t i2c_sched_thread_id = NULL;
+/* Queue lock */
+static osMutexId_t i2c_sched_lock_id = NULL;
+/* Queued jobs */
+static i2c_sched_job_t *i2c_sched_jobs = NULL;
+/* Job being run by scheduler thread and thread waiting for it to be removed */
+static i2c_sched_job_t *i2c_sched_running = NULL;
+static osThreadId_t i2c_sched_remover = NULL;
+/* Bus statistics */
+static i2c_sched_stats_t i2c_sched_stats;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void i2c_sched_thread(void *arguments);
+static i2c_sched_job_t *i2c_sched_next(uint32_t *wait);
+static void i2c_sched_run(i2c_sched_job_t *job, uint32_t release);
+static void i2c_sched_unlink(i2c_sched_job_t *job);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool i2c_sched_init(void)
+{
+    if((i2c_sched_lock_id = osMutexNew(NULL)) == NULL)
+    {
+        return false;
+    }
+
+    if((i2c_sched_thread_id = osThreadNew(&i2c_sched_thread, NULL, &i2c_sched_thread_attr)) == NULL)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool i2c_sched_add(i2c_sched_job_t *job, uint32_t delay)
+{
+    if(i2c_sched_thread_id == NULL)
+    {
+        return false;
+    }
+
+    osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+    i2c_sched_unlink(job);
+    job->release = osKernelGetTickCount() + delay;
+    job->next = i2c_sched_jobs;
+    i2c_sched_jobs = job;
+    osMutexRelease(i2c_sched_lock_id);
+    osThreadFlagsSet(i2c_sched_thread_id, I2C_SCHED_FLAG_QUEUE);
+
+    return true;
+}
+
+void i2c_sched_remove(i2c_sched_job_t *job)
+{
+    bool running = false;
+
+    if(i2c_sched_thread_id == NULL)
+    {
+        return;
+    }
+
+    osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+    i2c_sched_unlink(job);
+    /* Scheduler uses running job until its callback returns, callback itself may remove it right away */
+    running = job == i2c_sched_running && osThreadGetId() != i2c_sched_thread_id;
+    if(running)
+    {
+        i2c_sched_remover = osThreadGetId();
+        osThreadFlagsClear(I2C_SCHED_FLAG_REMOVED);
+    }
+    osMutexRelease(i2c_sched_lock_id);
+
+    if(running)
+    {
+        /* Transfer itself has timeout, job always completes */
+        osThreadFlagsWait(I2C_SCHED_FLAG_REMOVED, osFlagsWaitAny, osWaitForever);
+    }
+
+    return;
+}
+
+i2c_status_t i2c_sched_xfer(const i2c_xfer_t *xfer, uint8_t priority)
+{
+    i2c_sched_job_t job = {0};
+
+    if(i2c_sched_thread_id == NULL || osThreadGetId() == i2c_sched_thread_id)
+    {
+        i2c_xfer(xfer, I2C_TIMEOUT);
+        return i2c_get_status();
+    }
+
+    job.xfer = *xfer;
+    job.priority = priority;
+    job.waiter = osThreadGetId();
+    osThreadFlagsClear(I2C_SCHED_FLAG_DONE);
+    i2c_sched_add(&job, 0);
+    /* Transfer itself has timeout, job always completes */
+    osThreadFlagsWait(I2C_SCHED_FLAG_DONE, osFlagsWaitAny, osWaitForever);
+
+    return job.status;
+}
+
+void i2c_sched_get_stats(i2c_sched_stats_t *stats)
+{
+    /* Statistics are updated by scheduler thread under queue lock, 64 bit busy time is not copied atomically */
+    osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+    *stats = i2c_sched_stats;
+    osMutexRelease(i2c_sched_lock_id);
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void i2c_sched_thread(void *arguments)
+{
+    i2c_sched_job_t *job = NULL;
+    osThreadId_t remover = NULL;
+    uint32_t release = 0;
+    uint32_t wait = 0;
+
+    while(1)
+    {
+        osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+        job = i2c_sched_next(&wait);
+        if(job != NULL)
+        {
+            release = job->release;
+            if(job->period == 0)
+            {
+                i2c_sched_unlink(job);
+            }
+            else
+            {
+                /* Keep period phase, skip releases missed due to overrun */
+                job->release += job->period;
+                if((int32_t)(job->release - osKernelGetTickCount()) < 0)
+                {
+                    job->release = osKernelGetTickCount() + job->period;
+                }
+            }
+        }
+        i2c_sched_running = job;
+        osMutexRelease(i2c_sched_lock_id);
+
+        if(job == NULL)
+        {
+            osThreadFlagsWait(I2C_SCHED_FLAG_QUEUE, osFlagsWaitAny, wait);
+            continue;
+        }
+        /* Ready jobs are run back to back, next one is picked right after this one completes */
+        i2c_sched_run(job, release);
+
+        osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+        i2c_sched_running = NULL;
+        remover = i2c_sched_remover;
+        i2c_sched_remover = NULL;
+        osMutexRelease(i2c_sched_lock_id);
+        if(remover != NULL)
+        {
+            osThreadFlagsSet(remover, I2C_SCHED_FLAG_REMOVED);
+        }
+    }
+}
+
+/**
+ * @brief   Pick ready job with highest priority, earliest deadline among equal priorities. Queue must be locked.
+ *
+ * @param   wait    Time in ms until next job is due when none is ready, osWaitForever if queue is empty.
+ *
+ * @return  Job to run or NULL if none is ready.
+ */
+static i2c_sched_job_t *i2c_sched_next(uint32_t *wait)
+{
+    i2c_sched_job_t *job = NULL;
+    i2c_sched_job_t *best = NULL;
+    uint32_t now = osKernelGetTickCount();
+    int32_t due = 0;
+
+    *wait = osWaitForever;
+    for(job = i2c_sched_jobs; job != NULL; job = job->next)
+    {
+        due = (int32_t)(job->release - now);
+        if(due > 0)
+        {
+            *wait = (uint32_t)due < *wait ? (uint32_t)due : *wait;
+            continue;
+        }
+        if(best == NULL || job->priority > best->priority || (job->priority == best->priority &&
+            (int32_t)((job->release + job->deadline) - (best->release + best->deadline)) < 0))
+        {
+            best = job;
+        }
+    }
+
+    return best;
+}
+
+static void i2c_sched_run(i2c_sched_job_t *job, uint32_t release)
+{
+    uint32_t start = osKernelGetSysTimerCount();
+    uint32_t latency = 0;
+    bool missed = osKernelGetTickCount() - release > job->deadline;
+    osThreadId_t waiter = job->waiter;
+
+    job->ok = i2c_xfer(&job->xfer, I2C_TIMEOUT);
+    job->status = i2c_get_status();
+    job->time = osKernelGetTickCount();
+
+    osMutexAcquire(i2c_sched_lock_id, osWaitForever);
+    if(missed)
+    {
+        i2c_sched_stats.misses++;
+    }
+    i2c_sched_stats.busy_us += (osKernelGetSysTimerCount() - start) / (osKernelGetSysTimerFreq() / 1000000);
+    i2c_sched_stats.count++;
+    if(job->status == I2C_STATUS_NACK)
+    {
+        i2c_sched_stats.nacks++;
+    }
+    else if(job->status == I2C_STATUS_TIMEOUT)
+    {
+        i2c_sched_stats.timeouts++;
+    }
+    else if(job->status != I2C_STATUS_OK)
+    {
+        i2c_sched_stats.errors++;
+    }
+    latency = job->time - release;
+    if(latency > i2c_sched_stats.latency_max_ms)
+    {
+        i2c_sched_stats.latency_max_ms = latency;
+    }
+    osMutexRelease(i2c_sched_lock_id);
+
+    if(job->cb != NULL)
+    {
+        job->cb(job);
+    }
+    /* One-shot job may be gone once waiter runs */
+    if(waiter != NULL)
+    {
+        osThreadFlagsSet(waiter, I2C_SCHED_FLAG_DONE);
+    }
+
+    return;
+}
+
+static void i2c_sched_unlink(i2c_sched_job_t *job)
+{
+    i2c_sched_job_t **link = &i2c_sched_jobs;
+
+    while(*link != NULL)
+    {
+        if(*link == job)
+        {
+            *link = job->next;
+            job->next = NULL;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    return;
+}
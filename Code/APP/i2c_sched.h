@@ -0,0 +1,145 @@
+/**
+ **********************************************************************************************************************
+ * @file        i2c_sched.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       I2C bus scheduler for periodic and one-shot transfers.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef I2C_SCHED_H_
+#define I2C_SCHED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+#include "periph/i2c.h"
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+typedef struct i2c_sched_job_s i2c_sched_job_t;
+
+/**
+ * @brief   Job result callback. Called from scheduler thread right after transfer.
+ *
+ * @param   job     Completed job, result is in ok, status and time fields.
+ */
+typedef void (*i2c_sched_cb_t)(i2c_sched_job_t *job);
+
+/**
+ * @brief   Scheduled I2C job. Owned by caller and must stay valid while queued.
+ */
+struct i2c_sched_job_s
+{
+    i2c_xfer_t xfer;        //!< Transfer to run.
+    uint32_t period;        //!< Period in ms, 0 for one-shot job.
+    uint32_t deadline;      //!< Allowed delay from release to start in ms, orders jobs of same priority.
+    uint8_t priority;       //!< Jobs with higher value run first.
+    i2c_sched_cb_t cb;      //!< Result callback. Can be NULL.
+    void *arg;              //!< Callback argument.
+    /* Filled by scheduler */
+    bool ok;                //!< Last transfer succeeded.
+    i2c_status_t status;    //!< Status of last transfer.
+    uint32_t time;          //!< Kernel tick when last transfer completed.
+    uint32_t release;       //!< Kernel tick when job is due next.
+    osThreadId_t waiter;    //!< Thread waiting for one-shot job, NULL if none.
+    i2c_sched_job_t *next;  //!< Next queued job.
+};
+
+/**
+ * @brief   Bus statistics.
+ */
+typedef struct
+{
+    uint32_t count;             //!< Number of transfers.
+    uint32_t nacks;             //!< Transfers not acknowledged by slave.
+    uint32_t timeouts;          //!< Transfers aborted on timeout.
+    uint32_t errors;            //!< Transfers failed with bus error.
+    uint32_t misses;            //!< Jobs started after their deadline.
+    uint32_t latency_max_ms;    //!< Worst time from release to completion in ms.
+    uint64_t busy_us;           //!< Total time bus was busy in us.
+} i2c_sched_stats_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize scheduler and start its thread. From now on scheduler owns I2C-0 bus.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool i2c_sched_init(void);
+
+/**
+ * @brief   Queue job. Periodic jobs stay queued until removed, one-shot jobs leave queue when done.
+ *
+ * @param   job     Job to queue, see @ref i2c_sched_job_s.
+ * @param   delay   Delay of first release in ms.
+ *
+ * @return  True if job was queued.
+ */
+bool i2c_sched_add(i2c_sched_job_t *job, uint32_t delay);
+
+/**
+ * @brief   Remove job from queue. If scheduler is running the job, waits until its callback returns, so job can be
+ *          freed or reused afterwards. Called from job callback, returns right away.
+ *
+ * @param   job     Job to remove.
+ */
+void i2c_sched_remove(i2c_sched_job_t *job);
+
+/**
+ * @brief   Run one-shot transfer and wait for it. Falls back to direct transfer before scheduler is started.
+ *
+ * @param   xfer        Transfer to run.
+ * @param   priority    Job priority.
+ *
+ * @return  Status of transfer. See @ref i2c_status_t.
+ */
+i2c_status_t i2c_sched_xfer(const i2c_xfer_t *xfer, uint8_t priority);
+
+/**
+ * @brief   Get bus statistics.
+ *
+ * @param   stats   Pointer to structure where statistics will be copied.
+ */
+void i2c_sched_get_stats(i2c_sched_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_SCHED_H_ */
@@ -22,10 +22,14 @@
  *********************************************************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "motor/motor.h"
 #include "motor/vhn2sp30.h"
 #include "sensors/filters.h"
+#include "periph/pwm.h"
+#include "common.h"
+#include "chip.h"
 #include "cmsis_os2.h"
 #include "debug.h"
 
@@ -36,10 +40,20 @@
 const osThreadAttr_t motor_thread_attr =
 {
     .name = "MOTOR",
-    .stack_size = 256,
-    .priority = osPriorityNormal,
+    .stack_size = 512,
+    .priority = osPriorityAboveNormal,
 };
 
+#define MOTOR_CS_FRAC       4       //!< Fraction bits of filtered current.
+#define MOTOR_PERIOD        (1000 / PWM_2_RATE) //!< Control period in ms, one current sample per PWM period.
+#define MOTOR_EXEC_AVG      4       //!< Execution time average weight, 1 / 2^x.
+#define MOTOR_STALE_MAX     2       //!< Periods duty is held without new current sample before drive goes neutral.
+/* Starting values for 12 V supply and about 2 Ohm winding, tune on hardware */
+#define MOTOR_CURRENT_KP    8192    //!< 2 duty steps per mA.
+#define MOTOR_CURRENT_KI    819     //!< Integral time of about 10 control periods.
+#define MOTOR_CURRENT_FF    22370   //!< 2 Ohm * 1 mA / 12 V of full duty.
+#define MOTOR_CURRENT_LIMIT 3000    //!< Current limit in mA.
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
@@ -50,19 +64,49 @@ const osThreadAttr_t motor_thread_attr =
 typedef struct
 {
     vhn2sp30_t drive;
+    volatile motor_mode_t mode;     //!< Requested mode.
+    motor_mode_t applied;           //!< Mode control loop ran last period.
+    int8_t dir;                     //!< Direction bridge was driven last period.
+    bool zeroed;                    //!< Current sense zero calibration passed, bridge may be enabled.
+    uint32_t samples;               //!< Current sense conversion count seen last period.
+    uint8_t stale;                  //!< Periods in row without new current sample.
     struct
     {
         int16_t target;
         int16_t current;
+        uint16_t time;              //!< Time since last ramp step in ms.
     } speed;
+    int16_t torque;                 //!< Target current in mA for @ref MOTOR_MODE_CURRENT.
     uint16_t current;
-    filters_low_pass_t cs_filter;
+    int16_t duty;                   //!< Applied duty in permille.
+    filters_low_pass_q_t cs_filter;
+    motor_pi_cfg_t pi;
+    motor_pi_cfg_t pi_pending;      //!< Parameters set by other threads, protected by @ref motor_pi_lock_id.
+    volatile bool pi_update;        //!< New parameters waiting in pi_pending.
+    int32_t integral;               //!< PI integrator, duty with @ref MOTOR_PI_FRAC fraction bits.
 } motor_data_t;
 
+/**
+ * @brief   Loop statistics in core clock cycles.
+ */
+typedef struct
+{
+    uint32_t loops;
+    uint32_t overruns;
+    uint32_t stale;
+    uint32_t faults;
+    uint32_t jitter_max;
+    uint32_t exec_avg;
+    uint32_t exec_max;
+} motor_cycles_t;
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 osThreadId_t motor_thread_id;
+static osMutexId_t motor_pi_lock_id;
+static motor_cycles_t motor_cycles = {0};
+static volatile bool motor_cycles_reset = false;
 
 /**********************************************************************************************************************
  * Exported variables
@@ -79,12 +123,22 @@ motor_data_t motor_data[MOTOR_ID_LAST] =
             .pwm = PWM_ID_MOTOR_LEFT,
             .cs = ADC_ID_MOTOR_LEFT_CURR,
         },
+        .mode = MOTOR_MODE_NEUTRAL,
+        .applied = MOTOR_MODE_LAST,
         .speed =
         {
             .target = 0,
             .current = 0,
         },
         .current = 0,
+        .cs_filter = {.cut_off = FILTERS_Q15(0.4)},
+        .pi =
+        {
+            .kp = MOTOR_CURRENT_KP,
+            .ki = MOTOR_CURRENT_KI,
+            .ff = MOTOR_CURRENT_FF,
+            .limit = MOTOR_CURRENT_LIMIT,
+        },
     },
     // MOTOR_ID_RIGHT
     {
@@ -96,12 +150,22 @@ motor_data_t motor_data[MOTOR_ID_LAST] =
             .pwm = PWM_ID_MOTOR_RIGHT,
             .cs = ADC_ID_MOTOR_RIGHT_CURR
         },
+        .mode = MOTOR_MODE_NEUTRAL,
+        .applied = MOTOR_MODE_LAST,
         .speed =
         {
             .target = 0,
             .current = 0,
         },
         .current = 0,
+        .cs_filter = {.cut_off = FILTERS_Q15(0.4)},
+        .pi =
+        {
+            .kp = MOTOR_CURRENT_KP,
+            .ki = MOTOR_CURRENT_KI,
+            .ff = MOTOR_CURRENT_FF,
+            .limit = MOTOR_CURRENT_LIMIT,
+        },
     },
 };
 
@@ -110,6 +174,11 @@ uint8_t motor_ramp = 0;
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static void motor_control(motor_data_t *motor);
+static void motor_pi_update(motor_data_t *motor);
+static void motor_ramp_step(motor_data_t *motor);
+static int32_t motor_pi(motor_data_t *motor, int32_t error, int32_t ff, int32_t max);
+static void motor_stats_update(uint32_t period, uint32_t exec);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -120,10 +189,18 @@ bool motor_init()
 
     for(i = 0; i < MOTOR_ID_LAST; i++)
     {
-        vhn2sp30_init(&motor_data[MOTOR_ID_LEFT].drive);
-        vhn2sp30_init(&motor_data[MOTOR_ID_RIGHT].drive);
+        vhn2sp30_init(&motor_data[i].drive);
+    }
+
+    if((motor_pi_lock_id = osMutexNew(NULL)) == NULL)
+    {
+        return false;
     }
-    
+
+    /* Cycle counter measures loop jitter and execution time */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     if((motor_thread_id = osThreadNew(motor_thread, NULL, &motor_thread_attr)) == NULL)
     {
         return false;
@@ -134,48 +211,42 @@ bool motor_init()
 
 void motor_thread(void *arguments)
 {
+    uint32_t tick = 0;
+    uint32_t start = 0;
+    uint32_t last = 0;
     uint8_t i = 0;
 
-    while(1)
+    /* Drives are off after init, current sense outputs only their offset */
+    for(i = 0; i < MOTOR_ID_LAST; i++)
     {
-        if(motor_ramp > 0)
+        /* Without offset current reads wrong and limit does not hold, such motor stays in neutral */
+        if((motor_data[i].zeroed = vhn2sp30_io_cs_zero(&motor_data[i].drive)) == false)
         {
-            for(i = 0; i < MOTOR_ID_LAST; i++)
-            {
-                motor_data[i].current = vhn2sp30_io_cs(&motor_data[i].drive);
-                filter_low_pass(&motor_data[i].cs_filter, motor_data[i].current, 0.4);
+            DEBUG("Motor %u current sense zero calibration failed, drive disabled.", i);
+        }
+        motor_data[i].samples = vhn2sp30_io_cs_samples(&motor_data[i].drive);
+    }
 
-                if(motor_data[i].speed.target > motor_data[i].speed.current)
-                {
-                    motor_data[i].speed.current++;
-                }
-                else if(motor_data[i].speed.target < motor_data[i].speed.current)
-                {
-                    motor_data[i].speed.current--;
-                }
-                else
-                {
-                    continue;
-                }
-                if(motor_data[i].speed.current > 0)
-                {
-                    vhn2sp30_run_cw(&motor_data[i].drive, motor_data[i].speed.current);
-                }
-                else if (motor_data[i].speed.current < 0)
-                {
-                    vhn2sp30_run_ccw(&motor_data[i].drive, motor_data[i].speed.current * (-1));
-                }
-                else
-                {
-                    vhn2sp30_neutral(&motor_data[i].drive);
-                }
-            }
-            osDelay(motor_ramp);
+    tick = osKernelGetTickCount();
+    last = DWT->CYCCNT;
+    while(1)
+    {
+        tick += MOTOR_PERIOD;
+        if((int32_t)(tick - osKernelGetTickCount()) <= 0)
+        {
+            /* Fell behind, do not try to catch up */
+            motor_cycles.overruns++;
+            tick = osKernelGetTickCount() + MOTOR_PERIOD;
         }
-        else
+        osDelayUntil(tick);
+
+        start = DWT->CYCCNT;
+        for(i = 0; i < MOTOR_ID_LAST; i++)
         {
-            osDelay(100);
+            motor_control(&motor_data[i]);
         }
+        motor_stats_update(start - last, DWT->CYCCNT - start);
+        last = start;
     }
 }
 
@@ -188,36 +259,16 @@ void motor_ramp_set(uint16_t ramp)
 
 void motor_forward(motor_id_t motor, uint8_t speed)
 {
-    speed = speed > 100 ? 100 : speed;
-
-    if(motor_ramp == 0)
-    {
-        motor_data[motor].speed.target = speed;
-        motor_data[motor].speed.current = speed;
-        vhn2sp30_run_cw(&motor_data[motor].drive, speed);
-    }
-    else
-    {
-        motor_data[motor].speed.target = speed;
-    }
+    motor_data[motor].speed.target = speed > 100 ? 100 : speed;
+    motor_data[motor].mode = MOTOR_MODE_SPEED;
 
     return;
 }
 
 void motor_backward(motor_id_t motor, uint8_t speed)
 {
-    speed = speed > 100 ? 100 : speed;
-
-    if(motor_ramp == 0)
-    {
-        motor_data[motor].speed.target = speed;
-        motor_data[motor].speed.current = speed;
-        vhn2sp30_run_ccw(&motor_data[motor].drive, speed);
-    }
-    else
-    {
-        motor_data[motor].speed.target = speed * (-1);
-    }
+    motor_data[motor].speed.target = (speed > 100 ? 100 : speed) * (-1);
+    motor_data[motor].mode = MOTOR_MODE_SPEED;
 
     return;
 }
@@ -225,8 +276,7 @@ void motor_backward(motor_id_t motor, uint8_t speed)
 void motor_brake(motor_id_t motor)
 {
     motor_data[motor].speed.target = 0;
-    motor_data[motor].speed.current = 0;
-    vhn2sp30_brake_vcc(&motor_data[motor].drive);
+    motor_data[motor].mode = MOTOR_MODE_BRAKE;
 
     return;
 }
@@ -234,8 +284,7 @@ void motor_brake(motor_id_t motor)
 void motor_neutral(motor_id_t motor)
 {
     motor_data[motor].speed.target = 0;
-    motor_data[motor].speed.current = 0;
-    vhn2sp30_brake_gnd(&motor_data[motor].drive);
+    motor_data[motor].mode = MOTOR_MODE_NEUTRAL;
 
     return;
 }
@@ -306,6 +355,61 @@ void motor_test_ramp(motor_id_t motor, uint8_t ramp)
     return;
 }
 
+void motor_set_current(motor_id_t motor, int16_t current)
+{
+    motor_data[motor].torque = current;
+    motor_data[motor].mode = MOTOR_MODE_CURRENT;
+
+    return;
+}
+
+void motor_set_pi(motor_id_t motor, const motor_pi_cfg_t *cfg)
+{
+    /* Control loop takes parameters over on its next period */
+    osMutexAcquire(motor_pi_lock_id, osWaitForever);
+    motor_data[motor].pi_pending = *cfg;
+    motor_data[motor].pi_update = true;
+    osMutexRelease(motor_pi_lock_id);
+
+    return;
+}
+
+void motor_get_pi(motor_id_t motor, motor_pi_cfg_t *cfg)
+{
+    osMutexAcquire(motor_pi_lock_id, osWaitForever);
+    *cfg = motor_data[motor].pi_update ? motor_data[motor].pi_pending : motor_data[motor].pi;
+    osMutexRelease(motor_pi_lock_id);
+
+    return;
+}
+
+void motor_get_stats(motor_stats_t *stats)
+{
+    uint32_t us = SystemCoreClock / 1000000;
+
+    stats->loops = motor_cycles.loops;
+    stats->overruns = motor_cycles.overruns;
+    stats->stale = motor_cycles.stale;
+    stats->faults = motor_cycles.faults;
+    stats->jitter_max = motor_cycles.jitter_max / us;
+    stats->exec_avg = (motor_cycles.exec_avg >> MOTOR_EXEC_AVG) / us;
+    stats->exec_max = motor_cycles.exec_max / us;
+
+    return;
+}
+
+void motor_reset_stats(void)
+{
+    motor_cycles_reset = true;
+
+    return;
+}
+
+motor_mode_t motor_get_mode(motor_id_t motor)
+{
+    return motor_data[motor].mode;
+}
+
 int16_t motor_get_speed_target(motor_id_t motor)
 {
     return motor_data[motor].speed.target;
@@ -318,9 +422,237 @@ int16_t motor_get_speed_current(motor_id_t motor)
 
 uint16_t motor_get_current(motor_id_t motor)
 {
-    return (uint16_t)motor_data[motor].cs_filter.output;
+    return (uint16_t)(motor_data[motor].cs_filter.output >> MOTOR_CS_FRAC);
+}
+
+int16_t motor_get_current_target(motor_id_t motor)
+{
+    return motor_data[motor].torque;
+}
+
+int16_t motor_get_duty(motor_id_t motor)
+{
+    return motor_data[motor].duty;
+}
+
+uint32_t motor_get_samples(motor_id_t motor)
+{
+    return vhn2sp30_io_cs_samples(&motor_data[motor].drive);
 }
 
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+/**
+ * @brief   Run single control period of motor: filter phase-locked current sample, then set bridge and duty from
+ *          requested mode. Bridge is enabled only while current sense is calibrated and samples arrive. Sample
+ *          late by up to @ref MOTOR_STALE_MAX periods keeps duty of last period, loop does not run on old current.
+ */
+static void motor_control(motor_data_t *motor)
+{
+    motor_mode_t mode = motor->mode;
+    uint32_t samples = vhn2sp30_io_cs_samples(&motor->drive);
+    bool fresh = samples != motor->samples;
+    int32_t current = 0;
+    int32_t target = 0;
+    int32_t duty = 0;
+    int8_t dir = 0;
+
+    motor->samples = samples;
+    motor->stale = fresh ? 0 : (uint8_t)MIN(motor->stale + 1, UINT8_MAX);
+    if(fresh == true)
+    {
+        motor->current = vhn2sp30_io_cs(&motor->drive);
+        filter_low_pass_q(&motor->cs_filter, (q31_t)motor->current << MOTOR_CS_FRAC);
+    }
+    else if(motor->dir != 0 && mode == motor->applied && motor->stale <= MOTOR_STALE_MAX)
+    {
+        /* Sample slipped past period start, hold bridge and integrator until it arrives */
+        motor_cycles.stale++;
+        return;
+    }
+    current = motor->cs_filter.output >> MOTOR_CS_FRAC;
+
+    motor_pi_update(motor);
+    if(mode != motor->applied)
+    {
+        motor->integral = 0;
+    }
+
+    switch(mode)
+    {
+        case MOTOR_MODE_SPEED:
+            motor_ramp_step(motor);
+            dir = motor->speed.current > 0 ? 1 : (motor->speed.current < 0 ? -1 : 0);
+            /* Open loop duty, PI can only take duty away while current is above limit */
+            duty = (dir * motor->speed.current * VHN2SP30_DUTY_FULL) / 100;
+            duty = motor_pi(motor, (int32_t)motor->pi.limit - current, duty, duty);
+            break;
+        case MOTOR_MODE_CURRENT:
+            dir = motor->torque > 0 ? 1 : (motor->torque < 0 ? -1 : 0);
+            if(dir != motor->dir)
+            {
+                /* Integrator holds duty of previous direction */
+                motor->integral = 0;
+            }
+            target = MIN(dir * motor->torque, (int32_t)motor->pi.limit);
+            duty = motor_pi(motor, target - current, (target * motor->pi.ff) >> MOTOR_PI_FRAC, VHN2SP30_DUTY_FULL);
+            break;
+        case MOTOR_MODE_BRAKE:
+            if(motor->applied != mode)
+            {
+                motor->speed.current = 0;
+                vhn2sp30_brake_vcc(&motor->drive);
+            }
+            break;
+        default:
+            if(motor->applied != mode)
+            {
+                motor->speed.current = 0;
+                vhn2sp30_brake_gnd(&motor->drive);
+            }
+            break;
+    }
+
+    if(mode == MOTOR_MODE_SPEED || mode == MOTOR_MODE_CURRENT)
+    {
+        if(dir != 0 && (motor->zeroed == false || fresh == false))
+        {
+            if(fresh == false)
+            {
+                motor_cycles.stale++;
+                if(motor->stale == MOTOR_STALE_MAX + 1)
+                {
+                    motor_cycles.faults++;
+                }
+            }
+            dir = 0;
+        }
+        if(dir == 0)
+        {
+            motor->integral = 0;
+            vhn2sp30_neutral(&motor->drive);
+        }
+        else
+        {
+            vhn2sp30_io_enable(&motor->drive);
+            if(dir > 0)
+            {
+                vhn2so30_io_cw(&motor->drive);
+            }
+            else
+            {
+                vhn2so30_io_ccw(&motor->drive);
+            }
+            vhn2sp30_io_duty(&motor->drive, (uint16_t)duty);
+        }
+    }
+    motor->duty = (int16_t)((dir * duty * 1000) / VHN2SP30_DUTY_FULL);
+    motor->dir = dir;
+    motor->applied = mode;
+
+    return;
+}
+
+/**
+ * @brief   Take over PI parameters set by @ref motor_set_pi and restart integrator. Lock is only tried, if setter holds
+ *          it parameters are taken next period.
+ */
+static void motor_pi_update(motor_data_t *motor)
+{
+    if(motor->pi_update == false || osMutexAcquire(motor_pi_lock_id, 0) != osOK)
+    {
+        return;
+    }
+    motor->pi = motor->pi_pending;
+    motor->pi_update = false;
+    motor->integral = 0;
+    osMutexRelease(motor_pi_lock_id);
+
+    return;
+}
+
+/**
+ * @brief   Move speed one percent toward target every ramp time, or jump to target without ramp.
+ */
+static void motor_ramp_step(motor_data_t *motor)
+{
+    int16_t target = motor->speed.target;
+
+    if(motor_ramp == 0)
+    {
+        motor->speed.current = target;
+        return;
+    }
+    motor->speed.time += MOTOR_PERIOD;
+    if(motor->speed.time < motor_ramp)
+    {
+        return;
+    }
+    motor->speed.time = 0;
+
+    if(target > motor->speed.current)
+    {
+        motor->speed.current++;
+    }
+    else if(target < motor->speed.current)
+    {
+        motor->speed.current--;
+    }
+
+    return;
+}
+
+/**
+ * @brief   PI step with feed-forward. Integrator is clamped to room left between feed-forward and output limits, so
+ *          it does not wind up while output saturates.
+ *
+ * @param   motor   Motor.
+ * @param   error   Current error in mA.
+ * @param   ff      Feed-forward duty (Q15).
+ * @param   max     Maximum duty (Q15), minimum is 0.
+ *
+ * @return  Duty (Q15).
+ */
+static int32_t motor_pi(motor_data_t *motor, int32_t error, int32_t ff, int32_t max)
+{
+    int64_t integral = motor->integral + (int64_t)motor->pi.ki * error;
+    int64_t out = 0;
+
+    integral = MIN(integral, (int64_t)(max - ff) * (1L << MOTOR_PI_FRAC));
+    integral = MAX(integral, (int64_t)(0 - ff) * (1L << MOTOR_PI_FRAC));
+    motor->integral = (int32_t)integral;
+    out = ff + (((int64_t)motor->pi.kp * error + integral) >> MOTOR_PI_FRAC);
+
+    return (int32_t)MAX(MIN(out, max), 0);
+}
+
+/**
+ * @brief   Update loop statistics.
+ *
+ * @param   period  Cycles since previous period start.
+ * @param   exec    Cycles spent in this period.
+ */
+static void motor_stats_update(uint32_t period, uint32_t exec)
+{
+    uint32_t nominal = (SystemCoreClock / 1000) * MOTOR_PERIOD;
+    uint32_t jitter = period > nominal ? period - nominal : nominal - period;
+
+    if(motor_cycles_reset == true)
+    {
+        motor_cycles_reset = false;
+        memset(&motor_cycles, 0, sizeof(motor_cycles));
+        /* First period after reset has no valid previous start */
+        jitter = 0;
+    }
+    /* Periods skipped after overrun are counted there, not as jitter */
+    if(motor_cycles.loops != 0 && jitter < nominal)
+    {
+        motor_cycles.jitter_max = MAX(motor_cycles.jitter_max, jitter);
+    }
+    motor_cycles.exec_avg += exec - (motor_cycles.exec_avg >> MOTOR_EXEC_AVG);
+    motor_cycles.exec_max = MAX(motor_cycles.exec_max, exec);
+    motor_cycles.loops++;
+
+    return;
+}
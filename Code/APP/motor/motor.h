@@ -27,10 +27,13 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
+#define MOTOR_PI_FRAC   12      //!< Fraction bits of current PI gains.
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -46,6 +49,43 @@ typedef enum
     MOTOR_ID_LAST,
 } motor_id_t;
 
+/**
+ * @brief   Control mode of motor.
+ */
+typedef enum
+{
+    MOTOR_MODE_NEUTRAL,         //!< Bridge off, motor coasts.
+    MOTOR_MODE_BRAKE,           //!< Both motor leads tied to supply.
+    MOTOR_MODE_SPEED,           //!< Duty follows ramped speed in percent, current loop only enforces current limit.
+    MOTOR_MODE_CURRENT,         //!< Current (torque) loop with feed-forward.
+    MOTOR_MODE_LAST,            //!< Last should stay last.
+} motor_mode_t;
+
+/**
+ * @brief   Current PI loop parameters. Gains are duty (Q15 of full duty) per mA with @ref MOTOR_PI_FRAC fraction bits.
+ */
+typedef struct
+{
+    uint16_t kp;                //!< Proportional gain.
+    uint16_t ki;                //!< Integral gain per control period.
+    uint16_t ff;                //!< Feed-forward gain, duty needed per mA of target current.
+    uint16_t limit;             //!< Current limit in mA, applies to all modes.
+} motor_pi_cfg_t;
+
+/**
+ * @brief   Control loop statistics.
+ */
+typedef struct
+{
+    uint32_t loops;             //!< Control periods run.
+    uint32_t overruns;          //!< Periods started so late that whole period was skipped.
+    uint32_t stale;             //!< Periods without new current sample, duty was held or drive was in neutral.
+    uint32_t faults;            //!< Times drive went neutral because current samples stopped.
+    uint32_t jitter_max;        //!< Largest deviation of time between period starts from period in us.
+    uint32_t exec_avg;          //!< Average execution time of single period in us.
+    uint32_t exec_max;          //!< Longest execution time of single period in us.
+} motor_stats_t;
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -64,9 +104,56 @@ void motor_neutral(motor_id_t motor);
 void motor_test(motor_id_t motor, uint8_t ramp);
 void motor_test_ramp(motor_id_t motor, uint8_t ramp);
 
+
+/**
+ * @brief   Drive motor with constant current (torque). Switches motor to @ref MOTOR_MODE_CURRENT.
+ *
+ * @param   motor   Motor ID.
+ * @param   current Target current in mA, sign selects direction. Limited to current limit.
+ */
+void motor_set_current(motor_id_t motor, int16_t current);
+
+/**
+ * @brief   Set current PI loop parameters. Integrator restarts on next control period.
+ *
+ * @param   motor   Motor ID.
+ * @param   cfg     Parameters. See @ref motor_pi_cfg_t.
+ */
+void motor_set_pi(motor_id_t motor, const motor_pi_cfg_t *cfg);
+void motor_get_pi(motor_id_t motor, motor_pi_cfg_t *cfg);
+
+/**
+ * @brief   Get control loop statistics.
+ *
+ * @param   stats   Pointer to structure where statistics will be copied.
+ */
+void motor_get_stats(motor_stats_t *stats);
+void motor_reset_stats(void);
+
+motor_mode_t motor_get_mode(motor_id_t motor);
 int16_t motor_get_speed_target(motor_id_t motor);
 int16_t motor_get_speed_current(motor_id_t motor);
 uint16_t motor_get_current(motor_id_t motor);
+int16_t motor_get_current_target(motor_id_t motor);
+
+/**
+ * @brief   Get number of current sense conversions. Advances once per PWM period, control loop drives motor only in
+ *          periods where it advanced.
+ *
+ * @param   motor   Motor ID.
+ *
+ * @return  Conversion count.
+ */
+uint32_t motor_get_samples(motor_id_t motor);
+
+/**
+ * @brief   Get duty cycle applied by control loop.
+ *
+ * @param   motor   Motor ID.
+ *
+ * @return  Duty in permille, sign is direction.
+ */
+int16_t motor_get_duty(motor_id_t motor);
 
 #ifdef __cplusplus
 }
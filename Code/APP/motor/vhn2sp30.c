@@ -56,6 +56,8 @@
  *********************************************************************************************************************/
 void vhn2sp30_init(vhn2sp30_t *drive)
 {
+    adc_cal_t cal = {0};
+
     gpio_output(drive->in_a);
     gpio_output_low(drive->in_a);
     gpio_output(drive->in_b);
@@ -64,6 +66,12 @@ void vhn2sp30_init(vhn2sp30_t *drive)
     gpio_output_low(drive->en);
     pwm_set(drive->pwm, 0);
 
+    /* Current sense output in mA per volt */
+    adc_get_cal(drive->cs, &cal);
+    cal.gain = ADC_CAL_GAIN_ONE;
+    cal.scale = (VHN2SP30_CURRENT_SENSE_COEF * 1000) / VHN2SP30_CURRENT_SENSE_RESISTOR;
+    adc_set_cal(drive->cs, &cal);
+
     return;
 }
 
@@ -138,6 +146,14 @@ void vhn2sp30_io_pwm(vhn2sp30_t *drive, uint8_t pwm)
     return;
 }
 
+void vhn2sp30_io_duty(vhn2sp30_t *drive, uint16_t duty)
+{
+    duty = duty > VHN2SP30_DUTY_FULL ? VHN2SP30_DUTY_FULL : duty;
+    pwm_set(drive->pwm, (uint32_t)(((uint64_t)pwm_get_period(drive->pwm) * duty) >> 15));
+
+    return;
+}
+
 void vhn2sp30_io_enable(vhn2sp30_t *drive)
 {
     gpio_output_high(drive->en);
@@ -154,7 +170,19 @@ void vhn2sp30_io_disable(vhn2sp30_t *drive)
 
 uint32_t vhn2sp30_io_cs(vhn2sp30_t *drive)
 {
-    return (uint32_t)((adc_get_value_volt(drive->cs) *VHN2SP30_CURRENT_SENSE_COEF) / VHN2SP30_CURRENT_SENSE_RESISTOR);
+    int32_t current = adc_get_value(drive->cs);
+
+    return current > 0 ? (uint32_t)current : 0;
+}
+
+bool vhn2sp30_io_cs_zero(vhn2sp30_t *drive)
+{
+    return adc_cal_zero(drive->cs, VHN2SP30_CURRENT_SENSE_ZERO);
+}
+
+uint32_t vhn2sp30_io_cs_samples(vhn2sp30_t *drive)
+{
+    return adc_get_trigger_count(drive->cs);
 }
 
 /**********************************************************************************************************************
@@ -28,6 +28,7 @@ extern "C" {
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "periph/adc.h"
 #include "periph/gpio.h"
@@ -38,6 +39,8 @@ extern "C" {
  *********************************************************************************************************************/
 #define VHN2SP30_CURRENT_SENSE_RESISTOR 1500    //!< Current sense resistance in Ohms.
 #define VHN2SP30_CURRENT_SENSE_COEF     11370   //!< Current sense coefficient K1 or K2 by manual, typical value.
+#define VHN2SP30_CURRENT_SENSE_ZERO     32      //!< Current sense samples averaged for zero offset.
+#define VHN2SP30_DUTY_FULL              32768   //!< Duty cycle of 100 % for @ref vhn2sp30_io_duty (Q15).
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -73,9 +76,12 @@ void vhn2sp30_neutral(vhn2sp30_t *drive);
 void vhn2so30_io_cw(vhn2sp30_t *drive);
 void vhn2so30_io_ccw(vhn2sp30_t *drive);
 void vhn2sp30_io_pwm(vhn2sp30_t *drive, uint8_t pwm);
+void vhn2sp30_io_duty(vhn2sp30_t *drive, uint16_t duty);
 void vhn2sp30_io_enable(vhn2sp30_t *drive);
 void vhn2sp30_io_disable(vhn2sp30_t *drive);
 uint32_t vhn2sp30_io_cs(vhn2sp30_t *drive);
+bool vhn2sp30_io_cs_zero(vhn2sp30_t *drive);
+uint32_t vhn2sp30_io_cs_samples(vhn2sp30_t *drive);
 
 #ifdef __cplusplus
 }
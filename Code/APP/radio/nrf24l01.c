@@ -22,7 +22,10 @@
  *********************************************************************************************************************/
 #include <stdint.h>
 
+#include "cmsis_os2.h"
+
 #include "nrf24l01.h"
+#include "spi_bus.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
 
@@ -144,14 +147,18 @@
 #define NRF24L01_R_RX_PL_WID_MASK           0x60
 #define NRF24L01_NOP_MASK                   0xFF
 
+#define NRF24L01_BUS_TIMEOUT                100     //!< Longest wait for SPI bus in ms, display flush takes less.
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
 /** Pins configuration */
 #define NRF24L01_CE_LOW             gpio_output_low(GPIO_NRF214L01_CE)
 #define NRF24L01_CE_HIGH            gpio_output_high(GPIO_NRF214L01_CE)
-#define NRF24L01_CSN_LOW            gpio_output_low(GPIO_NRF214L01_CSN)
-#define NRF24L01_CSN_HIGH           gpio_output_high(GPIO_NRF214L01_CSN)
+/** Take SPI bus and pull chip select low, false if bus was not taken. Transfer must be skipped then, release would
+ *  free bus of other device. */
+#define NRF24L01_CSN_LOW            spi_bus_acquire(SPI_BUS_DEVICE_RADIO, NRF24L01_BUS_TIMEOUT)
+#define NRF24L01_CSN_HIGH           spi_bus_release(SPI_BUS_DEVICE_RADIO)
 
 /** Clear interrupt flags */
 #define NRF24L01_CLEAR_INTERRUPTS   do { nrf24l01_write_register(0x07, 0x70); } while (0)
@@ -160,9 +167,9 @@
 #define NRF24L01_GET_INTERRUPTS     nrf24l01_get_status()
 
 /** Flush TX FIFO. */
-#define NRF24L01_FLUSH_TX           do { NRF24L01_CSN_LOW; spi_0_write_buffer((uint8_t *)NRF24L01_FLUSH_TX_MASK, 1); NRF24L01_CSN_HIGH; } while (0)
+#define NRF24L01_FLUSH_TX           do { nrf24l01_write_command(NRF24L01_FLUSH_TX_MASK); } while (0)
 /** Flush RX FIFO. */
-#define NRF24L01_FLUSH_RX           do { NRF24L01_CSN_LOW; spi_0_write_buffer((uint8_t *)NRF24L01_FLUSH_RX_MASK, 1); NRF24L01_CSN_HIGH; } while (0)
+#define NRF24L01_FLUSH_RX           do { nrf24l01_write_command(NRF24L01_FLUSH_RX_MASK); } while (0)
 
 
 /**********************************************************************************************************************
@@ -197,6 +204,7 @@ void nrf24l01_read_register_multi(uint8_t reg, uint8_t *data, uint8_t count);
 uint8_t nrf24l01_read_bit(uint8_t reg, uint8_t bit);
 void nrf24l01_write_register(uint8_t reg, uint8_t value);
 void nrf24l01_write_register_multi(uint8_t reg, uint8_t *data, uint8_t count);
+void nrf24l01_write_command(uint8_t command);
 void nrf24l01_write_bit(uint8_t reg, uint8_t bit, uint8_t value);
 void nrf24l01_software_reset(void);
 uint8_t nrf24l01_rx_fifo_empty(void);
@@ -344,6 +352,7 @@ nrf24l01_tx_status_t nrf24l01_get_tx_status(void)
 void nrf24l01_transmit(uint8_t *data)
 {
     uint8_t count = nrf24l01_config.payload_size;
+    uint8_t command = NRF24L01_W_TX_PAYLOAD_MASK;
 
     /* Chip enable put to low, disable it */
     NRF24L01_CE_LOW;
@@ -355,9 +364,12 @@ void nrf24l01_transmit(uint8_t *data)
     NRF24L01_FLUSH_TX;
 
     /* Send payload to nRF24L01+ */
-    NRF24L01_CSN_LOW;
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
     /* Send write payload command */
-    spi_0_write_buffer((uint8_t *)NRF24L01_W_TX_PAYLOAD_MASK, 1);
+    spi_0_write_buffer(&command, 1);
     /* Fill payload with data*/
     spi_0_write_buffer(data, count);
     /* Disable SPI */
@@ -383,13 +395,17 @@ uint8_t nrf24l01_data_ready(void)
 
 void nrf24l01_get_data(uint8_t *data)
 {
+    uint8_t command = NRF24L01_R_RX_PAYLOAD_MASK;
+
     // Pull down chip select.
-    NRF24L01_CSN_LOW;
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
 
     // Send read payload command.
-    spi_0_write_buffer((uint8_t *)NRF24L01_R_RX_PAYLOAD_MASK, 1);
     // Read payload.
-    spi_0_read_buffer(data, nrf24l01_config.payload_size);
+    spi_0_write_read(&command, 1, data, nrf24l01_config.payload_size);
     // Pull up chip select.
     NRF24L01_CSN_HIGH;
 
@@ -451,9 +467,12 @@ uint8_t nrf24l01_get_status(void)
 {
     uint8_t status = 0;
 
-    NRF24L01_CSN_LOW;
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return 0;
+    }
     /* First received byte is always status register */
-    spi_0_read_buffer((uint8_t *)status, 1);
+    spi_0_read_buffer(&status, 1);
     /* Pull up chip select */
     NRF24L01_CSN_HIGH;
 
@@ -466,7 +485,7 @@ uint8_t nrf24l01_get_status(void)
 void nrf24l01_init_io(void)
 {
     // CSN high = disable SPI.
-    NRF24L01_CSN_HIGH;
+    gpio_output_high(GPIO_NRF214L01_CSN);
 
     // CE low = disable TX/RX.
     NRF24L01_CE_LOW;
@@ -477,10 +496,13 @@ void nrf24l01_init_io(void)
 uint8_t nrf24l01_read_register(uint8_t reg)
 {
     uint8_t value = 0;
+    uint8_t command = NRF24L01_READ_REGISTER_MASK(reg);
 
-    NRF24L01_CSN_LOW;
-    spi_0_write_buffer((uint8_t *)NRF24L01_READ_REGISTER_MASK(reg), 1);
-    spi_0_read_buffer((uint8_t *)value, 1);
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return 0;
+    }
+    spi_0_write_read(&command, 1, &value, 1);
     NRF24L01_CSN_HIGH;
 
     return value;
@@ -488,8 +510,13 @@ uint8_t nrf24l01_read_register(uint8_t reg)
 
 void nrf24l01_read_register_multi(uint8_t reg, uint8_t *data, uint8_t count)
 {
-    NRF24L01_CSN_LOW;
-    spi_0_write_read((uint8_t *)NRF24L01_READ_REGISTER_MASK(reg), 1, data, count);
+    uint8_t command = NRF24L01_READ_REGISTER_MASK(reg);
+
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
+    spi_0_write_read(&command, 1, data, count);
     NRF24L01_CSN_HIGH;
 
     return;
@@ -512,9 +539,13 @@ uint8_t nrf24l01_read_bit(uint8_t reg, uint8_t bit)
 
 void nrf24l01_write_register(uint8_t reg, uint8_t value)
 {
-    NRF24L01_CSN_LOW;
-    spi_0_write_buffer((uint8_t *)NRF24L01_WRITE_REGISTER_MASK(reg), 1);
-    spi_0_write_buffer((uint8_t *)value, 1);
+    uint8_t data[2] = {NRF24L01_WRITE_REGISTER_MASK(reg), value};
+
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
+    spi_0_write_buffer(data, sizeof(data));
     NRF24L01_CSN_HIGH;
 
     return;
@@ -522,9 +553,26 @@ void nrf24l01_write_register(uint8_t reg, uint8_t value)
 
 void nrf24l01_write_register_multi(uint8_t reg, uint8_t *data, uint8_t count)
 {
-    NRF24L01_CSN_LOW;
-    spi_0_write_buffer((uint8_t *)NRF24L01_WRITE_REGISTER_MASK(reg), 1);
-    spi_0_write_buffer((uint8_t *)data, count);
+    uint8_t command = NRF24L01_WRITE_REGISTER_MASK(reg);
+
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
+    spi_0_write_buffer(&command, 1);
+    spi_0_write_buffer(data, count);
+    NRF24L01_CSN_HIGH;
+
+    return;
+}
+
+void nrf24l01_write_command(uint8_t command)
+{
+    if(NRF24L01_CSN_LOW == false)
+    {
+        return;
+    }
+    spi_0_write_buffer(&command, 1);
     NRF24L01_CSN_HIGH;
 
     return;
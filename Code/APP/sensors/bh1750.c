@@ -26,7 +26,7 @@
 
 #include "bh1750.h"
 
-#include "periph/i2c.h"
+#include "i2c_sched.h"
 #include "cmsis_os2.h"
 
 /**********************************************************************************************************************
@@ -59,6 +59,16 @@
  * It is automatically set to Power Down mode after measurement. */
 #define BH1750_REG_ONE_TIME_LOW_RES_MODE    0x23
 
+/**< Typical measurement time of high and low resolution modes in ms. */
+#define BH1750_TIME_HIGH_RES                120
+#define BH1750_TIME_LOW_RES                 16
+/**< I2C scheduler priority and allowed read delay in ms. */
+#define BH1750_PRIORITY                     1
+#define BH1750_DEADLINE                     10
+/**< Counts per lx at 1 lx resolution is 1.2, kept as ratio 6 / 5. */
+#define BH1750_LX_MUL                       5
+#define BH1750_LX_DIV                       6
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
@@ -70,6 +80,15 @@
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
+/* Periodic read */
+static struct
+{
+    i2c_sched_job_t job;    //!< Scheduler job reading data register.
+    uint8_t data[2];        //!< Raw level.
+    uint32_t period;        //!< Measurement time of current mode in ms.
+    uint32_t lx_div;        //!< Divisor of count to lx of current mode, double in 0.5 lx modes.
+    bh1750_cb_t cb;         //!< Level callback.
+} bh1750_poll = {.period = BH1750_TIME_HIGH_RES, .lx_div = BH1750_LX_DIV};
 
 /**********************************************************************************************************************
  * Exported variables
@@ -80,6 +99,8 @@
  *********************************************************************************************************************/
 static inline bool bh1750_io_write(uint8_t data);
 static inline bool bh1750_io_read(uint8_t *data, uint8_t size);
+static uint16_t bh1750_to_lx(const uint8_t *data);
+static void bh1750_poll_done(i2c_sched_job_t *job);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -96,6 +117,10 @@ bool bh1750_init(bh1750_mode_t mode)
     {
         return false;
     }
+    bh1750_poll.period = (mode == BH1750_MODE_CONT_LOW_RES || mode == BH1750_MODE_ONE_TIME_LOW_RES) ?
+        BH1750_TIME_LOW_RES : BH1750_TIME_HIGH_RES;
+    bh1750_poll.lx_div = (mode == BH1750_MODE_CONT_HIGH_RES_2 || mode == BH1750_MODE_ONE_TIME_HIGH_RES_2) ?
+        BH1750_LX_DIV * 2 : BH1750_LX_DIV;
 
     return true;
 }
@@ -109,7 +134,29 @@ uint16_t bh1750_read_level(void)
         return UINT16_MAX;
     }
 
-    return (uint16_t)((value[0] << 8) | value[1]);
+    return bh1750_to_lx(value);
+}
+
+bool bh1750_start(bh1750_cb_t cb)
+{
+    bh1750_poll.cb = cb;
+    bh1750_poll.job.xfer.addr = BH1750_I2C_ADDR;
+    bh1750_poll.job.xfer.rx = bh1750_poll.data;
+    bh1750_poll.job.xfer.rx_size = sizeof(bh1750_poll.data);
+    bh1750_poll.job.period = bh1750_poll.period;
+    bh1750_poll.job.deadline = BH1750_DEADLINE;
+    bh1750_poll.job.priority = BH1750_PRIORITY;
+    bh1750_poll.job.cb = bh1750_poll_done;
+
+    /* First result is ready after one measurement time */
+    return i2c_sched_add(&bh1750_poll.job, bh1750_poll.period);
+}
+
+void bh1750_stop(void)
+{
+    i2c_sched_remove(&bh1750_poll.job);
+
+    return;
 }
 
 /**********************************************************************************************************************
@@ -117,7 +164,9 @@ uint16_t bh1750_read_level(void)
  *********************************************************************************************************************/
 static inline bool bh1750_io_write(uint8_t data)
 {
-    if(i2c_tx_rx(BH1750_I2C_ADDR, &data, 1, NULL, 0) == false)
+    i2c_xfer_t xfer = {.addr = BH1750_I2C_ADDR, .tx = &data, .tx_size = 1};
+
+    if(i2c_sched_xfer(&xfer, BH1750_PRIORITY) != I2C_STATUS_OK)
     {
         return false;
     }
@@ -127,7 +176,9 @@ static inline bool bh1750_io_write(uint8_t data)
 
 static inline bool bh1750_io_read(uint8_t *data, uint8_t size)
 {
-    if(i2c_tx_rx(BH1750_I2C_ADDR, NULL, 0, data, size) == false)
+    i2c_xfer_t xfer = {.addr = BH1750_I2C_ADDR, .rx = data, .rx_size = size};
+
+    if(i2c_sched_xfer(&xfer, BH1750_PRIORITY) != I2C_STATUS_OK)
     {
         return false;
     }
@@ -135,3 +186,24 @@ static inline bool bh1750_io_read(uint8_t *data, uint8_t size)
     return true;
 }
 
+/**
+ * @brief   Convert data register to lx, rounded. Highest count gives 54613 lx, so UINT16_MAX stays free for errors.
+ */
+static uint16_t bh1750_to_lx(const uint8_t *data)
+{
+    uint32_t count = ((uint32_t)data[0] << 8) | data[1];
+
+    return (uint16_t)((count * BH1750_LX_MUL + bh1750_poll.lx_div / 2) / bh1750_poll.lx_div);
+}
+
+static void bh1750_poll_done(i2c_sched_job_t *job)
+{
+    if(bh1750_poll.cb == NULL)
+    {
+        return;
+    }
+
+    bh1750_poll.cb(job->ok ? bh1750_to_lx(bh1750_poll.data) : UINT16_MAX, job->time);
+
+    return;
+}
@@ -27,6 +27,8 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported constants
@@ -58,6 +60,14 @@ typedef enum
                                                  It is automatically set to Power Down mode after measurement. */
 } bh1750_mode_t;
 
+/**
+ * @brief   Light level callback of periodic measurement. Called from I2C scheduler thread.
+ *
+ * @param   level   Light level in lx, UINT16_MAX if read failed.
+ * @param   time    Kernel tick when level was read.
+ */
+typedef void (*bh1750_cb_t)(uint16_t level, uint32_t time);
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -79,10 +89,23 @@ bool bh1750_init(bh1750_mode_t mode);
 /**
  * @brief   Read BH1750 light level.
  *
- * @return  Light level in lx.
+ * @return  Light level in lx, UINT16_MAX if read failed.
  */
 uint16_t bh1750_read_level(void);
 
+/**
+ * @brief   Start reading light level periodically by I2C scheduler, once per measurement time of current mode.
+ *
+ * @param   cb  Callback to receive levels.
+ *
+ * @return  True if periodic read was started.
+ */
+bool bh1750_start(bh1750_cb_t cb);
+
+/**
+ * @brief   Stop periodic read.
+ */
+void bh1750_stop(void);
 
 #ifdef __cplusplus
 }
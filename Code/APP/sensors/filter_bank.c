@@ -0,0 +1,286 @@
+/**
+ **********************************************************************************************************************
+ * @file         filter_bank.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Block processing biquad IIR and FIR filters for multiple channels.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "sensors/filter_bank.h"
+#include "sensors/filters.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define FILTER_BANK_PI      3.14159265f
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static bool filter_bank_coef(float value, int32_t *coef);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool filter_bank_biquad_design(filter_bank_biquad_t *coef, filter_bank_type_t type, float rate, float freq, float q)
+{
+    float w0 = 0;
+    float cos_w0 = 0;
+    float alpha = 0;
+    float a0 = 0;
+    float b[3] = {0};
+    bool ok = true;
+
+    if(type >= FILTER_BANK_LAST || rate <= 0 || freq <= 0 || freq >= rate / 2 || q <= 0)
+    {
+        return false;
+    }
+
+    w0 = 2 * FILTER_BANK_PI * freq / rate;
+    cos_w0 = cosf(w0);
+    alpha = sinf(w0) / (2 * q);
+    a0 = 1 + alpha;
+
+    switch(type)
+    {
+        case FILTER_BANK_LOW_PASS:
+            b[0] = (1 - cos_w0) / 2;
+            b[1] = 1 - cos_w0;
+            b[2] = b[0];
+            break;
+        case FILTER_BANK_HIGH_PASS:
+            b[0] = (1 + cos_w0) / 2;
+            b[1] = -(1 + cos_w0);
+            b[2] = b[0];
+            break;
+        case FILTER_BANK_BAND_PASS:
+            b[0] = alpha;
+            b[1] = 0;
+            b[2] = -alpha;
+            break;
+        default:
+            b[0] = 1;
+            b[1] = -2 * cos_w0;
+            b[2] = 1;
+            break;
+    }
+
+    ok &= filter_bank_coef(b[0] / a0, &coef->b0);
+    ok &= filter_bank_coef(b[1] / a0, &coef->b1);
+    ok &= filter_bank_coef(b[2] / a0, &coef->b2);
+    ok &= filter_bank_coef(-2 * cos_w0 / a0, &coef->a1);
+    ok &= filter_bank_coef((1 - alpha) / a0, &coef->a2);
+
+    return ok;
+}
+
+bool filter_bank_fir_design(int16_t *coef, uint8_t taps, float rate, float freq)
+{
+    float h[FILTER_BANK_TAPS_MAX];
+    float sum = 0;
+    float fc = 0;
+    float t = 0;
+    float value = 0;
+    uint8_t i = 0;
+
+    if(taps == 0 || taps > FILTER_BANK_TAPS_MAX || rate <= 0 || freq <= 0 || freq >= rate / 2)
+    {
+        return false;
+    }
+
+    fc = freq / rate;
+    for(i = 0; i < taps; i++)
+    {
+        t = (float)i - (float)(taps - 1) / 2;
+        h[i] = t == 0 ? 2 * fc : sinf(2 * FILTER_BANK_PI * fc * t) / (FILTER_BANK_PI * t);
+        if(taps > 1)
+        {
+            h[i] *= 0.54f - 0.46f * cosf(2 * FILTER_BANK_PI * i / (taps - 1));
+        }
+        sum += h[i];
+    }
+    for(i = 0; i < taps; i++)
+    {
+        value = h[i] / sum * (1 << FILTER_BANK_FIR_FRAC);
+        value += value < 0 ? -0.5f : 0.5f;
+        coef[i] = value >= INT16_MAX ? INT16_MAX : value <= INT16_MIN ? INT16_MIN : (int16_t)value;
+    }
+
+    return true;
+}
+
+bool filter_bank_iir_init(filter_bank_iir_t *iir, const filter_bank_biquad_t *coef, uint8_t stages,
+    uint8_t channels)
+{
+    if(stages == 0 || stages > FILTER_BANK_STAGES_MAX || channels == 0 || channels > FILTER_BANK_CHANNELS_MAX)
+    {
+        return false;
+    }
+
+    memset(iir, 0, sizeof(filter_bank_iir_t));
+    iir->coef = coef;
+    iir->stages = stages;
+    iir->channels = channels;
+
+    return true;
+}
+
+void filter_bank_iir_process(filter_bank_iir_t *iir, int32_t *data, uint16_t count)
+{
+    const filter_bank_biquad_t *coef = NULL;
+    int32_t *samples = NULL;
+    int32_t x0 = 0;
+    int32_t x1 = 0;
+    int32_t x2 = 0;
+    int32_t y1 = 0;
+    int32_t y2 = 0;
+    int64_t acc = 0;
+    uint8_t stage = 0;
+    uint8_t ch = 0;
+    uint16_t n = 0;
+
+    /* Section by section over whole block, so coefficients and state stay in registers in inner loop */
+    for(stage = 0; stage < iir->stages; stage++)
+    {
+        coef = &iir->coef[stage];
+        for(ch = 0; ch < iir->channels; ch++)
+        {
+            samples = &data[ch * count];
+            x1 = iir->state[stage].x1[ch];
+            x2 = iir->state[stage].x2[ch];
+            y1 = iir->state[stage].y1[ch];
+            y2 = iir->state[stage].y2[ch];
+            for(n = 0; n < count; n++)
+            {
+                x0 = samples[n];
+                /* 64 bit multiply-accumulate, rounded */
+                acc = (int64_t)coef->b0 * x0 + (int64_t)coef->b1 * x1 + (int64_t)coef->b2 * x2 -
+                    (int64_t)coef->a1 * y1 - (int64_t)coef->a2 * y2 + (1LL << (FILTER_BANK_IIR_FRAC - 1));
+                x2 = x1;
+                x1 = x0;
+                y2 = y1;
+                y1 = filters_q31_sat(acc >> FILTER_BANK_IIR_FRAC);
+                samples[n] = y1;
+            }
+            iir->state[stage].x1[ch] = x1;
+            iir->state[stage].x2[ch] = x2;
+            iir->state[stage].y1[ch] = y1;
+            iir->state[stage].y2[ch] = y2;
+        }
+    }
+
+    return;
+}
+
+bool filter_bank_fir_init(filter_bank_fir_t *fir, const int16_t *coef, uint8_t taps, uint8_t channels)
+{
+    if(taps == 0 || taps > FILTER_BANK_TAPS_MAX || channels == 0 || channels > FILTER_BANK_CHANNELS_MAX)
+    {
+        return false;
+    }
+
+    memset(fir, 0, sizeof(filter_bank_fir_t));
+    fir->coef = coef;
+    fir->taps = taps;
+    fir->channels = channels;
+
+    return true;
+}
+
+void filter_bank_fir_process(filter_bank_fir_t *fir, int32_t *data, uint16_t count)
+{
+    const int16_t *coef = fir->coef;
+    const int32_t *window = NULL;
+    int32_t *delay = NULL;
+    int32_t *samples = NULL;
+    int64_t acc = 0;
+    uint8_t taps = fir->taps;
+    uint8_t pos = 0;
+    uint8_t ch = 0;
+    uint8_t k = 0;
+    uint16_t n = 0;
+
+    for(ch = 0; ch < fir->channels; ch++)
+    {
+        samples = &data[ch * count];
+        delay = fir->delay[ch];
+        pos = fir->pos;
+        for(n = 0; n < count; n++)
+        {
+            /* Newest sample replaces oldest one in both copies, window then starts at next oldest */
+            delay[pos] = samples[n];
+            delay[pos + taps] = samples[n];
+            pos = pos + 1 < taps ? pos + 1 : 0;
+            window = &delay[pos + taps - 1];
+            acc = 1LL << (FILTER_BANK_FIR_FRAC - 1);
+            for(k = 0; k < taps; k++)
+            {
+                acc += (int64_t)coef[k] * window[-k];
+            }
+            samples[n] = filters_q31_sat(acc >> FILTER_BANK_FIR_FRAC);
+        }
+    }
+    /* All channels advance together */
+    fir->pos = pos;
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Convert biquad coefficient to fixed point.
+ *
+ * @param   value   Coefficient.
+ * @param   coef    Fixed-point coefficient with @ref FILTER_BANK_IIR_FRAC fraction bits.
+ *
+ * @return  False if coefficient is out of range.
+ */
+static bool filter_bank_coef(float value, int32_t *coef)
+{
+    float scaled = value * (float)(1UL << FILTER_BANK_IIR_FRAC);
+
+    if(scaled >= 2147483648.0f || scaled < -2147483648.0f)
+    {
+        return false;
+    }
+    *coef = (int32_t)scaled;
+
+    return true;
+}
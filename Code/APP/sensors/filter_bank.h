@@ -0,0 +1,183 @@
+/**
+ **********************************************************************************************************************
+ * @file        filter_bank.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Block processing biquad IIR and FIR filters for multiple channels.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef FILTER_BANK_H_
+#define FILTER_BANK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define FILTER_BANK_CHANNELS_MAX    4   //!< Maximum channels of single filter.
+#define FILTER_BANK_STAGES_MAX      4   //!< Maximum biquad sections of IIR filter.
+#define FILTER_BANK_TAPS_MAX        32  //!< Maximum taps of FIR filter.
+#define FILTER_BANK_IIR_FRAC        30  //!< Fraction bits of biquad coefficients, range is -2.0 to 2.0.
+#define FILTER_BANK_FIR_FRAC        15  //!< Fraction bits of FIR coefficients.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Biquad response for coefficient design.
+ */
+typedef enum
+{
+    FILTER_BANK_LOW_PASS,           //!< Low pass.
+    FILTER_BANK_HIGH_PASS,          //!< High pass.
+    FILTER_BANK_BAND_PASS,          //!< Band pass, 0 dB peak gain.
+    FILTER_BANK_NOTCH,              //!< Notch.
+    FILTER_BANK_LAST,               //!< Last should stay last.
+} filter_bank_type_t;
+
+/**
+ * @brief   Biquad section coefficients, y = b0 x0 + b1 x1 + b2 x2 - a1 y1 - a2 y2.
+ */
+typedef struct
+{
+    int32_t b0;                     //!< Coefficients with @ref FILTER_BANK_IIR_FRAC fraction bits.
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+} filter_bank_biquad_t;
+
+/**
+ * @brief   Cascaded biquad IIR filter. State of each section is kept per channel, channels side by side.
+ */
+typedef struct
+{
+    const filter_bank_biquad_t *coef;   //!< Coefficients of sections, shared by channels.
+    uint8_t stages;                     //!< Number of sections.
+    uint8_t channels;                   //!< Number of channels.
+    struct
+    {
+        int32_t x1[FILTER_BANK_CHANNELS_MAX];
+        int32_t x2[FILTER_BANK_CHANNELS_MAX];
+        int32_t y1[FILTER_BANK_CHANNELS_MAX];
+        int32_t y2[FILTER_BANK_CHANNELS_MAX];
+    } state[FILTER_BANK_STAGES_MAX];
+} filter_bank_iir_t;
+
+/**
+ * @brief   FIR filter. Delay line of each channel is stored twice, so taps always read contiguous samples.
+ */
+typedef struct
+{
+    const int16_t *coef;                //!< Coefficients with @ref FILTER_BANK_FIR_FRAC fraction bits.
+    uint8_t taps;                       //!< Number of taps.
+    uint8_t channels;                   //!< Number of channels.
+    uint8_t pos;                        //!< Position of oldest sample in delay lines.
+    int32_t delay[FILTER_BANK_CHANNELS_MAX][2 * FILTER_BANK_TAPS_MAX];
+} filter_bank_fir_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Design biquad section from RBJ audio EQ cookbook formulas. Intended for init, uses float math.
+ *
+ * @param   coef    Coefficients to fill.
+ * @param   type    Response. See @ref filter_bank_type_t.
+ * @param   rate    Sample rate in Hz.
+ * @param   freq    Cut off or center frequency in Hz, below rate / 2.
+ * @param   q       Quality factor, 0.7071 for Butterworth section.
+ *
+ * @return  False if parameters are invalid or coefficient does not fit fixed-point range.
+ */
+bool filter_bank_biquad_design(filter_bank_biquad_t *coef, filter_bank_type_t type, float rate, float freq, float q);
+
+/**
+ * @brief   Design windowed-sinc low pass FIR with Hamming window and unity DC gain. Intended for init, uses float
+ *          math.
+ *
+ * @param   coef    Coefficients to fill.
+ * @param   taps    Number of taps, 1 to @ref FILTER_BANK_TAPS_MAX.
+ * @param   rate    Sample rate in Hz.
+ * @param   freq    Cut off frequency in Hz, below rate / 2.
+ *
+ * @return  False if parameters are invalid.
+ */
+bool filter_bank_fir_design(int16_t *coef, uint8_t taps, float rate, float freq);
+
+/**
+ * @brief   Initialize IIR filter with cleared state.
+ *
+ * @param   iir         IIR filter.
+ * @param   coef        Coefficients of sections, must stay valid while filter is used.
+ * @param   stages      Number of sections, 1 to @ref FILTER_BANK_STAGES_MAX.
+ * @param   channels    Number of channels, 1 to @ref FILTER_BANK_CHANNELS_MAX.
+ *
+ * @return  False if parameters are invalid.
+ */
+bool filter_bank_iir_init(filter_bank_iir_t *iir, const filter_bank_biquad_t *coef, uint8_t stages,
+    uint8_t channels);
+
+/**
+ * @brief   Filter block of samples of all channels in place. Samples are in any Q format with at least 2 bits of
+ *          headroom, outputs saturate to 32 bits.
+ *
+ * @param   iir     IIR filter.
+ * @param   data    Samples of channel 0 followed by samples of channel 1 and so on.
+ * @param   count   Samples per channel.
+ */
+void filter_bank_iir_process(filter_bank_iir_t *iir, int32_t *data, uint16_t count);
+
+/**
+ * @brief   Initialize FIR filter with cleared delay lines.
+ *
+ * @param   fir         FIR filter.
+ * @param   coef        Coefficients, must stay valid while filter is used.
+ * @param   taps        Number of taps, 1 to @ref FILTER_BANK_TAPS_MAX.
+ * @param   channels    Number of channels, 1 to @ref FILTER_BANK_CHANNELS_MAX.
+ *
+ * @return  False if parameters are invalid.
+ */
+bool filter_bank_fir_init(filter_bank_fir_t *fir, const int16_t *coef, uint8_t taps, uint8_t channels);
+
+/**
+ * @brief   Filter block of samples of all channels in place, outputs saturate to 32 bits.
+ *
+ * @param   fir     FIR filter.
+ * @param   data    Samples of channel 0 followed by samples of channel 1 and so on.
+ * @param   count   Samples per channel.
+ */
+void filter_bank_fir_process(filter_bank_fir_t *fir, int32_t *data, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FILTER_BANK_H_ */
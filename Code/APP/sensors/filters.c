@@ -4,7 +4,7 @@
  * @author       Diamond Sparrow
  * @version      1.0.0.0
  * @date         2016-10-04
- * @brief        This is C source file template.
+ * @brief        Low pass, high pass and Kalman filters in fixed point with double wrappers.
  **********************************************************************************************************************
  * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
  *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
@@ -27,10 +27,18 @@
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
+#define FILTERS_VALUE_FRAC  12  //!< Fraction bits of values passed through double wrappers.
+#define FILTERS_COV_FRAC    16  //!< Fraction bits of covariances passed through double wrappers.
+#define FILTERS_GAIN_BITS   16  //!< Significant bits of covariance sum used for gain division.
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
+#define FILTERS_TO_Q(X, F)      filters_q31_sat((int64_t)((X) * (double)(1UL << (F))))
+#define FILTERS_FROM_Q(X, F)    ((double)(X) / (double)(1UL << (F)))
+/** Step towards input, only sum is saturated, so full scale step is not cut in half by saturated product */
+#define FILTERS_STEP(OUT, IN, COEF) \
+    filters_q31_sat((int64_t)(OUT) + ((((int64_t)(IN) - (OUT)) * (COEF)) >> 15))
 
 /**********************************************************************************************************************
  * Private typedef
@@ -47,10 +55,83 @@
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static uint32_t filters_cov_to_q(double cov);
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
+q31_t filters_q31_sat(int64_t value)
+{
+    if(value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if(value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+
+    return (q31_t)value;
+}
+
+q31_t filters_q31_mul(int64_t value, q15_t coef)
+{
+    /* 48 bit product cannot overflow, arithmetic shift rounds towards minus infinity */
+    return filters_q31_sat((value * coef) >> 15);
+}
+
+filters_kalman_q_t filter_kalman_q_init(uint32_t proc_noise_cov, uint32_t meas_noise_cov, uint32_t est_error,
+    q31_t value)
+{
+    filters_kalman_q_t result = {0};
+
+    result.process_noise_cov        = proc_noise_cov;
+    result.measurement_noise_cov    = meas_noise_cov;
+    result.estimation_error         = est_error;
+    result.value                    = value;
+
+    return result;
+}
+
+q31_t filters_kalman_q_update(filters_kalman_q_t *data, q31_t input)
+{
+    uint32_t error = data->estimation_error;
+    uint32_t sum = 0;
+    uint32_t gain = 0;
+    uint8_t shift = 0;
+
+    // Prediction update. Omit x = x.
+    error = error + data->process_noise_cov < error ? UINT32_MAX : error + data->process_noise_cov;
+
+    // Measurement update. Gain is ratio, so both covariances are scaled down to keep division in 32 bits.
+    sum = error + data->measurement_noise_cov < error ? UINT32_MAX : error + data->measurement_noise_cov;
+    while((sum >> shift) >= (1UL << FILTERS_GAIN_BITS))
+    {
+        shift++;
+    }
+    gain = (sum >> shift) == 0 ? 0 : ((error >> shift) << 15) / (sum >> shift);
+    data->gain = (q15_t)(gain > INT16_MAX ? INT16_MAX : gain);
+    data->value = FILTERS_STEP(data->value, input, data->gain);
+    data->estimation_error = (uint32_t)(((uint64_t)error * (uint32_t)(FILTERS_Q15_ONE - data->gain)) >> 15);
+
+    return data->value;
+}
+
+q31_t filter_low_pass_q(filters_low_pass_q_t *data, q31_t input)
+{
+    data->output = FILTERS_STEP(data->output, input, data->cut_off);
+
+    return data->output;
+}
+
+q31_t filter_high_pass_q(filters_high_pass_q_t *data, q31_t input)
+{
+    q31_t low = FILTERS_STEP(data->output, input, data->cut_off);
+
+    data->output = filters_q31_sat((int64_t)input - low);
+
+    return data->output;
+}
 
 /**********************************************************************************************************************
  * Private functions
@@ -69,31 +150,67 @@ filters_kalman_t filter_kalman_init(double proc_noise_cov, double meas_noise_cov
 
 double filters_kalman_update(filters_kalman_t *data, double input)
 {
-    // Prediction update. Omit x = x.
-    data->estimation_error = data->estimation_error + data->process_noise_cov;
+    filters_kalman_q_t q = filter_kalman_q_init(filters_cov_to_q(data->process_noise_cov),
+        filters_cov_to_q(data->measurement_noise_cov), filters_cov_to_q(data->estimation_error),
+        FILTERS_TO_Q(data->value, FILTERS_VALUE_FRAC));
 
-    // Measurement update
-    data->gain = data->estimation_error / (data->estimation_error + data->measurement_noise_cov);
-    data->value = data->value + data->gain * (input - data->value);
-    data->estimation_error = (1 - data->gain) * data->estimation_error;
+    filters_kalman_q_update(&q, FILTERS_TO_Q(input, FILTERS_VALUE_FRAC));
+    data->value = FILTERS_FROM_Q(q.value, FILTERS_VALUE_FRAC);
+    data->estimation_error = FILTERS_FROM_Q(q.estimation_error, FILTERS_COV_FRAC);
+    data->gain = FILTERS_FROM_Q(q.gain, 15);
 
     return data->value;
 }
 
 double filter_low_pass(filters_low_pass_t *data, double input, double cut_off)
 {
+    filters_low_pass_q_t q =
+    {
+        .output = FILTERS_TO_Q(data->output, FILTERS_VALUE_FRAC),
+        .cut_off = FILTERS_Q15(cut_off),
+    };
+
     data->input = input;
     data->cut_off = cut_off;
-    data->output = data->output + (data->cut_off * (data->input - data->output));
+    data->output = FILTERS_FROM_Q(filter_low_pass_q(&q, FILTERS_TO_Q(input, FILTERS_VALUE_FRAC)), FILTERS_VALUE_FRAC);
 
     return data->output;
 }
 
 double filter_high_pass(filters_high_pass_t *data, double input, double cut_off)
 {
+    filters_high_pass_q_t q =
+    {
+        .output = FILTERS_TO_Q(data->output, FILTERS_VALUE_FRAC),
+        .cut_off = FILTERS_Q15(cut_off),
+    };
+
     data->input = input;
     data->cut_off = cut_off;
-    data->output = data->input - (data->output + data->cut_off * (data->input - data->output));
+    data->output = FILTERS_FROM_Q(filter_high_pass_q(&q, FILTERS_TO_Q(input, FILTERS_VALUE_FRAC)), FILTERS_VALUE_FRAC);
 
     return data->output;
 }
+
+/**
+ * @brief   Convert covariance of double wrapper to fixed point.
+ *
+ * @param   cov     Covariance.
+ *
+ * @return  Covariance with @ref FILTERS_COV_FRAC fraction bits, saturated.
+ */
+static uint32_t filters_cov_to_q(double cov)
+{
+    double value = cov * (double)(1UL << FILTERS_COV_FRAC);
+
+    if(value <= 0)
+    {
+        return 0;
+    }
+    if(value >= (double)UINT32_MAX)
+    {
+        return UINT32_MAX;
+    }
+
+    return (uint32_t)value;
+}
@@ -4,7 +4,7 @@
  * @author      Diamond Sparrow
  * @version     1.0.0.0
  * @date        2016-10-04
- * @brief       This is C header file template.
+ * @brief       Low pass, high pass and Kalman filters in fixed point with double wrappers.
  **********************************************************************************************************************
  * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
  *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
@@ -27,18 +27,27 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
 
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
+#define FILTERS_Q15_ONE     32768   //!< 1.0 in Q15, not representable in @ref q15_t.
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
+/** Constant coefficient 0.0 to 1.0 in Q15, 1.0 saturates to largest value. */
+#define FILTERS_Q15(X)      ((q15_t)((X) >= 1.0 ? INT16_MAX : (X) <= 0.0 ? 0 : (X) * FILTERS_Q15_ONE + 0.5))
 
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
+/** Fixed-point value with 15 fraction bits. */
+typedef int16_t q15_t;
+/** Fixed-point value, fraction bits are chosen by user and kept by filters. */
+typedef int32_t q31_t;
+
 /**
  * @brief   Kalman filter data.
  */
@@ -71,6 +80,36 @@ typedef struct
     double cut_off; //!< Filter cut off.
 } filters_high_pass_t;
 
+/**
+ * @brief   Fixed-point Kalman filter data. Covariances share any unit, value and input share any Q format.
+ */
+typedef struct
+{
+    uint32_t process_noise_cov;     //!< Process noise covariance.
+    uint32_t measurement_noise_cov; //!< Measurement noise covariance.
+    q31_t value;                    //!< Current value.
+    uint32_t estimation_error;      //!< Estimation error covariance.
+    q15_t gain;                     //!< Kalman gain.
+} filters_kalman_q_t;
+
+/**
+ * @brief   Fixed-point low pass filter data. Input and output share any Q format.
+ */
+typedef struct
+{
+    q31_t output;   //!< Output value.
+    q15_t cut_off;  //!< Filter cut off.
+} filters_low_pass_q_t;
+
+/**
+ * @brief   Fixed-point high pass filter data. Input and output share any Q format.
+ */
+typedef struct
+{
+    q31_t output;   //!< Output value.
+    q15_t cut_off;  //!< Filter cut off.
+} filters_high_pass_q_t;
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -124,6 +163,68 @@ double filter_low_pass(filters_low_pass_t *data, double input, double cut_off);
  */
 double filter_high_pass(filters_high_pass_t *data, double input, double cut_off);
 
+/**
+ * @brief   Saturate value to Q31 range.
+ *
+ * @param   value   Value.
+ *
+ * @return  Saturated value.
+ */
+q31_t filters_q31_sat(int64_t value);
+
+/**
+ * @brief   Multiply by Q15 coefficient and saturate.
+ *
+ * @param   value   Value in any Q format.
+ * @param   coef    Coefficient.
+ *
+ * @return  Product in Q format of value.
+ */
+q31_t filters_q31_mul(int64_t value, q15_t coef);
+
+/**
+ * @brief   Initialize fixed-point kalman filter.
+ *
+ * @param   proc_noise_cov  Process noise covariance.
+ * @param   meas_noise_cov  Measurement noise covariance.
+ * @param   est_error       Estimation error covariance.
+ * @param   value           Initial value.
+ *
+ * @return  Initialized kalman data structure. See @ref filters_kalman_q_t.
+ */
+filters_kalman_q_t filter_kalman_q_init(uint32_t proc_noise_cov, uint32_t meas_noise_cov, uint32_t est_error,
+    q31_t value);
+
+/**
+ * @brief   Update fixed-point kalman filter.
+ *
+ * @param   data    Kalman filter data. See @ref filters_kalman_q_t.
+ * @param   input   Input value.
+ *
+ * @return  Kalman filter output value.
+ */
+q31_t filters_kalman_q_update(filters_kalman_q_t *data, q31_t input);
+
+/**
+ * @brief   Fixed-point low pass filter.
+ *
+ * @param   data    Low pass filter data, cut off is set by user. See @ref filters_low_pass_q_t.
+ * @param   input   Input value.
+ *
+ * @return  Output value of low pass filter.
+ */
+q31_t filter_low_pass_q(filters_low_pass_q_t *data, q31_t input);
+
+/**
+ * @brief   Fixed-point high pass filter.
+ *
+ * @param   data    High pass filter data, cut off is set by user. See @ref filters_high_pass_q_t.
+ * @param   input   Input value.
+ *
+ * @return  Output value of high pass filter.
+ */
+q31_t filter_high_pass_q(filters_high_pass_q_t *data, q31_t input);
+
 #ifdef __cplusplus
 }
 #endif
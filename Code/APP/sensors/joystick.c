@@ -22,12 +22,16 @@
  *********************************************************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
-#include <math.h>
+#include <stddef.h>
 
 #include "sensors/joystick.h"
+#include "sensors/filter_bank.h"
 
 #include "periph/adc.h"
 #include "periph/gpio.h"
+#include "common.h"
+#include "imath.h"
+#include "chip.h"
 
 #include "cmsis_os2.h"
 
@@ -36,41 +40,98 @@
  *********************************************************************************************************************/
 #define JOYSTICK_RESOLUTION     1024
 #define JOYSTICK_ADC_RES        4096
-#define JOYSTICK_PI             3.14159265358979f
-#define JOYSTICK_CAL_COUNT      10
+#define JOYSTICK_RAW_BITS       16      //!< Samples of pipeline are scaled to this many bits.
+#define JOYSTICK_RATE           200     //!< Axis sample rate in Hz, ADC keeps 64 samples so reads can be 320 ms apart.
+#define JOYSTICK_BLOCK          64      //!< Samples processed at once, same as ADC output buffer.
+#define JOYSTICK_CAL_COUNT      32      //!< Samples averaged for center.
+#define JOYSTICK_CAL_TIMEOUT    100     //!< Maximum wait for single sample during calibration in ms.
+#define JOYSTICK_DEAD_ZONE      64      //!< Half width of dead zone around zero in ADC counts.
+#define JOYSTICK_DEAD_ZONE_HYST 16      //!< Dead zone hysteresis in ADC counts.
+#define JOYSTICK_SPAN_DEFAULT   0x4000  //!< Distance of min and max from center before they are learned, 16 bit.
+#define JOYSTICK_SPAN_MIN       0x2000  //!< Smallest accepted distance of min and max from center, 16 bit.
+#define JOYSTICK_EXPO           30      //!< Default expo in percent.
+#define JOYSTICK_RATE_SCALE     100     //!< Default rate in percent.
+#define JOYSTICK_SMOOTH_FREQ    8       //!< Cut off of output smoothing in Hz.
+#define JOYSTICK_SMOOTH_FRAC    8       //!< Fraction bits of smoothed output.
+#define JOYSTICK_EEPROM_ADDR    0x0000  //!< EEPROM address of calibration records.
+#define JOYSTICK_EEPROM_MAGIC   0x4A533130  //!< "JS10", calibration record marker.
+#define JOYSTICK_SAVE_PERIOD    5000    //!< Minimum time between calibration writes in ms.
 #define JOYSTICK_X_INVERT       1
 #define JOYSTICK_Y_INVERT       0
 
-
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
+#define JOYSTICK_DEAD_ZONE_RAW  (JOYSTICK_DEAD_ZONE << (JOYSTICK_RAW_BITS - 12))
 
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
+typedef enum
+{
+    JOYSTICK_AXIS_X,
+    JOYSTICK_AXIS_Y,
+    JOYSTICK_AXIS_LAST,
+} joystick_axis_id_t;
+
+typedef struct
+{
+    adc_id_t adc;
+    adc_reader_t reader;        //!< Own reader, streaming or calibrating channel does not take samples.
+    bool invert;
+    uint8_t shift;              //!< Shift of ADC samples to @ref JOYSTICK_RAW_BITS.
+    uint16_t zero;              //!< Center, 16 bit.
+    uint16_t min;               //!< Lowest value seen, 16 bit.
+    uint16_t max;               //!< Highest value seen, 16 bit.
+    uint32_t scale_neg;         //!< Reciprocal of span below dead zone in Q16.
+    uint32_t scale_pos;         //!< Reciprocal of span above dead zone in Q16.
+    filter_bank_iir_t smooth;
+    int16_t out;
+} joystick_axis_t;
+
 typedef struct
 {
-    adc_id_t x;
-    adc_id_t y;
+    joystick_axis_t axis[JOYSTICK_AXIS_LAST];
     gpio_t sw;
-    uint16_t x_zero;
-    uint16_t y_zero;
+    uint16_t expo;              //!< Expo in Q8.
+    uint16_t rate;              //!< Rate in Q8.
+    bool dirty;                 //!< Calibration differs from stored one.
+    uint32_t saved;             //!< Tick of last calibration write.
+    joystick_cb_t cb;
+    volatile bool active;
 } joystick_config_t;
 
+/**
+ * @brief   Calibration record in EEPROM.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t zero[JOYSTICK_AXIS_LAST];
+    uint16_t min[JOYSTICK_AXIS_LAST];
+    uint16_t max[JOYSTICK_AXIS_LAST];
+    uint32_t check;             //!< Complement of 16 bit word sum of fields above.
+} joystick_store_t;
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
 joystick_config_t joystick_config[JOYSTICK_ID_LAST] =
 {
     {
-        .x = ADC_ID_JS_X,
-        .y = ADC_ID_JS_Y,
+        .axis =
+        {
+            {.adc = ADC_ID_JS_X, .invert = JOYSTICK_X_INVERT},
+            {.adc = ADC_ID_JS_Y, .invert = JOYSTICK_Y_INVERT},
+        },
         .sw = GPIO_SW_JS,
-        .x_zero = (JOYSTICK_ADC_RES / 2),
-        .y_zero = (JOYSTICK_ADC_RES / 2),
     },
 };
+static filter_bank_biquad_t joystick_smooth_coef = {0};
+static osMutexId_t joystick_lock_id = NULL;
+static uint16_t joystick_raw[JOYSTICK_BLOCK] = {0};
+static int32_t joystick_data[JOYSTICK_BLOCK] = {0};
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -78,16 +139,62 @@ joystick_config_t joystick_config[JOYSTICK_ID_LAST] =
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static void joystick_update(joystick_id_t id);
+static int32_t joystick_shape(const joystick_config_t *js, const joystick_axis_t *axis, uint16_t value);
+static void joystick_span_set(joystick_axis_t *axis, bool reset);
+static bool joystick_center(joystick_axis_t *axis);
+static bool joystick_load(joystick_id_t id);
+static bool joystick_save(joystick_id_t id);
+static uint32_t joystick_store_check(const joystick_store_t *store);
+static void joystick_dead_zone_set(adc_id_t adc, uint16_t zero);
+static void joystick_dead_zone_cb(adc_id_t adc, adc_range_t range, uint16_t value);
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
 bool joystick_init(void)
 {
+    adc_filter_cfg_t cfg = {0};
+    joystick_axis_t *axis = NULL;
     uint8_t i = 0;
+    uint8_t j = 0;
+
+    if((joystick_lock_id = osMutexNew(NULL)) == NULL)
+    {
+        return false;
+    }
 
     for(i = 0; i < JOYSTICK_ID_LAST; i++)
     {
+        for(j = 0; j < JOYSTICK_AXIS_LAST; j++)
+        {
+            axis = &joystick_config[i].axis[j];
+            if(adc_set_rate(axis->adc, JOYSTICK_RATE) == false)
+            {
+                return false;
+            }
+            adc_get_filter(axis->adc, &cfg);
+            adc_reader_init(&axis->reader, axis->adc);
+            axis->shift = JOYSTICK_RAW_BITS - 12 - cfg.bits;
+            axis->zero = 1UL << (JOYSTICK_RAW_BITS - 1);
+            joystick_span_set(axis, true);
+        }
+        joystick_config[i].dirty = joystick_load((joystick_id_t)i) == false;
+        joystick_set_curve((joystick_id_t)i, JOYSTICK_EXPO, JOYSTICK_RATE_SCALE);
+    }
+
+    /* Both axes have same rate, so they share smoothing coefficients */
+    if(filter_bank_biquad_design(&joystick_smooth_coef, FILTER_BANK_LOW_PASS, (float)adc_get_rate(ADC_ID_JS_X),
+        JOYSTICK_SMOOTH_FREQ, 0.7071f) == false)
+    {
+        return false;
+    }
+    for(i = 0; i < JOYSTICK_ID_LAST; i++)
+    {
+        for(j = 0; j < JOYSTICK_AXIS_LAST; j++)
+        {
+            filter_bank_iir_init(&joystick_config[i].axis[j].smooth, &joystick_smooth_coef, 1, 1);
+        }
         joystick_calibrate((joystick_id_t)i);
     }
 
@@ -96,94 +203,89 @@ bool joystick_init(void)
 
 void joystick_calibrate(joystick_id_t id)
 {
-    uint8_t i = JOYSTICK_CAL_COUNT;
-    uint32_t x = 0;
-    uint32_t y = 0;
+    joystick_config_t *js = &joystick_config[id];
+    joystick_axis_t *axis = NULL;
+    uint16_t zero = 0;
+    uint8_t i = 0;
 
-    while(i--)
+    osMutexAcquire(joystick_lock_id, osWaitForever);
+    for(i = 0; i < JOYSTICK_AXIS_LAST; i++)
     {
-        x += adc_get_value_raw(joystick_config[id].x);
-        y += adc_get_value_raw(joystick_config[id].y);
-        osDelay(1);
+        axis = &js->axis[i];
+        zero = axis->zero;
+        if(joystick_center(axis) == false)
+        {
+            continue;
+        }
+        if(axis->zero > zero + JOYSTICK_DEAD_ZONE_RAW || axis->zero + JOYSTICK_DEAD_ZONE_RAW < zero)
+        {
+            js->dirty = true;
+        }
+        joystick_span_set(axis, false);
+        joystick_dead_zone_set(axis->adc, axis->zero >> (JOYSTICK_RAW_BITS - 12));
     }
-    joystick_config[id].x_zero = x / JOYSTICK_CAL_COUNT;
-    joystick_config[id].y_zero = y / JOYSTICK_CAL_COUNT;
+    osMutexRelease(joystick_lock_id);
 
     return;
 }
 
-int16_t joystick_get_x(joystick_id_t id)
+void joystick_cal_reset(joystick_id_t id)
 {
-    uint32_t x = adc_get_value_raw(joystick_config[id].x);
+    uint8_t i = 0;
 
-    if(x > joystick_config[id].x_zero)
+    osMutexAcquire(joystick_lock_id, osWaitForever);
+    for(i = 0; i < JOYSTICK_AXIS_LAST; i++)
     {
-#if JOYSTICK_X_INVERT
-        return -(((x - joystick_config[id].x_zero) * JOYSTICK_RESOLUTION) / (JOYSTICK_ADC_RES - joystick_config[id].x_zero));
-#else
-        return (((x - joystick_config[id].x_zero) * JOYSTICK_RESOLUTION) / (JOYSTICK_ADC_RES - joystick_config[id].x_zero));
-#endif
+        joystick_span_set(&joystick_config[id].axis[i], true);
     }
+    joystick_config[id].dirty = true;
+    osMutexRelease(joystick_lock_id);
+
+    return;
+}
 
-    if(x < joystick_config[id].x_zero)
+bool joystick_set_curve(joystick_id_t id, uint8_t expo, uint8_t rate)
+{
+    if(expo > 100 || rate == 0 || rate > 200)
     {
-#if JOYSTICK_X_INVERT
-        return (((joystick_config[id].x_zero - x) * JOYSTICK_RESOLUTION) / joystick_config[id].x_zero);
-#else
-        return -(((joystick_config[id].x_zero - x) * JOYSTICK_RESOLUTION) / joystick_config[id].x_zero);
-#endif
+        return false;
     }
 
-    return 0;
+    joystick_config[id].expo = (expo * 256 + 50) / 100;
+    joystick_config[id].rate = (rate * 256 + 50) / 100;
+
+    return true;
 }
 
-int16_t joystick_get_y(joystick_id_t id)
+int16_t joystick_get_x(joystick_id_t id)
 {
-    uint32_t y = adc_get_value_raw(joystick_config[id].y);
+    joystick_update(id);
 
-    if(y > joystick_config[id].y_zero)
-    {
-#if JOYSTICK_Y_INVERT
-        return -(((y - joystick_config[id].y_zero) * JOYSTICK_RESOLUTION) / (JOYSTICK_ADC_RES - joystick_config[id].y_zero));
-#else
-        return (((y - joystick_config[id].y_zero) * JOYSTICK_RESOLUTION) / (JOYSTICK_ADC_RES - joystick_config[id].y_zero));
-#endif
-    }
+    return joystick_config[id].axis[JOYSTICK_AXIS_X].out;
+}
 
-    if(y < joystick_config[id].y_zero)
-    {
-#if JOYSTICK_Y_INVERT
-        return (((joystick_config[id].y_zero - y) * JOYSTICK_RESOLUTION) / joystick_config[id].y_zero);
-#else
-        return -(((joystick_config[id].y_zero - y) * JOYSTICK_RESOLUTION) / joystick_config[id].y_zero);
-#endif
-    }
+int16_t joystick_get_y(joystick_id_t id)
+{
+    joystick_update(id);
 
-    return 0;
+    return joystick_config[id].axis[JOYSTICK_AXIS_Y].out;
 }
 
 void joystick_get_vector(joystick_id_t id, int32_t *magnitude, int32_t *direction)
 {
-    double magn = 0;
-    double dir = 0;
-    int16_t x = joystick_get_x(id);
-    int16_t y = joystick_get_y(id);
+    uint32_t magn = 0;
+    int32_t x = joystick_get_x(id);
+    int32_t y = joystick_get_y(id);
 
-    magn = sqrt(pow(x, 2) + pow(y, 2));
-    if(magn > 1024)
+    magn = imath_sqrt((uint32_t)(x * x + y * y));
+    if(magn > JOYSTICK_RESOLUTION)
     {
         magn = JOYSTICK_RESOLUTION;
     }
 
-    dir = atan2(x, y);
-    if(dir < 0)
-    {
-        dir += 2 * JOYSTICK_PI;
-    }
-    dir = dir * 180 / JOYSTICK_PI;
-
+    /* Direction is measured from Y axis towards X axis */
     *magnitude = (int32_t)magn;
-    *direction = (int32_t)dir;
+    *direction = IMATH_ANGLE_TO_DEG(imath_atan2(x, y));
 
     return;
 }
@@ -193,6 +295,275 @@ bool joystick_get_sw(joystick_id_t id)
     return gpio_input_get(joystick_config[id].sw);
 }
 
+bool joystick_is_active(joystick_id_t id)
+{
+    return joystick_config[id].active;
+}
+
+void joystick_set_cb(joystick_id_t id, joystick_cb_t cb)
+{
+    joystick_config[id].cb = cb;
+
+    return;
+}
+
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+/**
+ * @brief   Run samples received since last update through pipeline: min and max learning, center, dead zone,
+ *          scaling, expo and rate curve and output smoothing. Saves learned calibration while stick is in dead zone.
+ */
+static void joystick_update(joystick_id_t id)
+{
+    joystick_config_t *js = &joystick_config[id];
+    joystick_axis_t *axis = NULL;
+    uint16_t count = 0;
+    uint16_t value = 0;
+    uint16_t i = 0;
+    uint8_t j = 0;
+    int32_t out = 0;
+
+    osMutexAcquire(joystick_lock_id, osWaitForever);
+    for(j = 0; j < JOYSTICK_AXIS_LAST; j++)
+    {
+        axis = &js->axis[j];
+        if((count = adc_read(&axis->reader, joystick_raw, JOYSTICK_BLOCK, NULL)) == 0)
+        {
+            continue;
+        }
+        for(i = 0; i < count; i++)
+        {
+            value = joystick_raw[i] << axis->shift;
+            if(value < axis->min || value > axis->max)
+            {
+                axis->min = MIN(axis->min, value);
+                axis->max = MAX(axis->max, value);
+                joystick_span_set(axis, false);
+                js->dirty = true;
+            }
+            joystick_data[i] = joystick_shape(js, axis, value);
+        }
+        filter_bank_iir_process(&axis->smooth, joystick_data, count);
+        out = (joystick_data[count - 1] + (1L << (JOYSTICK_SMOOTH_FRAC - 1))) >> JOYSTICK_SMOOTH_FRAC;
+        axis->out = (int16_t)MAX(MIN(out, JOYSTICK_RESOLUTION), -JOYSTICK_RESOLUTION);
+    }
+
+    if(js->dirty == true && js->active == false && osKernelGetTickCount() - js->saved >= JOYSTICK_SAVE_PERIOD)
+    {
+        js->saved = osKernelGetTickCount();
+        js->dirty = joystick_save(id) == false;
+    }
+    osMutexRelease(joystick_lock_id);
+
+    return;
+}
+
+/**
+ * @brief   Map 16 bit sample to -1024 to 1024 output before smoothing, without divisions.
+ */
+static int32_t joystick_shape(const joystick_config_t *js, const joystick_axis_t *axis, uint16_t value)
+{
+    int32_t x = (int32_t)value - axis->zero;
+
+    if(x > JOYSTICK_DEAD_ZONE_RAW)
+    {
+        x = (int32_t)(((uint32_t)(x - JOYSTICK_DEAD_ZONE_RAW) * axis->scale_pos) >> 16);
+    }
+    else if(x < -JOYSTICK_DEAD_ZONE_RAW)
+    {
+        x = -(int32_t)(((uint32_t)(-x - JOYSTICK_DEAD_ZONE_RAW) * axis->scale_neg) >> 16);
+    }
+    else
+    {
+        return 0;
+    }
+    x = MAX(MIN(x, JOYSTICK_RESOLUTION), -JOYSTICK_RESOLUTION);
+
+    /* Expo: x * ((1 - e) + e * x^2), x is 1.0 at full resolution */
+    x = (int32_t)(((int64_t)x * ((256 - js->expo) * (JOYSTICK_RESOLUTION * JOYSTICK_RESOLUTION) + js->expo * x * x)) >>
+        (8 + 20));
+    x = (x * js->rate) >> 8;
+    x = MAX(MIN(x, JOYSTICK_RESOLUTION), -JOYSTICK_RESOLUTION);
+
+    return (axis->invert == true ? -x : x) * (1L << JOYSTICK_SMOOTH_FRAC);
+}
+
+/**
+ * @brief   Recalculate reciprocal scale factors of axis after center, min or max change.
+ *
+ * @param   axis    Axis.
+ * @param   reset   Forget learned min and max.
+ */
+static void joystick_span_set(joystick_axis_t *axis, bool reset)
+{
+    uint32_t span = 0;
+
+    if(reset == true || axis->min + JOYSTICK_SPAN_MIN > axis->zero)
+    {
+        axis->min = axis->zero > JOYSTICK_SPAN_DEFAULT ? axis->zero - JOYSTICK_SPAN_DEFAULT : 0;
+    }
+    if(reset == true || axis->zero + JOYSTICK_SPAN_MIN > axis->max)
+    {
+        axis->max = axis->zero < UINT16_MAX - JOYSTICK_SPAN_DEFAULT ? axis->zero + JOYSTICK_SPAN_DEFAULT : UINT16_MAX;
+    }
+    /* Rounded up, so min and max reach full resolution. Center near rail still gets sane scale */
+    span = MAX((int32_t)axis->zero - axis->min - JOYSTICK_DEAD_ZONE_RAW, JOYSTICK_SPAN_MIN);
+    axis->scale_neg = (((uint32_t)JOYSTICK_RESOLUTION << 16) + span - 1) / span;
+    span = MAX((int32_t)axis->max - axis->zero - JOYSTICK_DEAD_ZONE_RAW, JOYSTICK_SPAN_MIN);
+    axis->scale_pos = (((uint32_t)JOYSTICK_RESOLUTION << 16) + span - 1) / span;
+
+    return;
+}
+
+/**
+ * @brief   Average fresh samples of axis at rest into its center.
+ *
+ * @return  False if samples did not arrive in time.
+ */
+static bool joystick_center(joystick_axis_t *axis)
+{
+    uint32_t sum = 0;
+    uint16_t count = 0;
+    uint16_t value = 0;
+    uint16_t wait = 0;
+
+    /* Drop samples taken before calibration was requested */
+    adc_reader_init(&axis->reader, axis->adc);
+
+    while(count < JOYSTICK_CAL_COUNT)
+    {
+        if(adc_read(&axis->reader, &value, 1, NULL) == 0)
+        {
+            if(wait++ >= JOYSTICK_CAL_TIMEOUT)
+            {
+                return false;
+            }
+            osDelay(1);
+            continue;
+        }
+        sum += value << axis->shift;
+        count++;
+        wait = 0;
+    }
+    axis->zero = (sum + JOYSTICK_CAL_COUNT / 2) / JOYSTICK_CAL_COUNT;
+
+    return true;
+}
+
+/**
+ * @brief   Restore calibration of joystick from EEPROM.
+ *
+ * @return  False if there is no valid record.
+ */
+static bool joystick_load(joystick_id_t id)
+{
+    joystick_store_t store = {0};
+    joystick_axis_t *axis = NULL;
+    uint8_t i = 0;
+
+    if(Chip_EEPROM_Read(JOYSTICK_EEPROM_ADDR + id * sizeof(store), (uint8_t *)&store, sizeof(store)) !=
+        IAP_CMD_SUCCESS)
+    {
+        return false;
+    }
+    if(store.magic != JOYSTICK_EEPROM_MAGIC || store.check != joystick_store_check(&store))
+    {
+        return false;
+    }
+
+    for(i = 0; i < JOYSTICK_AXIS_LAST; i++)
+    {
+        axis = &joystick_config[id].axis[i];
+        axis->zero = store.zero[i];
+        axis->min = store.min[i];
+        axis->max = store.max[i];
+        joystick_span_set(axis, false);
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Store calibration of joystick in EEPROM.
+ *
+ * @return  False if write failed.
+ */
+static bool joystick_save(joystick_id_t id)
+{
+    joystick_store_t store = {.magic = JOYSTICK_EEPROM_MAGIC};
+    uint8_t i = 0;
+
+    for(i = 0; i < JOYSTICK_AXIS_LAST; i++)
+    {
+        store.zero[i] = joystick_config[id].axis[i].zero;
+        store.min[i] = joystick_config[id].axis[i].min;
+        store.max[i] = joystick_config[id].axis[i].max;
+    }
+    store.check = joystick_store_check(&store);
+
+    return Chip_EEPROM_Write(JOYSTICK_EEPROM_ADDR + id * sizeof(store), (uint8_t *)&store, sizeof(store)) ==
+        IAP_CMD_SUCCESS;
+}
+
+static uint32_t joystick_store_check(const joystick_store_t *store)
+{
+    const uint16_t *word = (const uint16_t *)store;
+    uint32_t sum = 0;
+    uint8_t i = 0;
+
+    for(i = 0; i < offsetof(joystick_store_t, check) / sizeof(uint16_t); i++)
+    {
+        sum += word[i];
+    }
+
+    return ~sum;
+}
+
+/**
+ * @brief   Attach ADC threshold window around axis zero, so leaving dead zone is detected without polling.
+ */
+static void joystick_dead_zone_set(adc_id_t adc, uint16_t zero)
+{
+    adc_window_t window =
+    {
+        .low = zero > JOYSTICK_DEAD_ZONE ? zero - JOYSTICK_DEAD_ZONE : 0,
+        .high = zero + JOYSTICK_DEAD_ZONE < JOYSTICK_ADC_RES ? zero + JOYSTICK_DEAD_ZONE : JOYSTICK_ADC_RES - 1,
+        .hysteresis = JOYSTICK_DEAD_ZONE_HYST,
+        .cb = joystick_dead_zone_cb,
+    };
+
+    adc_set_window(adc, &window);
+
+    return;
+}
+
+static void joystick_dead_zone_cb(adc_id_t adc, adc_range_t range, uint16_t value)
+{
+    uint8_t i = 0;
+    bool active = false;
+
+    UNUSED_PARAMETER(range);
+    UNUSED_PARAMETER(value);
+
+    for(i = 0; i < JOYSTICK_ID_LAST; i++)
+    {
+        if(joystick_config[i].axis[JOYSTICK_AXIS_X].adc != adc && joystick_config[i].axis[JOYSTICK_AXIS_Y].adc != adc)
+        {
+            continue;
+        }
+        active = adc_get_range(joystick_config[i].axis[JOYSTICK_AXIS_X].adc) != ADC_RANGE_INSIDE ||
+            adc_get_range(joystick_config[i].axis[JOYSTICK_AXIS_Y].adc) != ADC_RANGE_INSIDE;
+        if(active == joystick_config[i].active)
+        {
+            continue;
+        }
+        joystick_config[i].active = active;
+        if(joystick_config[i].cb != NULL)
+        {
+            joystick_config[i].cb((joystick_id_t)i, active);
+        }
+    }
+
+    return;
+}
@@ -27,6 +27,8 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported constants
@@ -45,6 +47,14 @@ typedef enum
     JOYSTICK_ID_LAST,
 } joystick_id_t;
 
+/**
+ * @brief   Dead zone callback. Called from interrupt context when stick leaves or returns to dead zone.
+ *
+ * @param   id      Joystick ID.
+ * @param   active  True if stick is out of dead zone.
+ */
+typedef void (*joystick_cb_t)(joystick_id_t id, bool active);
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -53,11 +63,39 @@ typedef enum
  * Prototypes of exported functions
  *********************************************************************************************************************/
 bool joystick_init(void);
+
+/**
+ * @brief   Measure center of joystick at rest. Learned min and max are kept, calibration is stored in EEPROM once
+ *          stick is back in dead zone.
+ *
+ * @param   id  Joystick ID.
+ */
 void joystick_calibrate(joystick_id_t id);
+
+/**
+ * @brief   Forget learned min and max of joystick, so they are learned again from full deflections.
+ *
+ * @param   id  Joystick ID.
+ */
+void joystick_cal_reset(joystick_id_t id);
+
+/**
+ * @brief   Set response curve of joystick axes, output = rate * x * ((1 - expo) + expo * x^2).
+ *
+ * @param   id      Joystick ID.
+ * @param   expo    Expo in percent, 0 for linear, 100 for cubic.
+ * @param   rate    Rate in percent, 1 to 200. Output saturates at full scale.
+ *
+ * @return  False if parameters are out of range.
+ */
+bool joystick_set_curve(joystick_id_t id, uint8_t expo, uint8_t rate);
+
 int16_t joystick_get_x(joystick_id_t id);
 int16_t joystick_get_y(joystick_id_t id);
 void joystick_get_vector(joystick_id_t id, int32_t *magnitude, int32_t *direction);
 bool joystick_get_sw(joystick_id_t id);
+bool joystick_is_active(joystick_id_t id);
+void joystick_set_cb(joystick_id_t id, joystick_cb_t cb);
 
 
 #ifdef __cplusplus
@@ -29,7 +29,9 @@
 #include "sensors/am2301.h"
 #include "sensors/dht11.h"
 #include "sensors/filters.h"
+#include "display/display.h"
 
+#include "common.h"
 #include "debug.h"
 #include "cmsis_os2.h"
 
@@ -44,6 +46,8 @@ const osThreadAttr_t sensors_thread_attr =
     .priority = osPriorityNormal,
 };
 
+#define SENSORS_LIGHT_FRAC  4   //!< Fraction bits of filtered light level.
+
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
@@ -57,7 +61,7 @@ const osThreadAttr_t sensors_thread_attr =
  *********************************************************************************************************************/
 /** Display thread ID. */
 osThreadId_t sensors_thread_id;
-filters_low_pass_t sensors_light_lp_filter = {0};
+filters_low_pass_q_t sensors_light_lp_filter = {.cut_off = FILTERS_Q15(0.25)};
 volatile sensors_data_t sensors_data = {0};
 
 /**********************************************************************************************************************
@@ -67,13 +71,14 @@ volatile sensors_data_t sensors_data = {0};
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static void sensors_light_cb(uint16_t level, uint32_t time);
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
 bool sensors_init(void)
 {
-    sensors_data.light.state = bh1750_init(BH1750_MODE_CONT_HIGH_RES);
+    sensors_data.light.state = bh1750_init(BH1750_MODE_CONT_HIGH_RES) && bh1750_start(sensors_light_cb);
     dht11_init();
 
     // Create sensors thread.
@@ -90,30 +95,16 @@ bool sensors_init(void)
 void sensors_thread(void *arguments)
 {
     dht11_data_t dht11_data = {0};
-    uint16_t light = 0;
 
     osDelay(10);
 
     while(1)
     {
-        if(sensors_data.light.state)
-        {
-            light = bh1750_read_level();
-            if(light != UINT16_MAX)
-            {
-                sensors_data.light.value = light;
-                sensors_data.light.value_lp = (uint16_t)filter_low_pass(&sensors_light_lp_filter, (double)light, 0.25);
-            }
-            else
-            {
-                sensors_data.light.state = false;
-            }
-        }
-        else
+        /* Light level is read by I2C scheduler, restart it after failure */
+        if(sensors_data.light.state == false)
         {
-            sensors_data.light.state = bh1750_init(BH1750_MODE_CONT_HIGH_RES);
+            sensors_data.light.state = bh1750_init(BH1750_MODE_CONT_HIGH_RES) && bh1750_start(sensors_light_cb);
         }
-        osDelay(1);
         if(dht11_read(&dht11_data) == true)
         {
             sensors_data.humidity.state = true;
@@ -140,3 +131,27 @@ void sensors_thread(void *arguments)
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+static void sensors_light_cb(uint16_t level, uint32_t time)
+{
+    uint16_t light_lp = 0;
+
+    UNUSED_PARAMETER(time);
+
+    if(level == UINT16_MAX)
+    {
+        bh1750_stop();
+        sensors_data.light.state = false;
+        return;
+    }
+
+    sensors_data.light.value = level;
+    light_lp = (uint16_t)(filter_low_pass_q(&sensors_light_lp_filter, (q31_t)level << SENSORS_LIGHT_FRAC) >>
+        SENSORS_LIGHT_FRAC);
+    if(light_lp != sensors_data.light.value_lp)
+    {
+        sensors_data.light.value_lp = light_lp;
+        display_notify();
+    }
+
+    return;
+}
@@ -0,0 +1,274 @@
+/**
+ **********************************************************************************************************************
+ * @file         spi_bus.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Shared SPI bus with per device profiles.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "chip.h"
+#include "cmsis_os2.h"
+
+#include "spi_bus.h"
+#include "periph/spi.h"
+#include "periph/gpio.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   SPI settings and chip select of device.
+ */
+typedef struct
+{
+    uint16_t clk_div;   //!< SPI clock divider, SPI clock = system clock / (clk_div + 1).
+    uint8_t mode;       //!< SPI mode, 0 - 3.
+    gpio_t select;      //!< Active low chip select.
+} spi_bus_profile_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/* Device profiles */
+static const spi_bus_profile_t spi_bus_profiles[SPI_BUS_DEVICE_LAST] =
+{
+    [SPI_BUS_DEVICE_DISPLAY] = {.clk_div = 4, .mode = 0, .select = GPIO_DISPLAY_SELECT},
+    [SPI_BUS_DEVICE_RADIO] = {.clk_div = 8, .mode = 0, .select = GPIO_NRF214L01_CSN},
+};
+
+/* Bus lock. Semaphore and not mutex, display flush gives bus back from DMA interrupt and RTX mutex can only be
+ * released by its owner thread. Priority inheritance of mutex is done here, see spi_bus_boost. */
+static osSemaphoreId_t spi_bus_lock_id = NULL;
+/* Thread owning bus and its own priority, owner is cleared on release */
+static volatile osThreadId_t spi_bus_owner = NULL;
+static volatile osPriority_t spi_bus_owner_priority = osPriorityNone;
+/* Thread running at priority of waiter and its own priority to go back to */
+static osThreadId_t spi_bus_boosted = NULL;
+static osPriority_t spi_bus_boosted_priority = osPriorityNone;
+/* Device SPI-0 is configured for, profile is not reapplied for back to back grants of same device */
+static spi_bus_device_t spi_bus_profile = SPI_BUS_DEVICE_LAST;
+/* System timer count when bus was granted */
+static uint32_t spi_bus_start = 0;
+/* Statistics per device, 64 bit totals are updated and copied with interrupts disabled */
+static spi_bus_stats_t spi_bus_stats[SPI_BUS_DEVICE_LAST];
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static uint32_t spi_bus_elapsed_us(uint32_t start);
+static void spi_bus_boost(osThreadId_t waiter);
+static void spi_bus_unboost(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool spi_bus_init(void)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < SPI_BUS_DEVICE_LAST; i++)
+    {
+        gpio_output_high(spi_bus_profiles[i].select);
+    }
+
+    if((spi_bus_lock_id = osSemaphoreNew(1, 1, NULL)) == NULL)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool spi_bus_acquire(spi_bus_device_t device, uint32_t timeout)
+{
+    osThreadId_t self = osThreadGetId();
+    uint32_t start = osKernelGetSysTimerCount();
+    uint32_t wait = 0;
+    osStatus_t status = osOK;
+
+    if(device >= SPI_BUS_DEVICE_LAST)
+    {
+        return false;
+    }
+
+    /* Busy bus, owner runs at waiter priority until release, so threads in between can not hold it off */
+    if((status = osSemaphoreAcquire(spi_bus_lock_id, 0)) != osOK && timeout != 0)
+    {
+        spi_bus_boost(self);
+        status = osSemaphoreAcquire(spi_bus_lock_id, timeout);
+    }
+    /* Previous owner is done with bus, or waiting gave up */
+    spi_bus_unboost();
+    if(status != osOK)
+    {
+        return false;
+    }
+    spi_bus_owner_priority = osThreadGetPriority(self);
+    spi_bus_owner = self;
+
+    spi_bus_start = osKernelGetSysTimerCount();
+    wait = spi_bus_elapsed_us(start);
+    __disable_irq();
+    spi_bus_stats[device].count++;
+    spi_bus_stats[device].wait_us += wait;
+    if(wait > spi_bus_stats[device].wait_max_us)
+    {
+        spi_bus_stats[device].wait_max_us = wait;
+    }
+    __enable_irq();
+
+    if(spi_bus_profile != device)
+    {
+        spi_0_set_config(spi_bus_profiles[device].clk_div, spi_bus_profiles[device].mode);
+        spi_bus_profile = device;
+    }
+    gpio_output_low(spi_bus_profiles[device].select);
+
+    return true;
+}
+
+void spi_bus_release(spi_bus_device_t device)
+{
+    if(device >= SPI_BUS_DEVICE_LAST)
+    {
+        return;
+    }
+
+    gpio_output_high(spi_bus_profiles[device].select);
+    __disable_irq();
+    spi_bus_stats[device].busy_us += spi_bus_elapsed_us(spi_bus_start);
+    __enable_irq();
+    spi_bus_owner = NULL;
+    /* Priority can not be set from interrupt, next acquire drops it then */
+    if(__get_IPSR() == 0)
+    {
+        spi_bus_unboost();
+    }
+    osSemaphoreRelease(spi_bus_lock_id);
+
+    return;
+}
+
+bool spi_bus_transfer(spi_bus_device_t device, const spi_bus_xfer_t *xfers, uint32_t count, uint32_t timeout)
+{
+    uint32_t i = 0;
+
+    if(spi_bus_acquire(device, timeout) == false)
+    {
+        return false;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        spi_0_write_read(xfers[i].tx, xfers[i].tx_size, xfers[i].rx, xfers[i].rx_size);
+    }
+
+    spi_bus_release(device);
+
+    return true;
+}
+
+void spi_bus_get_stats(spi_bus_device_t device, spi_bus_stats_t *stats)
+{
+    if(device >= SPI_BUS_DEVICE_LAST)
+    {
+        return;
+    }
+
+    __disable_irq();
+    *stats = spi_bus_stats[device];
+    __enable_irq();
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static uint32_t spi_bus_elapsed_us(uint32_t start)
+{
+    return (osKernelGetSysTimerCount() - start) / (osKernelGetSysTimerFreq() / 1000000);
+}
+
+/**
+ * @brief   Lend priority of waiting thread to bus owner.
+ *
+ * @param   waiter  Thread about to wait for bus.
+ */
+static void spi_bus_boost(osThreadId_t waiter)
+{
+    osPriority_t priority = osThreadGetPriority(waiter);
+    osThreadId_t owner = NULL;
+    int32_t lock = 0;
+
+    /* Thread still running at lent priority after its release from interrupt goes back first */
+    spi_bus_unboost();
+
+    lock = osKernelLock();
+    owner = spi_bus_owner;
+    if(owner != NULL && owner != waiter && priority > osThreadGetPriority(owner))
+    {
+        if(spi_bus_boosted != owner)
+        {
+            spi_bus_boosted = owner;
+            spi_bus_boosted_priority = spi_bus_owner_priority;
+        }
+        osThreadSetPriority(owner, priority);
+    }
+    osKernelRestoreLock(lock);
+
+    return;
+}
+
+/**
+ * @brief   Give thread that does not own bus anymore its own priority back.
+ */
+static void spi_bus_unboost(void)
+{
+    int32_t lock = 0;
+
+    /* Nothing lent is the usual case, kernel is not locked for it */
+    if(spi_bus_boosted == NULL)
+    {
+        return;
+    }
+
+    lock = osKernelLock();
+    if(spi_bus_boosted != NULL && spi_bus_boosted != spi_bus_owner)
+    {
+        osThreadSetPriority(spi_bus_boosted, spi_bus_boosted_priority);
+        spi_bus_boosted = NULL;
+    }
+    osKernelRestoreLock(lock);
+
+    return;
+}
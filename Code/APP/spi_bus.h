@@ -0,0 +1,135 @@
+/**
+ **********************************************************************************************************************
+ * @file        spi_bus.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Shared SPI bus with per device profiles.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SPI_BUS_H_
+#define SPI_BUS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Devices on SPI-0 bus.
+ */
+typedef enum
+{
+    SPI_BUS_DEVICE_DISPLAY, //!< SSD1306 display.
+    SPI_BUS_DEVICE_RADIO,   //!< nRF24L01 radio.
+    SPI_BUS_DEVICE_LAST,    //!< Last should stay last.
+} spi_bus_device_t;
+
+/**
+ * @brief   Single transaction: bytes sent first, then bytes received.
+ */
+typedef struct
+{
+    const uint8_t *tx;  //!< Data to send, can be NULL when tx_size is 0.
+    uint16_t tx_size;   //!< Number of bytes to send.
+    uint8_t *rx;        //!< Buffer for received data, can be NULL when rx_size is 0.
+    uint16_t rx_size;   //!< Number of bytes to receive.
+} spi_bus_xfer_t;
+
+/**
+ * @brief   Bus usage statistics of device.
+ */
+typedef struct
+{
+    uint32_t count;         //!< Number of times bus was granted.
+    uint32_t wait_max_us;   //!< Longest wait for bus in us.
+    uint64_t wait_us;       //!< Total time spent waiting for bus in us.
+    uint64_t busy_us;       //!< Total time bus was owned in us.
+} spi_bus_stats_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize SPI bus lock. SPI-0 peripheral must be initialized.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool spi_bus_init(void);
+
+/**
+ * @brief   Take bus for device: waits until bus is free, switches SPI-0 to device profile and asserts its chip select.
+ *          Waiting callers get the bus in their thread priority order. While they wait, owner runs at priority of
+ *          highest waiter, like with priority inheritance mutex.
+ *
+ * @param   device  Device ID. See @ref spi_bus_device_t.
+ * @param   timeout Timeout in ms or osWaitForever.
+ *
+ * @return  True if bus is taken.
+ */
+bool spi_bus_acquire(spi_bus_device_t device, uint32_t timeout);
+
+/**
+ * @brief   Deassert chip select and free bus. Can be called from interrupt, e.g. at end of DMA transfer.
+ *
+ * @param   device  Device ID that owns bus. See @ref spi_bus_device_t.
+ */
+void spi_bus_release(spi_bus_device_t device);
+
+/**
+ * @brief   Run transactions back to back under one bus grant and chip select assertion.
+ *
+ * @param   device  Device ID. See @ref spi_bus_device_t.
+ * @param   xfers   Transactions to run in order.
+ * @param   count   Number of transactions.
+ * @param   timeout Timeout to get bus in ms or osWaitForever.
+ *
+ * @return  True if transactions were done.
+ */
+bool spi_bus_transfer(spi_bus_device_t device, const spi_bus_xfer_t *xfers, uint32_t count, uint32_t timeout);
+
+/**
+ * @brief   Get bus usage statistics of device.
+ *
+ * @param   device  Device ID. See @ref spi_bus_device_t.
+ * @param   stats   Pointer to structure where statistics will be copied.
+ */
+void spi_bus_get_stats(spi_bus_device_t device, spi_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_BUS_H_ */
@@ -21,23 +21,43 @@
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 #include "adc.h"
+#include "dma.h"
+#include "pwm.h"
 
 #include "chip.h"
+#include "cmsis_os2.h"
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 #define ADC_REFERENCE               3300
 #define ADC_RESOLUTION              4096
-#define ADC_AVG_COUNT               10
+#define ADC_CHANNELS                12      //!< Channels of single ADC.
+#define ADC_CONV_CLOCKS             25      //!< ADC clocks per conversion.
+#define ADC_CONV_RATE               100000  //!< Conversions per second of each ADC, shared by its channels.
+#define ADC_BLOCK_SIZE              128     //!< Results per DMA block, ADC interrupts once per block.
+#define ADC_OUT_SIZE                64      //!< Decimated samples kept per channel, power of 2.
+#define ADC_CIC_ORDER_MAX           3       //!< Maximum number of CIC stages.
+#define ADC_WINDOW_MAX              16      //!< Maximum sliding window length.
+#define ADC_BITS_MAX                4       //!< Maximum extra resolution bits.
+#define ADC_GAIN_MAX                (1UL << 20) //!< Maximum filter gain including extra bits, keeps sums in 32 bits.
+#define ADC_THR_PAIRS               2       //!< Threshold register pairs of single ADC.
+#define ADC_CAL_SHIFT               12      //!< Fraction bits of calibration multiplier.
+#define ADC_CAL_TIMEOUT             100     //!< Maximum wait for single sample during zero calibration in ms.
 #define ADC_TEMP_SENSOR_LLS_SLOPE   (-2.29) //!< Temperature sensor Linear-Least-Square slope (mV/degC).
 #define ADC_TEMP_SENSOR_LLS_0       (577.3) //!< Temperature sensor Linear-Least-Square slope LLS intercept at 0 degC.
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
+/** Threshold comparison flags of all channels. */
+#define ADC_FLAGS_THCMP_ALL         0xFFF
+/** Millivolts per raw count, with @ref ADC_CAL_SHIFT fraction bits. */
+#define ADC_CAL_MV                  ((ADC_REFERENCE << ADC_CAL_SHIFT) / ADC_RESOLUTION)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -49,25 +69,100 @@ typedef struct
     uint8_t port;
     uint8_t pin;
     CHIP_SWM_PIN_FIXED_T sw_pin;
-    uint32_t value;
+    bool triggered;                 //!< Converted by sequence B once per motor PWM period, in middle of on-time.
+    adc_filter_cfg_t cfg;           //!< Filter configuration.
+    adc_cal_t cal;                  //!< Calibration.
+    int32_t cal_mult;               //!< Engineering units per raw count, with @ref ADC_CAL_SHIFT fraction bits.
+    volatile bool cfg_pending;      //!< Configuration changed, block interrupt restarts filter.
+    volatile uint32_t value;        //!< Last decimated sample scaled to 12 bits.
+    volatile uint32_t triggers;     //!< Conversions started by PWM trigger.
     struct
     {
-        uint32_t counter;
-        uint32_t value;
-        uint32_t accumulator;
-    } avg;
+        adc_filter_t type;
+        uint8_t order;
+        uint8_t length;
+        uint8_t bits;
+        uint16_t factor;            //!< Conversions per output sample.
+        uint16_t counter;
+        uint32_t gain;              //!< Sum of single output period, divided out on output.
+        uint32_t integ[ADC_CIC_ORDER_MAX];  //!< Integrators, only first one is used by boxcar and sliding window.
+        uint32_t comb[ADC_CIC_ORDER_MAX];   //!< Previous comb inputs.
+        uint32_t window[ADC_WINDOW_MAX];    //!< Sliding window of period sums.
+        uint32_t window_sum;
+        uint8_t window_pos;
+    } filter;
+    struct
+    {
+        adc_window_t cfg;           //!< Window, detached if callback is NULL.
+        uint8_t thr;                //!< Threshold register pair.
+        volatile adc_range_t range; //!< Range of last crossing.
+    } window;
+    struct
+    {
+        uint16_t buffer[ADC_OUT_SIZE];
+        volatile uint16_t head;     //!< Written by block interrupt, readers keep their own tail.
+    } out;
 } adc_data_t;
 
+typedef struct
+{
+    LPC_ADC_T *adc;
+    dma_id_t dma;
+    IRQn_Type thcmp_irq;            //!< Threshold compare interrupt.
+    IRQn_Type seqb_irq;             //!< Sequence B interrupt.
+    uint32_t trigger;               //!< Sequence B hardware trigger, only ADC0 has triggered channels.
+    adc_id_t thr_owner[ADC_THR_PAIRS];  //!< Channel using threshold pair, ADC_ID_LAST if free.
+    uint32_t rate;                  //!< Actual conversions per second.
+    uint8_t channels;               //!< Channels in sequence A.
+    uint8_t map[ADC_CHANNELS];      //!< ADC ID of each channel, ADC_ID_LAST if not sampled.
+    uint32_t overruns;              //!< Conversions lost before DMA read them.
+    uint32_t ring[2 * ADC_BLOCK_SIZE];
+} adc_unit_t;
+
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
+/*
+ * Temperature changes slowly and is heavily oversampled, motor currents are sampled once per PWM period where ripple
+ * crosses its average, joystick axes are sampled fast with short window.
+ */
 adc_data_t adc_data[ADC_ID_LAST] =
 {
-    {.adc = LPC_ADC0, .ch = 0,   .port = 0xFF,   .pin = 0xFF,    .sw_pin = SWM_FIXED_ADC0_0, .value = 0, {0, 0, 0}},
-    {.adc = LPC_ADC0, .ch = 2,   .port = 0,      .pin = 6,       .sw_pin = SWM_FIXED_ADC0_2, .value = 0, {0, 0, 0}},
-    {.adc = LPC_ADC0, .ch = 3,   .port = 0,      .pin = 5,       .sw_pin = SWM_FIXED_ADC0_3, .value = 0, {0, 0, 0}},
-    {.adc = LPC_ADC1, .ch = 1,   .port = 0,      .pin = 9,       .sw_pin = SWM_FIXED_ADC1_1 , .value = 0, {0, 0, 0}},
-    {.adc = LPC_ADC1, .ch = 4,   .port = 1,      .pin = 2,       .sw_pin = SWM_FIXED_ADC1_4, .value = 0, {0, 0, 0}},
+    {
+        .adc = LPC_ADC0, .ch = 0,   .port = 0xFF,   .pin = 0xFF,    .sw_pin = SWM_FIXED_ADC0_0,
+        .cfg = {.filter = ADC_FILTER_CIC, .rate = 100, .order = 2, .bits = 3},
+        .cal =
+        {
+            .offset = (int16_t)((ADC_TEMP_SENSOR_LLS_0 * ADC_RESOLUTION) / ADC_REFERENCE + 0.5),
+            .gain = ADC_CAL_GAIN_ONE,
+            .scale = (int32_t)((100 * 1000) / ADC_TEMP_SENSOR_LLS_SLOPE),
+        },
+    },
+    {
+        .adc = LPC_ADC0, .ch = 2,   .port = 0,      .pin = 6,       .sw_pin = SWM_FIXED_ADC0_2,
+        .triggered = true, .cfg = {.filter = ADC_FILTER_BOXCAR, .rate = PWM_2_RATE},
+    },
+    {
+        .adc = LPC_ADC0, .ch = 3,   .port = 0,      .pin = 5,       .sw_pin = SWM_FIXED_ADC0_3,
+        .triggered = true, .cfg = {.filter = ADC_FILTER_BOXCAR, .rate = PWM_2_RATE},
+    },
+    {
+        .adc = LPC_ADC1, .ch = 1,   .port = 0,      .pin = 9,       .sw_pin = SWM_FIXED_ADC1_1,
+        .cfg = {.filter = ADC_FILTER_MOVING, .rate = 2000, .length = 4, .bits = 2},
+    },
+    {
+        .adc = LPC_ADC1, .ch = 4,   .port = 1,      .pin = 2,       .sw_pin = SWM_FIXED_ADC1_4,
+        .cfg = {.filter = ADC_FILTER_MOVING, .rate = 2000, .length = 4, .bits = 2},
+    },
+};
+
+static adc_unit_t adc_unit[2] =
+{
+    {
+        .adc = LPC_ADC0, .dma = DMA_ID_ADC_0, .thcmp_irq = ADC0_THCMP,
+        .seqb_irq = ADC0_SEQB_IRQn, .trigger = ADC0_SEQ_CTRL_HWTRIG_SCT2_OUT3, //!< Driven by PWM_2_ADC_OUT.
+    },
+    {.adc = LPC_ADC1, .dma = DMA_ID_ADC_1, .thcmp_irq = ADC1_THCMP},
 };
 
 /**********************************************************************************************************************
@@ -79,6 +174,20 @@ adc_data_t adc_data[ADC_ID_LAST] =
  *********************************************************************************************************************/
 static void adc_0_init(void);
 static void adc_1_init(void);
+static void adc_unit_start(adc_unit_t *unit);
+static adc_unit_t *adc_unit_get(LPC_ADC_T *adc);
+static uint32_t adc_channel_rate(adc_id_t id);
+static uint32_t adc_filter_factor(adc_id_t id, uint32_t rate);
+static uint32_t adc_filter_gain(const adc_filter_cfg_t *cfg, uint32_t factor);
+static void adc_filter_apply(adc_data_t *data);
+static inline void adc_filter_sample(adc_data_t *data, uint32_t sample);
+static void adc_block_cb(dma_id_t id, const uint32_t *block, uint16_t count);
+static void adc_trigger_irq(adc_unit_t *unit);
+static bool adc_cal_mult(const adc_cal_t *cal, int32_t *mult);
+static uint8_t adc_window_thr(adc_unit_t *unit, adc_id_t id);
+static adc_range_t adc_window_classify(adc_data_t *data, uint16_t value);
+static void adc_window_arm(adc_data_t *data, adc_range_t range);
+static void adc_window_irq(adc_unit_t *unit);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -91,44 +200,259 @@ void adc_init(void)
     return;
 }
 
-uint32_t adc_get_value_raw(adc_id_t id)
+bool adc_set_filter(adc_id_t id, const adc_filter_cfg_t *cfg)
 {
-#if ADC_AVG_COUNT > 1
-    return (adc_data[id].avg.value);
-#else
-    uint32_t value = adc_data[ch].value;
+    uint32_t factor = adc_filter_factor(id, cfg->rate);
 
-    if(!(value & ADC_DR_OVERRUN) && (value & ADC_SEQ_GDAT_DATAVALID))
+    if(cfg->filter >= ADC_FILTER_LAST || cfg->bits > ADC_BITS_MAX || factor == 0)
+    {
+        return false;
+    }
+    if(cfg->filter == ADC_FILTER_CIC && (cfg->order == 0 || cfg->order > ADC_CIC_ORDER_MAX))
+    {
+        return false;
+    }
+    if(cfg->filter == ADC_FILTER_MOVING && (cfg->length == 0 || cfg->length > ADC_WINDOW_MAX))
     {
-        return ADC_DR_RESULT(value);
+        return false;
+    }
+    /* Each extra bit needs four times more conversions */
+    if(factor < (1UL << (2 * cfg->bits)) || adc_filter_gain(cfg, factor) > (ADC_GAIN_MAX >> cfg->bits))
+    {
+        return false;
     }
 
-    return UINT32_MAX;
-#endif
+    /* Block interrupt only reads configuration while it is marked pending */
+    adc_data[id].cfg_pending = false;
+    adc_data[id].cfg = *cfg;
+    adc_data[id].cfg_pending = true;
+
+    return true;
 }
 
-uint32_t adc_get_value_volt(adc_id_t id)
+void adc_get_filter(adc_id_t id, adc_filter_cfg_t *cfg)
 {
-    uint32_t value = adc_get_value_raw(id);
+    *cfg = adc_data[id].cfg;
 
-    if(value != UINT32_MAX)
+    return;
+}
+
+bool adc_set_rate(adc_id_t id, uint32_t rate)
+{
+    adc_filter_cfg_t cfg = adc_data[id].cfg;
+
+    cfg.rate = rate;
+
+    return adc_set_filter(id, &cfg);
+}
+
+uint32_t adc_get_rate(adc_id_t id)
+{
+    uint32_t factor = adc_filter_factor(id, adc_data[id].cfg.rate);
+
+    if(factor == 0)
     {
-        return (value * ADC_REFERENCE) / ADC_RESOLUTION;
+        return 0;
     }
 
-    return UINT32_MAX;
+    return adc_channel_rate(id) / factor;
 }
 
-float adc_get_temperature(void)
+uint32_t adc_get_input_rate(adc_id_t id)
 {
-    uint32_t value = adc_get_value_volt(ADC_ID_TEMPERATURE);
+    return adc_channel_rate(id);
+}
+
+bool adc_set_cal(adc_id_t id, const adc_cal_t *cal)
+{
+    int32_t mult = 0;
+
+    if(!adc_cal_mult(cal, &mult))
+    {
+        return false;
+    }
+
+    adc_data[id].cal = *cal;
+    adc_data[id].cal_mult = mult;
+
+    return true;
+}
+
+void adc_get_cal(adc_id_t id, adc_cal_t *cal)
+{
+    *cal = adc_data[id].cal;
+
+    return;
+}
+
+bool adc_cal_zero(adc_id_t id, uint16_t count)
+{
+    adc_data_t *data = &adc_data[id];
+    adc_cal_t cal = data->cal;
+    adc_reader_t reader;
+    uint16_t value = 0;
+    uint16_t i = 0;
+    uint32_t wait = 0;
+    uint32_t sum = 0;
+    uint8_t bits = data->filter.bits;
+
+    if(count == 0)
+    {
+        return false;
+    }
+
+    /* Own reader, other readers of channel keep their samples */
+    adc_reader_init(&reader, id);
+    while(i < count)
+    {
+        if(adc_read(&reader, &value, 1, NULL) == 0)
+        {
+            if(wait++ >= ADC_CAL_TIMEOUT)
+            {
+                return false;
+            }
+            osDelay(1);
+            continue;
+        }
+        sum += value;
+        i++;
+        wait = 0;
+    }
+    cal.offset = (int16_t)((sum + ((uint32_t)count << bits) / 2) / ((uint32_t)count << bits));
+
+    return adc_set_cal(id, &cal);
+}
+
+bool adc_set_window(adc_id_t id, const adc_window_t *window)
+{
+    adc_data_t *data = &adc_data[id];
+    adc_unit_t *unit = adc_unit_get(data->adc);
+    uint8_t thr = adc_window_thr(unit, id);
+
+    if(window->cb == NULL || window->low > window->high || window->high >= ADC_RESOLUTION)
+    {
+        return false;
+    }
+    if(thr >= ADC_THR_PAIRS && (thr = adc_window_thr(unit, ADC_ID_LAST)) >= ADC_THR_PAIRS)
+    {
+        return false;
+    }
+
+    NVIC_DisableIRQ(unit->thcmp_irq);
+    unit->thr_owner[thr] = id;
+    data->window.cfg = *window;
+    data->window.thr = thr;
+    if(thr == 0)
+    {
+        Chip_ADC_SelectTH0Channels(data->adc, ADC_THRSEL_CHAN_SEL_THR1(data->ch));
+    }
+    else
+    {
+        Chip_ADC_SelectTH1Channels(data->adc, ADC_THRSEL_CHAN_SEL_THR1(data->ch));
+    }
+    /* Start from range of last decimated value, first crossing is reported from there */
+    adc_window_arm(data, adc_window_classify(data, (uint16_t)data->value));
+    Chip_ADC_ClearFlags(data->adc, ADC_FLAGS_THCMP_MASK(data->ch));
+    Chip_ADC_SetThresholdInt(data->adc, data->ch, ADC_INTEN_THCMP_OUTSIDE);
+    NVIC_EnableIRQ(unit->thcmp_irq);
+
+    return true;
+}
+
+void adc_clear_window(adc_id_t id)
+{
+    adc_data_t *data = &adc_data[id];
+    adc_unit_t *unit = adc_unit_get(data->adc);
+    uint8_t thr = adc_window_thr(unit, id);
+
+    if(thr >= ADC_THR_PAIRS)
+    {
+        return;
+    }
+
+    NVIC_DisableIRQ(unit->thcmp_irq);
+    Chip_ADC_SetThresholdInt(data->adc, data->ch, ADC_INTEN_THCMP_DISABLE);
+    Chip_ADC_ClearFlags(data->adc, ADC_FLAGS_THCMP_MASK(data->ch));
+    unit->thr_owner[thr] = ADC_ID_LAST;
+    data->window.cfg.cb = NULL;
+    data->window.range = ADC_RANGE_INSIDE;
+    NVIC_EnableIRQ(unit->thcmp_irq);
+
+    return;
+}
+
+adc_range_t adc_get_range(adc_id_t id)
+{
+    return adc_data[id].window.range;
+}
+
+void adc_reader_init(adc_reader_t *reader, adc_id_t id)
+{
+    reader->id = id;
+    reader->tail = adc_data[id].out.head;
+    reader->dropped = 0;
+
+    return;
+}
+
+uint16_t adc_read(adc_reader_t *reader, uint16_t *buffer, uint16_t size, uint16_t *seq)
+{
+    adc_data_t *data = &adc_data[reader->id];
+    uint16_t head = data->out.head;
+    uint16_t count = 0;
+
+    /* Reader fell behind, oldest samples are already overwritten */
+    if((uint16_t)(head - reader->tail) > ADC_OUT_SIZE)
+    {
+        reader->dropped += (uint16_t)(head - reader->tail) - ADC_OUT_SIZE;
+        reader->tail = head - ADC_OUT_SIZE;
+    }
+    if(seq != NULL)
+    {
+        *seq = reader->tail;
+    }
+
+    while(count < size && reader->tail != head)
+    {
+        buffer[count++] = data->out.buffer[reader->tail & (ADC_OUT_SIZE - 1)];
+        reader->tail++;
+    }
+
+    return count;
+}
+
+uint32_t adc_get_trigger_count(adc_id_t id)
+{
+    return adc_data[id].triggers;
+}
+
+uint32_t adc_get_value_raw(adc_id_t id)
+{
+    return adc_data[id].value;
+}
+
+int32_t adc_get_value(adc_id_t id)
+{
+    adc_data_t *data = &adc_data[id];
+
+    return (int32_t)(((int64_t)((int32_t)data->value - data->cal.offset) * data->cal_mult) >> ADC_CAL_SHIFT);
+}
+
+uint32_t adc_get_value_volt(adc_id_t id)
+{
+    uint32_t value = adc_get_value_raw(id);
 
     if(value != UINT32_MAX)
     {
-        return (float)(((float)value  - (float)ADC_TEMP_SENSOR_LLS_0 ) / (float)ADC_TEMP_SENSOR_LLS_SLOPE);
+        return (value * ADC_CAL_MV) >> ADC_CAL_SHIFT;
     }
 
-    return 0;
+    return UINT32_MAX;
+}
+
+int32_t adc_get_temperature(void)
+{
+    return adc_get_value(ADC_ID_TEMPERATURE);
 }
 
 /**********************************************************************************************************************
@@ -141,16 +465,6 @@ static void adc_0_init(void)
     /* Setup ADC for 12-bit mode and normal power */
     Chip_ADC_Init(LPC_ADC0, 0);
 
-    /* Setup for maximum ADC clock rate */
-    Chip_ADC_SetClockRate(LPC_ADC0, ADC_MAX_SAMPLE_RATE);
-
-    /*
-     * For ADC0, seqeucner A will be used without threshold events.
-     * It will be triggered manually by the sysTick interrupt and
-     * only monitor the internal temperature sensor.
-     */
-    Chip_ADC_SetupSequencer(LPC_ADC0, ADC_SEQA_IDX, (ADC_SEQ_CTRL_CHANSEL(0) | ADC_SEQ_CTRL_CHANSEL(2) | ADC_SEQ_CTRL_CHANSEL(3) | ADC_SEQ_CTRL_BURST | ADC_SEQ_CTRL_MODE_EOS));
-
     /* Power up the internal temperature sensor */
     Chip_SYSCTL_PowerUp(SYSCTL_POWERDOWN_TS_PD);
 
@@ -179,163 +493,545 @@ static void adc_0_init(void)
     Chip_ADC_StartCalibration(LPC_ADC0);
     while (!(Chip_ADC_IsCalibrationDone(LPC_ADC0))) {}
 
-    /* Clear all pending interrupts */
-    Chip_ADC_ClearFlags(LPC_ADC0, Chip_ADC_GetFlags(LPC_ADC0));
+    adc_unit_start(&adc_unit[0]);
+
+    return;
+}
+
+static void adc_1_init(void)
+{
+    uint8_t i = 0;
 
-    /* Enable sequence A completion interrupts for ADC0 */
-    Chip_ADC_EnableInt(LPC_ADC0, ADC_INTEN_SEQA_ENABLE);
+    /* Setup ADC for 12-bit mode and normal power */
+    Chip_ADC_Init(LPC_ADC1, 0);
 
-    /* Enable related ADC NVIC interrupts */
-    NVIC_EnableIRQ(ADC0_SEQA_IRQn);
+    /* Use higher voltage trim for both ADCs */
+    //Chip_ADC_SetTrim(LPC_ADC1, ADC_TRIM_VRANGE_HIGHV);
 
-    /* Enable sequencers */
-    Chip_ADC_EnableSequencer(LPC_ADC0, ADC_SEQA_IDX);
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        if(adc_data[i].adc != LPC_ADC1)
+        {
+            continue;
+        }
+        if(adc_data[i].port != 0xFF && adc_data[i].pin != 0xFF)
+        {
+            /* Disables pullups/pulldowns and disable digital mode */
+            Chip_IOCON_PinMuxSet(LPC_IOCON, adc_data[i].port, adc_data[i].pin, (IOCON_MODE_INACT | IOCON_ADMODE_EN));
+            /* Assign ADC1_0 to PIO1_1 via SWM (fixed pin) */
+            Chip_SWM_EnableFixedPin(adc_data[i].sw_pin);
+        }
+    }
+
+    /* Need to do a calibration after initialization and trim */
+    Chip_ADC_StartCalibration(LPC_ADC1);
+    while (!(Chip_ADC_IsCalibrationDone(LPC_ADC1))) {}
+
+    adc_unit_start(&adc_unit[1]);
 
     return;
 }
 
 /**
- * @brief   Handle interrupt from ADC0 sequencer A
+ * @brief   Start sequence A of calibrated ADC in burst mode with results moved by DMA.
+ *
+ * Sequence runs in end of conversion mode, every conversion triggers DMA which stores global data word (result and
+ * channel number) into ring. Sequence interrupt is enabled only as DMA trigger, NVIC interrupt stays disabled and
+ * CPU is interrupted once per @ref ADC_BLOCK_SIZE results.
+ *
+ * @param   unit    ADC to start.
  */
-void ADC0A_IRQHandler(void)
+static void adc_unit_start(adc_unit_t *unit)
 {
     uint8_t i = 0;
-    uint32_t pending;
+    uint32_t channels = 0;
+    uint32_t triggered = 0;
+    adc_filter_cfg_t cfg;
+    adc_cal_t cal;
 
-    /* Get pending interrupts */
-    pending = Chip_ADC_GetFlags(LPC_ADC0);
+    /* Calibration leaves ADC clock at 500 kHz */
+    Chip_ADC_SetClockRate(unit->adc, ADC_CONV_RATE * ADC_CONV_CLOCKS);
+    unit->rate = Chip_Clock_GetSystemClockRate() / (Chip_ADC_GetDivider(unit->adc) + 1) / ADC_CONV_CLOCKS;
 
-    /* Sequence A completion interrupt */
-    if (pending & ADC_FLAGS_SEQA_INT_MASK)
+    for(i = 0; i < ADC_CHANNELS; i++)
+    {
+        unit->map[i] = ADC_ID_LAST;
+    }
+    for(i = 0; i < ADC_THR_PAIRS; i++)
+    {
+        unit->thr_owner[i] = ADC_ID_LAST;
+    }
+    unit->channels = 0;
+    for(i = 0; i < ADC_ID_LAST; i++)
     {
-        for(i = 0; i < ADC_ID_LAST; i++)
+        if(adc_data[i].adc != unit->adc)
+        {
+            continue;
+        }
+        unit->map[adc_data[i].ch] = i;
+        if(adc_data[i].triggered)
         {
-            if(adc_data[i].adc != LPC_ADC0)
+            triggered |= ADC_SEQ_CTRL_CHANSEL(adc_data[i].ch);
+            continue;
+        }
+        unit->channels++;
+        channels |= ADC_SEQ_CTRL_CHANSEL(adc_data[i].ch);
+    }
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        if(adc_data[i].adc == unit->adc)
+        {
+            cfg = adc_data[i].cfg;
+            adc_set_filter((adc_id_t)i, &cfg);
+            cal = adc_data[i].cal;
+            if(cal.gain == 0)
             {
-                continue;
+                cal.gain = ADC_CAL_GAIN_ONE;
             }
-            adc_data[i].value = Chip_ADC_GetDataReg(LPC_ADC0, adc_data[i].ch);
-#if ADC_AVG_COUNT > 1
-            if(adc_data[i].value & ADC_SEQ_GDAT_DATAVALID)
+            adc_set_cal((adc_id_t)i, &cal);
+        }
+    }
+
+    /*
+     * Burst keeps sequence A always active, so sequence B triggers are ignored unless sequence B has priority. Low
+     * priority bit of sequence A gives it to B, so trigger interrupts burst conversion of A. Each rising edge of PWM
+     * trigger converts next channel, so channels are converted in order of their sample points.
+     */
+    Chip_ADC_SetupSequencer(unit->adc, ADC_SEQA_IDX, channels | ADC_SEQ_CTRL_BURST | ADC_SEQ_CTRL_LOWPRIO);
+    if(triggered != 0)
+    {
+        Chip_ADC_SetupSequencer(unit->adc, ADC_SEQB_IDX,
+            triggered | unit->trigger | ADC_SEQ_CTRL_HWTRIG_POLPOS | ADC_SEQ_CTRL_SINGLESTEP);
+    }
+
+    /* Clear all pending interrupts */
+    Chip_ADC_ClearFlags(unit->adc, Chip_ADC_GetFlags(unit->adc));
+
+    /* Sequence A interrupt line is DMA trigger */
+    Chip_ADC_EnableInt(unit->adc, ADC_INTEN_SEQA_ENABLE);
+    dma_start_ring(unit->dma, unit->ring, ADC_BLOCK_SIZE, adc_block_cb);
+    if(triggered != 0)
+    {
+        Chip_ADC_EnableInt(unit->adc, ADC_INTEN_SEQB_ENABLE);
+        NVIC_EnableIRQ(unit->seqb_irq);
+    }
+
+    /* Threshold interrupts are enabled per channel when window is attached */
+    NVIC_EnableIRQ(unit->thcmp_irq);
+
+    /* Enable sequencers */
+    Chip_ADC_EnableSequencer(unit->adc, ADC_SEQA_IDX);
+    if(triggered != 0)
+    {
+        Chip_ADC_EnableSequencer(unit->adc, ADC_SEQB_IDX);
+    }
+
+    return;
+}
+
+static adc_unit_t *adc_unit_get(LPC_ADC_T *adc)
+{
+    return adc == LPC_ADC0 ? &adc_unit[0] : &adc_unit[1];
+}
+
+/**
+ * @brief   Get conversions per second of channel.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ *
+ * @return  Conversions per second, 0 if channel is not sampled.
+ */
+static uint32_t adc_channel_rate(adc_id_t id)
+{
+    adc_unit_t *unit = adc_unit_get(adc_data[id].adc);
+
+    if(adc_data[id].triggered)
+    {
+        return PWM_2_RATE;
+    }
+    if(unit->channels == 0)
+    {
+        return 0;
+    }
+
+    return unit->rate / unit->channels;
+}
+
+/**
+ * @brief   Get decimation factor of channel for output rate.
+ *
+ * @return  Conversions per output sample, 0 if rate can not be reached.
+ */
+static uint32_t adc_filter_factor(adc_id_t id, uint32_t rate)
+{
+    uint32_t input = adc_channel_rate(id);
+    uint32_t factor = 0;
+
+    if(rate == 0 || input == 0)
+    {
+        return 0;
+    }
+    factor = input / rate;
+
+    return factor > UINT16_MAX ? 0 : factor;
+}
+
+/**
+ * @brief   Get filter gain, i.e. filter output for constant input of 1.
+ *
+ * @return  Gain, saturated just above @ref ADC_GAIN_MAX.
+ */
+static uint32_t adc_filter_gain(const adc_filter_cfg_t *cfg, uint32_t factor)
+{
+    uint32_t gain = factor;
+    uint8_t i = 0;
+
+    switch(cfg->filter)
+    {
+        case ADC_FILTER_MOVING:
+            gain = factor * cfg->length;
+            break;
+        case ADC_FILTER_CIC:
+            for(i = 1; i < cfg->order && gain <= ADC_GAIN_MAX; i++)
             {
-                adc_data[i].avg.accumulator += ADC_DR_RESULT(adc_data[i].value);
-                adc_data[i].avg.counter++;
-                if(adc_data[i].avg.counter >= ADC_AVG_COUNT)
-                {
-                    adc_data[i].avg.value = adc_data[i].avg.accumulator / ADC_AVG_COUNT;
-                    adc_data[i].avg.accumulator = 0;
-                    adc_data[i].avg.counter = 0;
-                }
+                gain *= factor;
             }
-#endif
-        }
+            break;
+        default:
+            break;
     }
 
-    /* Clear Sequence A completion interrupt */
-    Chip_ADC_ClearFlags(LPC_ADC0, ADC_FLAGS_SEQA_INT_MASK);
+    return gain > ADC_GAIN_MAX ? ADC_GAIN_MAX + 1 : gain;
+}
+
+/**
+ * @brief   Restart channel filter with pending configuration. Called from block interrupt.
+ */
+static void adc_filter_apply(adc_data_t *data)
+{
+    uint8_t i = 0;
+
+    data->filter.type = data->cfg.filter;
+    data->filter.order = data->cfg.order;
+    data->filter.length = data->cfg.length;
+    data->filter.bits = data->cfg.bits;
+    data->filter.factor = (uint16_t)adc_filter_factor((adc_id_t)(data - adc_data), data->cfg.rate);
+    data->filter.gain = adc_filter_gain(&data->cfg, data->filter.factor);
+    data->filter.counter = 0;
+    for(i = 0; i < ADC_CIC_ORDER_MAX; i++)
+    {
+        data->filter.integ[i] = 0;
+        data->filter.comb[i] = 0;
+    }
+    for(i = 0; i < ADC_WINDOW_MAX; i++)
+    {
+        data->filter.window[i] = 0;
+    }
+    data->filter.window_sum = 0;
+    data->filter.window_pos = 0;
+    data->cfg_pending = false;
 
     return;
 }
 
-static void adc_1_init(void)
+/**
+ * @brief   Feed one conversion to channel filter, push output sample at end of decimation period.
+ *
+ * Integrators run at conversion rate and wrap modulo 2^32, CIC combs undo the wrap as long as filter gain fits in
+ * 32 bits, which @ref adc_set_filter ensures.
+ */
+static inline void adc_filter_sample(adc_data_t *data, uint32_t sample)
 {
+    uint32_t acc = sample;
+    uint32_t diff = 0;
+    uint32_t out = 0;
     uint8_t i = 0;
 
-    /* Setup ADC for 12-bit mode and normal power */
-    Chip_ADC_Init(LPC_ADC1, 0);
+    if(data->filter.type == ADC_FILTER_CIC)
+    {
+        for(i = 0; i < data->filter.order; i++)
+        {
+            data->filter.integ[i] += acc;
+            acc = data->filter.integ[i];
+        }
+    }
+    else
+    {
+        data->filter.integ[0] += sample;
+    }
 
-    /* Setup for maximum ADC clock rate */
-    Chip_ADC_SetClockRate(LPC_ADC1, ADC_MAX_SAMPLE_RATE);
+    data->filter.counter++;
+    if(data->filter.counter < data->filter.factor)
+    {
+        return;
+    }
+    data->filter.counter = 0;
 
-    /*
-     * For ADC0, seqeucner A will be used without threshold events.
-     * It will be triggered manually by the sysTick interrupt and
-     * only monitor the internal temperature sensor.
-     */
-    Chip_ADC_SetupSequencer(LPC_ADC1, ADC_SEQA_IDX, (ADC_SEQ_CTRL_CHANSEL(1) | ADC_SEQ_CTRL_CHANSEL(4) | ADC_SEQ_CTRL_BURST | ADC_SEQ_CTRL_MODE_EOS));
+    switch(data->filter.type)
+    {
+        case ADC_FILTER_CIC:
+            for(i = 0; i < data->filter.order; i++)
+            {
+                diff = acc - data->filter.comb[i];
+                data->filter.comb[i] = acc;
+                acc = diff;
+            }
+            break;
+        case ADC_FILTER_MOVING:
+            data->filter.window_sum += data->filter.integ[0] - data->filter.window[data->filter.window_pos];
+            data->filter.window[data->filter.window_pos] = data->filter.integ[0];
+            data->filter.integ[0] = 0;
+            data->filter.window_pos = (data->filter.window_pos + 1) % data->filter.length;
+            acc = data->filter.window_sum;
+            break;
+        default:
+            acc = data->filter.integ[0];
+            data->filter.integ[0] = 0;
+            break;
+    }
 
-    /* Use higher voltage trim for both ADCs */
-    //Chip_ADC_SetTrim(LPC_ADC1, ADC_TRIM_VRANGE_HIGHV);
+    out = (acc << data->filter.bits) / data->filter.gain;
+    data->value = out >> data->filter.bits;
+    data->out.buffer[data->out.head & (ADC_OUT_SIZE - 1)] = (uint16_t)out;
+    data->out.head++;
 
-    for(i = 0; i < ADC_ID_LAST; i++)
+    return;
+}
+
+/**
+ * @brief   Decimate DMA block: split results by channel and feed each channel filter.
+ */
+static void adc_block_cb(dma_id_t id, const uint32_t *block, uint16_t count)
+{
+    adc_unit_t *unit = id == DMA_ID_ADC_0 ? &adc_unit[0] : &adc_unit[1];
+    adc_data_t *data = NULL;
+    uint32_t word = 0;
+    uint8_t ch = 0;
+    uint16_t i = 0;
+
+    for(i = 0; i < ADC_CHANNELS; i++)
     {
-        if(adc_data[i].adc != LPC_ADC1)
+        if(unit->map[i] < ADC_ID_LAST && !adc_data[unit->map[i]].triggered && adc_data[unit->map[i]].cfg_pending)
+        {
+            adc_filter_apply(&adc_data[unit->map[i]]);
+        }
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        word = block[i];
+        if(!(word & ADC_SEQ_GDAT_DATAVALID))
         {
             continue;
         }
-        if(adc_data[i].port != 0xFF && adc_data[i].pin != 0xFF)
+        if(word & ADC_SEQ_GDAT_OVERRUN)
         {
-            /* Disables pullups/pulldowns and disable digital mode */
-            Chip_IOCON_PinMuxSet(LPC_IOCON, adc_data[i].port, adc_data[i].pin, (IOCON_MODE_INACT | IOCON_ADMODE_EN));
-            /* Assign ADC1_0 to PIO1_1 via SWM (fixed pin) */
-            Chip_SWM_EnableFixedPin(adc_data[i].sw_pin);
+            unit->overruns++;
+        }
+        ch = (word & ADC_SEQ_GDAT_CHAN_MASK) >> ADC_SEQ_GDAT_CHAN_BITPOS;
+        if(unit->map[ch] >= ADC_ID_LAST)
+        {
+            continue;
+        }
+        data = &adc_data[unit->map[ch]];
+        if(data->filter.factor != 0)
+        {
+            adc_filter_sample(data, ADC_DR_RESULT(word));
         }
     }
 
-    /* Need to do a calibration after initialization and trim */
-    Chip_ADC_StartCalibration(LPC_ADC1);
-    while (!(Chip_ADC_IsCalibrationDone(LPC_ADC1))) {}
-
-    /* Clear all pending interrupts */
-    Chip_ADC_ClearFlags(LPC_ADC1, Chip_ADC_GetFlags(LPC_ADC1));
+    return;
+}
 
-    /* Enable sequence A completion interrupts for ADC0 */
-    Chip_ADC_EnableInt(LPC_ADC1, ADC_INTEN_SEQA_ENABLE);
+/**
+ * @brief   Filter result of PWM triggered conversion.
+ *
+ * @param   unit    ADC unit.
+ */
+static void adc_trigger_irq(adc_unit_t *unit)
+{
+    uint32_t word = Chip_ADC_GetSequencerDataReg(unit->adc, ADC_SEQB_IDX);
+    adc_data_t *data = NULL;
+    uint8_t ch = (word & ADC_SEQ_GDAT_CHAN_MASK) >> ADC_SEQ_GDAT_CHAN_BITPOS;
 
-    /* Enable related ADC NVIC interrupts */
-    NVIC_EnableIRQ(ADC1_SEQA_IRQn);
+    Chip_ADC_ClearFlags(unit->adc, ADC_FLAGS_SEQB_INT_MASK);
 
-    /* Enable sequencers */
-    Chip_ADC_EnableSequencer(LPC_ADC1, ADC_SEQA_IDX);
+    if(!(word & ADC_SEQ_GDAT_DATAVALID) || unit->map[ch] >= ADC_ID_LAST)
+    {
+        return;
+    }
+    if(word & ADC_SEQ_GDAT_OVERRUN)
+    {
+        unit->overruns++;
+    }
+    data = &adc_data[unit->map[ch]];
+    data->triggers++;
+    if(data->cfg_pending)
+    {
+        adc_filter_apply(data);
+    }
+    if(data->filter.factor != 0)
+    {
+        adc_filter_sample(data, ADC_DR_RESULT(word));
+    }
 
     return;
 }
 
+/**
+ * @brief   Turn calibration into multiplier of raw counts.
+ *
+ * @param   cal     Calibration.
+ * @param   mult    Engineering units per raw count, with @ref ADC_CAL_SHIFT fraction bits.
+ *
+ * @return  False if multiplier does not fit 32 bits.
+ */
+static bool adc_cal_mult(const adc_cal_t *cal, int32_t *mult)
+{
+    int64_t scale = cal->scale != 0 ? cal->scale : 1000;
+    int64_t value = 0;
+
+    /* Raw count is ADC_CAL_MV / 2^ADC_CAL_SHIFT millivolts */
+    value = (scale * cal->gain * ADC_CAL_MV) / ((int64_t)ADC_CAL_GAIN_ONE * 1000);
+    if(value > INT32_MAX || value < INT32_MIN)
+    {
+        return false;
+    }
+    *mult = (int32_t)value;
+
+    return true;
+}
+
+/**
+ * @brief   Find threshold pair used by channel.
+ *
+ * @param   unit    ADC of channel.
+ * @param   id      ADC ID, ADC_ID_LAST to find free pair.
+ *
+ * @return  Pair index, @ref ADC_THR_PAIRS if not found.
+ */
+static uint8_t adc_window_thr(adc_unit_t *unit, adc_id_t id)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < ADC_THR_PAIRS; i++)
+    {
+        if(unit->thr_owner[i] == id)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+static adc_range_t adc_window_classify(adc_data_t *data, uint16_t value)
+{
+    if(value < data->window.cfg.low)
+    {
+        return ADC_RANGE_BELOW;
+    }
+    if(value > data->window.cfg.high)
+    {
+        return ADC_RANGE_ABOVE;
+    }
+
+    return ADC_RANGE_INSIDE;
+}
 
 /**
- * @brief   Handle interrupt from ADC1 sequencer A
+ * @brief   Program thresholds around entered range, widened by hysteresis. Comparator interrupts on conversions
+ *          outside thresholds, i.e. only when channel leaves the range.
  */
-void ADC1A_IRQHandler(void)
+static void adc_window_arm(adc_data_t *data, adc_range_t range)
+{
+    uint16_t low = data->window.cfg.low;
+    uint16_t high = data->window.cfg.high;
+    uint16_t hyst = data->window.cfg.hysteresis;
+    uint16_t thr_low = 0;
+    uint16_t thr_high = ADC_RESOLUTION - 1;
+
+    switch(range)
+    {
+        case ADC_RANGE_BELOW:
+            thr_high = low + hyst < ADC_RESOLUTION ? low + hyst : ADC_RESOLUTION - 1;
+            break;
+        case ADC_RANGE_ABOVE:
+            thr_low = high > hyst ? high - hyst : 0;
+            break;
+        default:
+            thr_low = low > hyst ? low - hyst : 0;
+            thr_high = high + hyst < ADC_RESOLUTION ? high + hyst : ADC_RESOLUTION - 1;
+            break;
+    }
+    Chip_ADC_SetThrLowValue(data->adc, data->window.thr, thr_low);
+    Chip_ADC_SetThrHighValue(data->adc, data->window.thr, thr_high);
+    data->window.range = range;
+
+    return;
+}
+
+static void adc_window_irq(adc_unit_t *unit)
 {
+    uint32_t flags = Chip_ADC_GetFlags(unit->adc) & ADC_FLAGS_THCMP_ALL;
+    adc_data_t *data = NULL;
+    adc_range_t range = ADC_RANGE_INSIDE;
+    uint16_t value = 0;
     uint8_t i = 0;
-    uint32_t pending;
 
-    /* Get pending interrupts */
-    pending = Chip_ADC_GetFlags(LPC_ADC1);
+    Chip_ADC_ClearFlags(unit->adc, flags);
 
-    /* Sequence A completion interrupt */
-    if (pending & ADC_FLAGS_SEQA_INT_MASK)
+    for(i = 0; i < ADC_THR_PAIRS; i++)
     {
-        for(i = 0; i < ADC_ID_LAST; i++)
+        if(unit->thr_owner[i] >= ADC_ID_LAST)
         {
-            if(adc_data[i].adc != LPC_ADC1)
-            {
-                continue;
-            }
-            adc_data[i].value = Chip_ADC_GetDataReg(LPC_ADC1, adc_data[i].ch);
-#if ADC_AVG_COUNT > 1
-            if(adc_data[i].value & ADC_SEQ_GDAT_DATAVALID)
-            {
-                adc_data[i].avg.accumulator += ADC_DR_RESULT(adc_data[i].value);
-                adc_data[i].avg.counter++;
-                if(adc_data[i].avg.counter >= ADC_AVG_COUNT)
-                {
-                    adc_data[i].avg.value = adc_data[i].avg.accumulator / ADC_AVG_COUNT;
-                    adc_data[i].avg.accumulator = 0;
-                    adc_data[i].avg.counter = 0;
-                }
-            }
-            else
-            {
-                adc_data[i].avg.accumulator = 0;
-                adc_data[i].avg.counter = 0;
-            }
-#endif
+            continue;
+        }
+        data = &adc_data[unit->thr_owner[i]];
+        if(!(flags & ADC_FLAGS_THCMP_MASK(data->ch)))
+        {
+            continue;
         }
+        /* Latest conversion decides, short spike may already be gone */
+        value = ADC_DR_RESULT(Chip_ADC_GetDataReg(unit->adc, data->ch));
+        range = adc_window_classify(data, value);
+        if(range == data->window.range)
+        {
+            continue;
+        }
+        adc_window_arm(data, range);
+        data->window.cfg.cb(unit->thr_owner[i], range, value);
     }
 
-    /* Clear Sequence A completion interrupt */
-    Chip_ADC_ClearFlags(LPC_ADC1, ADC_FLAGS_SEQA_INT_MASK);
+    return;
+}
+
+/**
+ * @brief   Handle sequence B interrupt from ADC0.
+ */
+void ADC0B_IRQHandler(void)
+{
+    adc_trigger_irq(&adc_unit[0]);
+
+    return;
+}
+
+/**
+ * @brief   Handle threshold compare interrupt from ADC0.
+ */
+void ADC0_THCMP_IRQHandler(void)
+{
+    adc_window_irq(&adc_unit[0]);
+
+    return;
+}
+
+/**
+ * @brief   Handle threshold compare interrupt from ADC1.
+ */
+void ADC1_THCMP_IRQHandler(void)
+{
+    adc_window_irq(&adc_unit[1]);
 
     return;
 }
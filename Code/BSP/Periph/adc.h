@@ -27,10 +27,13 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
+#define ADC_CAL_GAIN_ONE        32768   //!< Calibration gain of 1.0 (Q15).
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -52,6 +55,80 @@ typedef enum
     ADC_ID_LAST,                //!< Last should stay last.
 } adc_id_t;
 
+/**
+ * @brief   Channel decimation filter.
+ */
+typedef enum
+{
+    ADC_FILTER_BOXCAR,          //!< Average of conversions of each output period.
+    ADC_FILTER_MOVING,          //!< Sliding average over last length output periods, updated every period.
+    ADC_FILTER_CIC,             //!< Cascaded integrator-comb of given order.
+    ADC_FILTER_LAST,            //!< Last should stay last.
+} adc_filter_t;
+
+/**
+ * @brief   Channel filter configuration.
+ */
+typedef struct
+{
+    adc_filter_t filter;        //!< Decimation filter. See @ref adc_filter_t.
+    uint32_t rate;              //!< Output rate in Hz.
+    uint8_t order;              //!< Number of CIC stages, 1 to 3.
+    uint8_t length;             //!< Sliding window length in output periods, 1 to 16.
+    uint8_t bits;               //!< Extra resolution bits from oversampling, 0 to 4. Needs 4^bits conversions per output.
+} adc_filter_cfg_t;
+
+/**
+ * @brief   Range of channel conversion relative to threshold window.
+ */
+typedef enum
+{
+    ADC_RANGE_INSIDE,           //!< Between low and high threshold, inclusive.
+    ADC_RANGE_BELOW,            //!< Below low threshold.
+    ADC_RANGE_ABOVE,            //!< Above high threshold.
+} adc_range_t;
+
+/**
+ * @brief   Threshold window crossing callback. Called from interrupt context.
+ *
+ * @param   id      ADC ID of channel. See @ref adc_id_t.
+ * @param   range   Range entered. See @ref adc_range_t.
+ * @param   value   Conversion (12 bits) which crossed threshold.
+ */
+typedef void (*adc_window_cb_t)(adc_id_t id, adc_range_t range, uint16_t value);
+
+/**
+ * @brief   Threshold window. Thresholds are compared by ADC hardware against every raw conversion.
+ */
+typedef struct
+{
+    uint16_t low;               //!< Low threshold (12 bits).
+    uint16_t high;              //!< High threshold (12 bits).
+    uint16_t hysteresis;        //!< Distance a conversion has to go back past threshold to leave entered range.
+    adc_window_cb_t cb;         //!< Crossing callback.
+} adc_window_t;
+
+/**
+ * @brief   Channel calibration, value = (raw - offset) * gain * scale.
+ */
+typedef struct
+{
+    int16_t offset;             //!< Raw value (12 bits) at zero of measured quantity.
+    uint16_t gain;              //!< Gain correction in Q15, see @ref ADC_CAL_GAIN_ONE.
+    int32_t scale;              //!< Engineering units per volt, 0 for millivolts.
+} adc_cal_t;
+
+/**
+ * @brief   Read position of single consumer of channel samples. Every consumer owns its reader, so consumers of same
+ *          channel get all samples and do not take them from each other.
+ */
+typedef struct
+{
+    adc_id_t id;                //!< Channel read.
+    uint16_t tail;              //!< Sequence number of next sample.
+    uint32_t dropped;           //!< Samples overwritten before reader got them.
+} adc_reader_t;
+
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
@@ -65,7 +142,142 @@ typedef enum
 void adc_init(void);
 
 /**
- * @brief   Get raw value (12 bits).
+ * @brief   Set channel filter. Filter restarts with next DMA block.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ * @param   cfg Filter configuration. See @ref adc_filter_cfg_t.
+ *
+ * @return  False if configuration is out of range, e.g. rate above channel conversion rate, too few conversions for
+ *          requested bits or filter gain exceeding 2^20.
+ */
+bool adc_set_filter(adc_id_t id, const adc_filter_cfg_t *cfg);
+
+/**
+ * @brief   Get channel filter configuration.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ * @param   cfg Pointer to structure where configuration will be copied.
+ */
+void adc_get_filter(adc_id_t id, adc_filter_cfg_t *cfg);
+
+/**
+ * @brief   Set rate of decimated channel stream, keeping other filter settings. Conversions of channel are
+ *          decimated by whole number, so actual rate can differ. See @ref adc_get_rate.
+ *
+ * @param   id      ADC ID. See @ref adc_id_t.
+ * @param   rate    Output rate in Hz.
+ *
+ * @return  False if rate does not fit current filter.
+ */
+bool adc_set_rate(adc_id_t id, uint32_t rate);
+
+/**
+ * @brief   Get actual rate of decimated channel stream.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ *
+ * @return  Output rate in Hz.
+ */
+uint32_t adc_get_rate(adc_id_t id);
+
+/**
+ * @brief   Get conversion rate of channel, which is output rate of filter decimating by one.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ *
+ * @return  Conversions per second, 0 if channel is not sampled.
+ */
+uint32_t adc_get_input_rate(adc_id_t id);
+
+/**
+ * @brief   Attach reader to channel. Reader starts at newest sample, older samples are not returned.
+ *
+ * @param   reader  Reader. See @ref adc_reader_t.
+ * @param   id      ADC ID. See @ref adc_id_t.
+ */
+void adc_reader_init(adc_reader_t *reader, adc_id_t id);
+
+/**
+ * @brief   Read decimated samples (12 + filter bits) received since last read of this reader, oldest first. Samples
+ *          are kept for at least 64 output periods, older ones are dropped and counted in reader.
+ *
+ * @param   reader  Reader. See @ref adc_reader_t.
+ * @param   buffer  Buffer for samples.
+ * @param   size    Buffer size in samples.
+ * @param   seq     Sequence number of first sample read, samples of channel are numbered continuously. Can be NULL.
+ *
+ * @return  Number of samples read.
+ */
+uint16_t adc_read(adc_reader_t *reader, uint16_t *buffer, uint16_t size, uint16_t *seq);
+
+/**
+ * @brief   Set channel calibration. Calibration is turned into single multiplier, so conversion is multiply and shift.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ * @param   cal Calibration. See @ref adc_cal_t.
+ *
+ * @return  False if resulting multiplier does not fit 32 bits.
+ */
+bool adc_set_cal(adc_id_t id, const adc_cal_t *cal);
+
+/**
+ * @brief   Get channel calibration.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ * @param   cal Calibration. See @ref adc_cal_t.
+ */
+void adc_get_cal(adc_id_t id, adc_cal_t *cal);
+
+/**
+ * @brief   Measure zero offset of channel from decimated samples and store it in calibration. Measured quantity has
+ *          to be at zero. Blocks calling thread until samples are received.
+ *
+ * @param   id      ADC ID. See @ref adc_id_t.
+ * @param   count   Number of decimated samples to average.
+ *
+ * @return  False if samples did not arrive in time.
+ */
+bool adc_cal_zero(adc_id_t id, uint16_t count);
+
+/**
+ * @brief   Attach threshold window to channel. Callback is called only when conversion crosses into other range,
+ *          with latency of one conversion and no CPU load in between. Each ADC has two windows.
+ *
+ * @param   id      ADC ID. See @ref adc_id_t.
+ * @param   window  Window. See @ref adc_window_t.
+ *
+ * @return  False if thresholds are invalid or both windows of ADC are already used by other channels.
+ */
+bool adc_set_window(adc_id_t id, const adc_window_t *window);
+
+/**
+ * @brief   Detach threshold window from channel.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ */
+void adc_clear_window(adc_id_t id);
+
+/**
+ * @brief   Get range of channel relative to its threshold window.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ *
+ * @return  Range of last crossing, @ref ADC_RANGE_INSIDE if channel has no window.
+ */
+adc_range_t adc_get_range(adc_id_t id);
+
+/**
+ * @brief   Get number of conversions of PWM triggered channel. Counter advances once per PWM period while trigger
+ *          works, so it shows that samples are fresh.
+ *
+ * @param   id  ADC ID. See @ref adc_id_t.
+ *
+ * @return  Conversions since boot, 0 for channels converted by burst.
+ */
+uint32_t adc_get_trigger_count(adc_id_t id);
+
+/**
+ * @brief   Get last decimated raw value (12 bits).
  *
  * @param   id  ADC ID of which value to get. See @ref adc_id_t.
  *
@@ -73,6 +285,15 @@ void adc_init(void);
  */
 uint32_t adc_get_value_raw(adc_id_t id);
 
+/**
+ * @brief   Get last decimated value in engineering units of channel calibration.
+ *
+ * @param   id  ADC ID of which value to get. See @ref adc_id_t.
+ *
+ * @return  Calibrated value.
+ */
+int32_t adc_get_value(adc_id_t id);
+
 /**
  * @brief   Get channel value in millivolts.
  *
@@ -83,11 +304,11 @@ uint32_t adc_get_value_raw(adc_id_t id);
 uint32_t adc_get_value_volt(adc_id_t id);
 
 /**
- * @brief   Get internal temperature sensor value in degC.
+ * @brief   Get internal temperature sensor value.
  *
- * @return  Temperature in degC.
+ * @return  Temperature in hundredths of degC.
  */
-float adc_get_temperature(void);
+int32_t adc_get_temperature(void);
 
 #ifdef __cplusplus
 }
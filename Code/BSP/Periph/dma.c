@@ -0,0 +1,309 @@
+/**
+ **********************************************************************************************************************
+ * @file         dma.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        DMA C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip.h"
+
+#include "dma.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Channel is started by its peripheral request line, not by input mux trigger. */
+#define DMA_TRIG_NONE   0xFF
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    DMA_CHID_T ch;          //!< DMA channel, fixed by peripheral request line.
+    volatile void *periph;  //!< Peripheral data register.
+    bool to_periph;         //!< Transfer direction: 0 - peripheral to memory, 1 - memory to peripheral.
+    uint32_t cfg;           //!< Channel configuration.
+    uint8_t trig;           //!< Hardware trigger input, @ref DMA_TRIG_NONE if not used.
+    dma_cb_t cb;            //!< Completion callback.
+    volatile bool busy;     //!< Transfer in progress.
+    struct
+    {
+        uint32_t *buffer;   //!< Ring of two blocks.
+        uint16_t count;     //!< Words in one block.
+        dma_ring_cb_t cb;   //!< Block completion callback.
+    } ring;
+} dma_data_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+dma_data_t dma_data[DMA_ID_LAST] =
+{
+    {
+        .ch = DMAREQ_SPI0_TX,
+        .periph = &LPC_SPI0->TXDAT,
+        .to_periph = true,
+        .cfg = DMA_CFG_PERIPHREQEN | DMA_CFG_TRIGBURST_SNGL | DMA_CFG_CHPRIORITY(1),
+        .trig = DMA_TRIG_NONE,
+        .cb = NULL,
+        .busy = false,
+    },
+    {
+        .ch = DMAREQ_I2C0_MST,
+        .periph = &LPC_I2C0->MSTDAT,
+        .to_periph = true,
+        .cfg = DMA_CFG_PERIPHREQEN | DMA_CFG_TRIGBURST_SNGL | DMA_CFG_CHPRIORITY(2),
+        .trig = DMA_TRIG_NONE,
+        .cb = NULL,
+        .busy = false,
+    },
+    /*
+     * ADC sequences run in end of conversion mode: sequence interrupt line follows DATAVALID of global data register
+     * and drops when register is read, so high level trigger moves exactly one result per conversion.
+     */
+    {
+        .ch = DMA_CH14,
+        .periph = &LPC_ADC0->SEQ_GDAT[ADC_SEQA_IDX],
+        .to_periph = false,
+        .cfg = DMA_CFG_HWTRIGEN | DMA_CFG_TRIGPOL_HIGH | DMA_CFG_TRIGTYPE_LEVEL | DMA_CFG_TRIGBURST_BURST |
+            DMA_CFG_BURSTPOWER_1 | DMA_CFG_CHPRIORITY(0),
+        .trig = DMATRIG_ADC0_SEQA_IRQ,
+        .cb = NULL,
+        .busy = false,
+    },
+    {
+        .ch = DMA_CH15,
+        .periph = &LPC_ADC1->SEQ_GDAT[ADC_SEQA_IDX],
+        .to_periph = false,
+        .cfg = DMA_CFG_HWTRIGEN | DMA_CFG_TRIGPOL_HIGH | DMA_CFG_TRIGTYPE_LEVEL | DMA_CFG_TRIGBURST_BURST |
+            DMA_CFG_BURSTPOWER_1 | DMA_CFG_CHPRIORITY(0),
+        .trig = DMATRIG_ADC1_SEQA_IRQ,
+        .cb = NULL,
+        .busy = false,
+    },
+};
+
+/* Reload descriptors of ring channels: [0] fills first block, [1] second one, each links to the other. */
+static DMA_CHDESC_T dma_ring_desc[DMA_ID_LAST][2] __attribute__((aligned(16)));
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void dma_ring_irq(dma_id_t id, bool done_a, bool done_b, bool error);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void dma_init(void)
+{
+    uint8_t i = 0;
+
+    Chip_DMA_Init(LPC_DMA);
+    Chip_DMA_Enable(LPC_DMA);
+    Chip_DMA_SetSRAMBase(LPC_DMA, DMA_ADDR(Chip_DMA_Table));
+    /* Input mux routes hardware triggers */
+    Chip_Clock_EnablePeriphClock(SYSCTL_CLOCK_MUX);
+
+    for(i = 0; i < DMA_ID_LAST; i++)
+    {
+        if(dma_data[i].trig != DMA_TRIG_NONE)
+        {
+            Chip_INMUX_SetDMATrigger(dma_data[i].ch, (DMA_TRIGSRC_T)dma_data[i].trig);
+        }
+        Chip_DMA_EnableChannel(LPC_DMA, dma_data[i].ch);
+        Chip_DMA_EnableIntChannel(LPC_DMA, dma_data[i].ch);
+        Chip_DMA_SetupChannelConfig(LPC_DMA, dma_data[i].ch, dma_data[i].cfg);
+    }
+
+    NVIC_EnableIRQ(DMA_IRQn);
+
+    return;
+}
+
+bool dma_start(dma_id_t id, void *buffer, uint16_t count, dma_cb_t cb)
+{
+    DMA_CHDESC_T *desc = &Chip_DMA_Table[dma_data[id].ch];
+
+    if(buffer == NULL || count == 0 || count > DMA_MAX_TRANSFER || dma_data[id].busy)
+    {
+        return false;
+    }
+
+    dma_data[id].cb = cb;
+    dma_data[id].busy = true;
+
+    /* Descriptor holds end addresses of incrementing side */
+    if(dma_data[id].to_periph)
+    {
+        desc->source = DMA_ADDR((uint8_t *)buffer + count - 1);
+        desc->dest = DMA_ADDR(dma_data[id].periph);
+    }
+    else
+    {
+        desc->source = DMA_ADDR(dma_data[id].periph);
+        desc->dest = DMA_ADDR((uint8_t *)buffer + count - 1);
+    }
+    desc->next = 0;
+
+    Chip_DMA_SetupChannelTransfer(LPC_DMA, dma_data[id].ch,
+        DMA_XFERCFG_CFGVALID | DMA_XFERCFG_SETINTA | DMA_XFERCFG_SWTRIG | DMA_XFERCFG_WIDTH_8 |
+        (dma_data[id].to_periph ? (DMA_XFERCFG_SRCINC_1 | DMA_XFERCFG_DSTINC_0) : (DMA_XFERCFG_SRCINC_0 | DMA_XFERCFG_DSTINC_1)) |
+        DMA_XFERCFG_XFERCOUNT(count));
+
+    return true;
+}
+
+bool dma_start_ring(dma_id_t id, uint32_t *buffer, uint16_t count, dma_ring_cb_t cb)
+{
+    DMA_CHDESC_T *desc = dma_ring_desc[id];
+    uint32_t cfg = DMA_XFERCFG_CFGVALID | DMA_XFERCFG_RELOAD | DMA_XFERCFG_WIDTH_32 | DMA_XFERCFG_SRCINC_0 |
+        DMA_XFERCFG_DSTINC_1 | DMA_XFERCFG_XFERCOUNT(count);
+
+    if(buffer == NULL || count == 0 || count > DMA_MAX_TRANSFER || dma_data[id].to_periph || dma_data[id].busy)
+    {
+        return false;
+    }
+
+    dma_data[id].ring.buffer = buffer;
+    dma_data[id].ring.count = count;
+    dma_data[id].ring.cb = cb;
+    dma_data[id].busy = true;
+
+    /* First block raises interrupt A, second one B, so handler knows which block is complete */
+    desc[0].xfercfg = cfg | DMA_XFERCFG_SETINTA;
+    desc[0].source = DMA_ADDR(dma_data[id].periph);
+    desc[0].dest = DMA_ADDR(&buffer[count - 1]);
+    desc[0].next = DMA_ADDR(&desc[1]);
+    desc[1].xfercfg = cfg | DMA_XFERCFG_SETINTB;
+    desc[1].source = DMA_ADDR(dma_data[id].periph);
+    desc[1].dest = DMA_ADDR(&buffer[2 * count - 1]);
+    desc[1].next = DMA_ADDR(&desc[0]);
+    Chip_DMA_Table[dma_data[id].ch] = desc[0];
+
+    Chip_DMA_SetupChannelTransfer(LPC_DMA, dma_data[id].ch, desc[0].xfercfg);
+
+    return true;
+}
+
+bool dma_is_busy(dma_id_t id)
+{
+    return dma_data[id].busy;
+}
+
+void dma_abort(dma_id_t id)
+{
+    Chip_DMA_DisableChannel(LPC_DMA, dma_data[id].ch);
+    while(Chip_DMA_GetBusyChannels(LPC_DMA) & (1 << dma_data[id].ch)) {}
+    Chip_DMA_AbortChannel(LPC_DMA, dma_data[id].ch);
+    Chip_DMA_ClearErrorIntChannel(LPC_DMA, dma_data[id].ch);
+    Chip_DMA_EnableChannel(LPC_DMA, dma_data[id].ch);
+    dma_data[id].ring.buffer = NULL;
+    dma_data[id].busy = false;
+
+    return;
+}
+
+/**
+ * @brief   Handle interrupt from DMA controller.
+ */
+void DMA_IRQHandler(void)
+{
+    uint8_t i = 0;
+    uint32_t done = Chip_DMA_GetActiveIntAChannels(LPC_DMA);
+    uint32_t done_b = Chip_DMA_GetActiveIntBChannels(LPC_DMA);
+    uint32_t error = Chip_DMA_GetErrorIntChannels(LPC_DMA);
+    uint32_t mask = 0;
+
+    for(i = 0; i < DMA_ID_LAST; i++)
+    {
+        mask = 1 << dma_data[i].ch;
+        if(dma_data[i].ring.buffer != NULL)
+        {
+            dma_ring_irq((dma_id_t)i, done & mask, done_b & mask, error & mask);
+            continue;
+        }
+        if(!((done | error) & mask))
+        {
+            continue;
+        }
+        if(done & mask)
+        {
+            Chip_DMA_ClearActiveIntAChannel(LPC_DMA, dma_data[i].ch);
+        }
+        if(error & mask)
+        {
+            Chip_DMA_ClearErrorIntChannel(LPC_DMA, dma_data[i].ch);
+        }
+        dma_data[i].busy = false;
+        if(dma_data[i].cb != NULL)
+        {
+            dma_data[i].cb((dma_id_t)i, (error & mask) ? true : false);
+        }
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Handle ring channel interrupt. Ring keeps running, error only drops blocks it hit.
+ *
+ * @param   id      DMA ID of ring.
+ * @param   done_a  First block complete.
+ * @param   done_b  Second block complete.
+ * @param   error   Channel error.
+ */
+static void dma_ring_irq(dma_id_t id, bool done_a, bool done_b, bool error)
+{
+    if(error)
+    {
+        Chip_DMA_ClearErrorIntChannel(LPC_DMA, dma_data[id].ch);
+    }
+    if(done_a)
+    {
+        Chip_DMA_ClearActiveIntAChannel(LPC_DMA, dma_data[id].ch);
+        if(dma_data[id].ring.cb != NULL && !error)
+        {
+            dma_data[id].ring.cb(id, dma_data[id].ring.buffer, dma_data[id].ring.count);
+        }
+    }
+    if(done_b)
+    {
+        Chip_DMA_ClearActiveIntBChannel(LPC_DMA, dma_data[id].ch);
+        if(dma_data[id].ring.cb != NULL && !error)
+        {
+            dma_data[id].ring.cb(id, &dma_data[id].ring.buffer[dma_data[id].ring.count], dma_data[id].ring.count);
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,135 @@
+/**
+ **********************************************************************************************************************
+ * @file        dma.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       DMA C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define DMA_MAX_TRANSFER    1024    //!< Maximum transfers count of single descriptor.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   DMA id list.
+ */
+typedef enum
+{
+    DMA_ID_SPI_0_TX,    //!< SPI-0 transmit.
+    DMA_ID_I2C_0_TX,    //!< I2C-0 master transmit.
+    DMA_ID_ADC_0,       //!< ADC-0 sequence A results, hardware triggered.
+    DMA_ID_ADC_1,       //!< ADC-1 sequence A results, hardware triggered.
+    DMA_ID_LAST,        //!< Last should stay last.
+} dma_id_t;
+
+/**
+ * @brief   DMA transfer completion callback. Called from interrupt context.
+ *
+ * @param   id      DMA ID of completed transfer. See @ref dma_id_t.
+ * @param   error   True if transfer ended with error.
+ */
+typedef void (*dma_cb_t)(dma_id_t id, bool error);
+
+/**
+ * @brief   Ring block completion callback. Called from interrupt context.
+ *
+ * @param   id      DMA ID of ring. See @ref dma_id_t.
+ * @param   block   Completed block, valid until DMA wraps around to it again.
+ * @param   count   Number of 32 bit words in block.
+ */
+typedef void (*dma_ring_cb_t)(dma_id_t id, const uint32_t *block, uint16_t count);
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize DMA controller.
+ */
+void dma_init(void);
+
+/**
+ * @brief   Start transfer between memory buffer and channel peripheral.
+ *
+ * @param   id      DMA ID to use. See @ref dma_id_t.
+ * @param   buffer  Memory buffer. Must stay valid until completion callback.
+ * @param   count   Number of transfers, 1 to @ref DMA_MAX_TRANSFER.
+ * @param   cb      Completion callback. Can be NULL.
+ *
+ * @return  State of start.
+ * @retval  0   failed, channel busy or invalid parameters.
+ * @retval  1   success.
+ */
+bool dma_start(dma_id_t id, void *buffer, uint16_t count, dma_cb_t cb);
+
+/**
+ * @brief   Start endless peripheral to memory transfer of 32 bit words into ring of two blocks. Channel keeps
+ *          filling blocks in turn until aborted, callback is called once per filled block.
+ *
+ * @param   id      DMA ID to use. See @ref dma_id_t.
+ * @param   buffer  Ring buffer of 2 * count words. Must stay valid until aborted.
+ * @param   count   Number of words in one block, 1 to @ref DMA_MAX_TRANSFER.
+ * @param   cb      Block completion callback. Can be NULL.
+ *
+ * @return  State of start.
+ * @retval  0   failed, channel busy or invalid parameters.
+ * @retval  1   success.
+ */
+bool dma_start_ring(dma_id_t id, uint32_t *buffer, uint16_t count, dma_ring_cb_t cb);
+
+/**
+ * @brief   Check if transfer is in progress.
+ *
+ * @param   id  DMA ID to check. See @ref dma_id_t.
+ *
+ * @return  True if channel is busy.
+ */
+bool dma_is_busy(dma_id_t id);
+
+/**
+ * @brief   Abort transfer in progress. Completion callback is not called.
+ *
+ * @param   id  DMA ID to abort. See @ref dma_id_t.
+ */
+void dma_abort(dma_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DMA_H_ */
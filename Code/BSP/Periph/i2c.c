@@ -21,19 +21,28 @@
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
-#include <string.h>
 
 #include "chip.h"
+#include "cmsis_os2.h"
 
 #include "i2c.h"
+#include "dma.h"
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
 /* I2C clock is set to 1.8MHz */
 #define I2C_CLK_DIVIDER         (40)
-/* 100KHz I2C bit-rate */
+/* 400KHz I2C bit-rate */
 #define I2C_BITRATE             (400000)
+/* Transmit parts of at least this size are sent by DMA */
+#define I2C_DMA_MIN_SIZE        16
+/* Thread flag set when blocking transfer is complete */
+#define I2C_FLAG                0x2000U
+/* Master interrupts used by transfer */
+#define I2C_INT_MASTER          (I2C_INTENSET_MSTPENDING | I2C_INTENSET_MSTRARBLOSS | I2C_INTENSET_MSTSTSTPERR)
+/* Polls of master pending before start, a stop takes a few us but a stuck bus never completes */
+#define I2C_IDLE_POLLS          10000
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -46,9 +55,17 @@
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
-/* I2CM transfer record */
-static I2CM_XFER_T  i2c_xfer_rec = {0};
-static uint8_t i2c_buffer[256 + 1] = {0};
+/* Transfer in progress */
+static struct
+{
+    i2c_xfer_t xfer;        //!< Copy of requested transfer.
+    uint8_t part;           //!< Transmit part being sent: 0 - tx, 1 - data.
+    uint16_t index;         //!< Next byte of current part.
+    volatile bool busy;     //!< Transfer in progress.
+    i2c_status_t status;    //!< Transfer status.
+    i2c_cb_t cb;            //!< Completion callback.
+    osThreadId_t thread;    //!< Thread blocked on transfer, NULL if none.
+} i2c_state;
 
 /**********************************************************************************************************************
  * Exported variables
@@ -57,6 +74,10 @@ static uint8_t i2c_buffer[256 + 1] = {0};
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static bool i2c_begin(const i2c_xfer_t *xfer, i2c_cb_t cb, osThreadId_t thread);
+static void i2c_tx_next(void);
+static void i2c_finish(i2c_status_t status);
+static void i2c_dma_done(dma_id_t id, bool error);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -80,54 +101,263 @@ void i2c_init(void)
     /* Enable Master Mode */
     Chip_I2CM_Enable(LPC_I2C0);
 
-    /* Disable the interrupt for the I2C */
-    NVIC_DisableIRQ(I2C0_IRQn);
+    /* Transfers are driven from interrupt, sources are enabled per transfer */
+    Chip_I2C_DisableInt(LPC_I2C0, I2C_INT_MASTER);
+    NVIC_EnableIRQ(I2C0_IRQn);
 
     return;
 }
 
-void i2c_write_reg(uint8_t addr, uint8_t reg, uint8_t data)
+bool i2c_start(const i2c_xfer_t *xfer, i2c_cb_t cb)
+{
+    return i2c_begin(xfer, cb, NULL);
+}
+
+bool i2c_xfer(const i2c_xfer_t *xfer, uint32_t timeout)
+{
+    bool running = osKernelGetState() == osKernelRunning;
+
+    if(running)
+    {
+        osThreadFlagsClear(I2C_FLAG);
+    }
+    if(i2c_begin(xfer, NULL, running ? osThreadGetId() : NULL) == false)
+    {
+        return false;
+    }
+
+    if(running)
+    {
+        /* Thread sleeps while transfer runs from interrupts */
+        if(osThreadFlagsWait(I2C_FLAG, osFlagsWaitAny, timeout) == (uint32_t)osErrorTimeout)
+        {
+            i2c_abort();
+            i2c_state.status = I2C_STATUS_TIMEOUT;
+            return false;
+        }
+    }
+    else
+    {
+        while(i2c_state.busy) {}
+    }
+
+    return i2c_state.status == I2C_STATUS_OK;
+}
+
+void i2c_abort(void)
+{
+    Chip_I2C_DisableInt(LPC_I2C0, I2C_INT_MASTER);
+    if(dma_is_busy(DMA_ID_I2C_0_TX))
+    {
+        dma_abort(DMA_ID_I2C_0_TX);
+    }
+    LPC_I2C0->MSTCTL = I2C_MSTCTL_MSTSTOP;
+    i2c_state.busy = false;
+
+    return;
+}
+
+i2c_status_t i2c_get_status(void)
 {
-    uint8_t buffer[2] = {0};
+    return i2c_state.status;
+}
 
-    buffer[0] = reg;
-    buffer[1] = data;
+bool i2c_is_busy(void)
+{
+    return i2c_state.busy;
+}
+
+void i2c_write_reg(uint8_t addr, uint8_t reg, uint8_t data)
+{
+    uint8_t buffer[2] = {reg, data};
 
     i2c_tx_rx(addr, buffer, 2, NULL, 0);
 
     return;
 }
 
-void i2c_write_reg_multi(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t size)
+void i2c_write_reg_multi(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t size)
 {
-    i2c_buffer[0] = reg;
-    memcpy(&i2c_buffer[1], data, size);
+    /* Register byte and payload are sent back to back, payload is not copied */
+    i2c_xfer_t xfer = {.addr = addr, .tx = &reg, .tx_size = 1, .data = data, .data_size = size};
 
-    i2c_tx_rx(addr, i2c_buffer, size + 1, NULL, 0);
+    i2c_xfer(&xfer, I2C_TIMEOUT);
 
     return;
 }
 
+bool i2c_tx_rx(uint8_t addr, const uint8_t *tx_buff, uint16_t tx_size, uint8_t *rx_buff, uint16_t rx_size)
+{
+    i2c_xfer_t xfer = {.addr = addr, .tx = tx_buff, .tx_size = tx_size, .rx = rx_buff, .rx_size = rx_size};
+
+    return i2c_xfer(&xfer, I2C_TIMEOUT);
+}
 
-bool i2c_tx_rx(uint8_t addr, uint8_t *tx_buff, uint16_t tx_size, uint8_t *rx_buff, uint16_t rx_size)
+/**
+ * @brief   Handle I2C-0 master events.
+ */
+void I2C0_IRQHandler(void)
 {
-    /* Setup I2C transfer record */
-    i2c_xfer_rec.slaveAddr  = addr;
-    i2c_xfer_rec.status     = 0;
-    i2c_xfer_rec.txSz       = tx_size;
-    i2c_xfer_rec.rxSz       = rx_size;
-    i2c_xfer_rec.txBuff     = tx_buff;
-    i2c_xfer_rec.rxBuff     = rx_buff;
+    uint32_t status = Chip_I2CM_GetStatus(LPC_I2C0);
 
-    Chip_I2CM_XferBlocking(LPC_I2C0, &i2c_xfer_rec);
-    if(i2c_xfer_rec.status == I2CM_STATUS_OK)
+    if(status & (I2C_STAT_MSTRARBLOSS | I2C_STAT_MSTSTSTPERR))
+    {
+        Chip_I2CM_ClearStatus(LPC_I2C0, I2C_STAT_MSTRARBLOSS | I2C_STAT_MSTSTSTPERR);
+        i2c_finish(I2C_STATUS_BUS_ERROR);
+        return;
+    }
+    if(!(status & I2C_STAT_MSTPENDING))
     {
-        return true;
+        return;
     }
 
-    return false;
+    switch(Chip_I2CM_GetMasterState(LPC_I2C0))
+    {
+        case I2C_STAT_MSTCODE_TXREADY:
+            i2c_tx_next();
+            break;
+        case I2C_STAT_MSTCODE_RXREADY:
+            i2c_state.xfer.rx[i2c_state.index++] = LPC_I2C0->MSTDAT;
+            if(i2c_state.index < i2c_state.xfer.rx_size)
+            {
+                Chip_I2CM_MasterContinue(LPC_I2C0);
+            }
+            else
+            {
+                Chip_I2CM_SendStop(LPC_I2C0);
+                i2c_finish(I2C_STATUS_OK);
+            }
+            break;
+        case I2C_STAT_MSTCODE_NACKADR:
+        case I2C_STAT_MSTCODE_NACKDAT:
+            Chip_I2CM_SendStop(LPC_I2C0);
+            i2c_finish(I2C_STATUS_NACK);
+            break;
+        default:
+            /* Idle, nothing to do */
+            Chip_I2C_DisableInt(LPC_I2C0, I2C_INTENSET_MSTPENDING);
+            break;
+    }
+
+    return;
 }
+
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+/**
+ * @brief   Start transfer, completion is reported to callback and thread flag of blocked thread.
+ */
+static bool i2c_begin(const i2c_xfer_t *xfer, i2c_cb_t cb, osThreadId_t thread)
+{
+    uint32_t polls = 0;
+
+    if(i2c_state.busy || (xfer->tx_size == 0 && xfer->data_size == 0 && xfer->rx_size == 0))
+    {
+        return false;
+    }
+
+    i2c_state.xfer = *xfer;
+    i2c_state.part = 0;
+    i2c_state.index = 0;
+    i2c_state.status = I2C_STATUS_BUSY;
+    i2c_state.cb = cb;
+    i2c_state.thread = thread;
+    i2c_state.busy = true;
+
+    /* Previous stop must be done before new start */
+    while(!(Chip_I2CM_GetStatus(LPC_I2C0) & I2C_STAT_MSTPENDING))
+    {
+        if(polls++ >= I2C_IDLE_POLLS)
+        {
+            i2c_state.status = I2C_STATUS_TIMEOUT;
+            i2c_state.busy = false;
+            return false;
+        }
+    }
+    Chip_I2CM_ClearStatus(LPC_I2C0, I2C_STAT_MSTRARBLOSS | I2C_STAT_MSTSTSTPERR);
+    Chip_I2CM_WriteByte(LPC_I2C0, (xfer->addr << 1) | (xfer->tx_size == 0 && xfer->data_size == 0));
+    Chip_I2CM_SendStart(LPC_I2C0);
+    Chip_I2C_EnableInt(LPC_I2C0, I2C_INT_MASTER);
+
+    return true;
+}
+
+/**
+ * @brief   Continue after transmitted byte: next byte of transmit parts, then repeated start for receive or stop.
+ */
+static void i2c_tx_next(void)
+{
+    const uint8_t *data = i2c_state.part == 0 ? i2c_state.xfer.tx : i2c_state.xfer.data;
+    uint16_t size = i2c_state.part == 0 ? i2c_state.xfer.tx_size : i2c_state.xfer.data_size;
+
+    if(i2c_state.index >= size && i2c_state.part == 0)
+    {
+        i2c_state.part = 1;
+        i2c_state.index = 0;
+        data = i2c_state.xfer.data;
+        size = i2c_state.xfer.data_size;
+    }
+
+    if(i2c_state.index < size)
+    {
+        if(size - i2c_state.index >= I2C_DMA_MIN_SIZE &&
+            dma_start(DMA_ID_I2C_0_TX, (uint8_t *)&data[i2c_state.index], size - i2c_state.index, i2c_dma_done))
+        {
+            /* DMA feeds data register, master pending is handled again when it is done */
+            i2c_state.index = size;
+            Chip_I2C_DisableInt(LPC_I2C0, I2C_INTENSET_MSTPENDING);
+            LPC_I2C0->MSTCTL = I2C_MSTCTL_MSTDMA;
+            return;
+        }
+        LPC_I2C0->MSTDAT = data[i2c_state.index++];
+        Chip_I2CM_MasterContinue(LPC_I2C0);
+    }
+    else if(i2c_state.xfer.rx_size != 0)
+    {
+        /* Repeated start for receive part */
+        i2c_state.part = 2;
+        i2c_state.index = 0;
+        Chip_I2CM_WriteByte(LPC_I2C0, (i2c_state.xfer.addr << 1) | 0x01);
+        Chip_I2CM_SendStart(LPC_I2C0);
+    }
+    else
+    {
+        Chip_I2CM_SendStop(LPC_I2C0);
+        i2c_finish(I2C_STATUS_OK);
+    }
+
+    return;
+}
+
+static void i2c_finish(i2c_status_t status)
+{
+    Chip_I2C_DisableInt(LPC_I2C0, I2C_INT_MASTER);
+    i2c_state.status = status;
+    i2c_state.busy = false;
+    if(i2c_state.cb != NULL)
+    {
+        i2c_state.cb(status != I2C_STATUS_OK);
+    }
+    if(i2c_state.thread != NULL)
+    {
+        osThreadFlagsSet(i2c_state.thread, I2C_FLAG);
+    }
+
+    return;
+}
 
+static void i2c_dma_done(dma_id_t id, bool error)
+{
+    /* DMA must be off before stop or repeated start */
+    LPC_I2C0->MSTCTL = 0;
+    if(error)
+    {
+        Chip_I2CM_SendStop(LPC_I2C0);
+        i2c_finish(I2C_STATUS_BUS_ERROR);
+        return;
+    }
+    Chip_I2C_EnableInt(LPC_I2C0, I2C_INTENSET_MSTPENDING);
+
+    return;
+}
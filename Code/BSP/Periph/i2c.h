@@ -33,6 +33,7 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported constants
  *********************************************************************************************************************/
+#define I2C_TIMEOUT     100     //!< Timeout of blocking transfers in ms.
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -41,6 +42,38 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
+/**
+ * @brief   I2C transfer status.
+ */
+typedef enum
+{
+    I2C_STATUS_OK,          //!< Transfer succeeded.
+    I2C_STATUS_BUSY,        //!< Transfer in progress or bus was busy at start.
+    I2C_STATUS_NACK,        //!< Slave did not acknowledge address or data.
+    I2C_STATUS_BUS_ERROR,   //!< Arbitration lost, start/stop error or DMA error.
+    I2C_STATUS_TIMEOUT,     //!< Transfer did not complete in time and was aborted.
+} i2c_status_t;
+
+/**
+ * @brief   I2C transfer: tx and data parts are written back to back, then rx part is read after repeated start.
+ */
+typedef struct
+{
+    uint8_t addr;           //!< 7 bit slave address.
+    const uint8_t *tx;      //!< First part to write, e.g. register address. Can be NULL when tx_size is 0.
+    uint16_t tx_size;       //!< Size of first part.
+    const uint8_t *data;    //!< Second part to write, e.g. payload. Can be NULL when data_size is 0.
+    uint16_t data_size;     //!< Size of second part.
+    uint8_t *rx;            //!< Buffer for read data. Can be NULL when rx_size is 0.
+    uint16_t rx_size;       //!< Number of bytes to read.
+} i2c_xfer_t;
+
+/**
+ * @brief   I2C transfer completion callback. Called from interrupt context.
+ *
+ * @param   error   True if transfer failed (NACK, arbitration lost, bus error).
+ */
+typedef void (*i2c_cb_t)(bool error);
 
 /**********************************************************************************************************************
  * Prototypes of exported variables
@@ -50,24 +83,79 @@ extern "C" {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 void i2c_init(void);
+
+/**
+ * @brief   Start interrupt driven transfer. Long writes are fed by DMA.
+ *
+ * @param   xfer    Transfer description, copied. Buffers must stay valid until completion.
+ * @param   cb      Completion callback. Can be NULL.
+ *
+ * @return  State of start.
+ * @retval  0   failed, bus busy, empty transfer or previous stop not done (status is I2C_STATUS_TIMEOUT).
+ * @retval  1   success.
+ */
+bool i2c_start(const i2c_xfer_t *xfer, i2c_cb_t cb);
+
+/**
+ * @brief   Do transfer, calling thread sleeps until it is complete. Busy waits if kernel is not running yet.
+ *
+ * @param   xfer    Transfer description.
+ * @param   timeout Timeout in ms, transfer is aborted on timeout.
+ *
+ * @return  True if transfer succeeded.
+ */
+bool i2c_xfer(const i2c_xfer_t *xfer, uint32_t timeout);
+
 /**
- * @brief  Writes single byte to slave
- * @param  *I2Cx: I2C used
- * @param  address: 7 bit slave address, left aligned, bits 7:1 are used, LSB bit is not used
- * @param  reg: register to write to
- * @param  data: data to be written
- * @retval None
+ * @brief   Abort transfer in progress, stop is sent. Completion callback is not called.
  */
+void i2c_abort(void);
+
+/**
+ * @brief   Get status of last transfer.
+ *
+ * @return  Transfer status. See @ref i2c_status_t.
+ */
+i2c_status_t i2c_get_status(void);
+
+/**
+ * @brief   Check if transfer is in progress.
+ *
+ * @return  True if bus is busy.
+ */
+bool i2c_is_busy(void);
+
 /**
  * @brief   Writes single byte to slave register.
  *
- * @param   addr    Salve address.
+ * @param   addr    Slave address.
  * @param   reg     Register to write to.
  * @param   data    Data to be written.
  */
 void i2c_write_reg(uint8_t addr, uint8_t reg, uint8_t data);
-void i2c_write_reg_multi(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t size);
-bool i2c_tx_rx(uint8_t dev_dddr, uint8_t *tx_buff, uint16_t tx_size, uint8_t *rx_buff, uint16_t rx_size);
+
+/**
+ * @brief   Writes data to slave register, register byte and data are sent without copying.
+ *
+ * @param   addr    Slave address.
+ * @param   reg     Register to write to.
+ * @param   data    Data to be written.
+ * @param   size    Size of data.
+ */
+void i2c_write_reg_multi(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief   Write and then read slave, see @ref i2c_xfer.
+ *
+ * @param   addr    Slave address.
+ * @param   tx_buff Data to write.
+ * @param   tx_size Size of data to write.
+ * @param   rx_buff Buffer for read data.
+ * @param   rx_size Number of bytes to read.
+ *
+ * @return  True if transfer succeeded.
+ */
+bool i2c_tx_rx(uint8_t addr, const uint8_t *tx_buff, uint16_t tx_size, uint8_t *rx_buff, uint16_t rx_size);
 
 #ifdef __cplusplus
 }
@@ -29,6 +29,16 @@
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
+/*
+ * SCT2 events, event n is triggered by match register n. Right motor on-time starts at half period, so drivers do
+ * not switch on together and middle of left on-time always comes before middle of right one.
+ */
+#define PWM_2_EV_LIMIT          0   //!< Period end, left motor on, ADC trigger low.
+#define PWM_2_EV_LEFT_OFF       1   //!< Left motor off.
+#define PWM_2_EV_RIGHT_OFF      2   //!< Right motor off.
+#define PWM_2_EV_RIGHT_ON       3   //!< Half period, right motor on, ADC trigger low.
+#define PWM_2_EV_LEFT_SAMPLE    4   //!< Middle of left on-time, ADC trigger high.
+#define PWM_2_EV_RIGHT_SAMPLE   5   //!< Middle of right on-time, ADC trigger high.
 
 /**********************************************************************************************************************
  * Private definitions and macros
@@ -43,7 +53,10 @@ typedef struct
     CHIP_SWM_PIN_MOVABLE_T pin_mov;
     uint8_t pin;
     uint8_t port;
-    uint8_t index;
+    uint8_t index;      //!< Match register and event which ends on-time.
+    uint8_t out;        //!< SCT output.
+    bool shift;         //!< On-time starts at half period.
+    uint8_t sample;     //!< Match register and event at middle of on-time, 0 if none.
 } pwm_t;
 
 /**********************************************************************************************************************
@@ -51,17 +64,27 @@ typedef struct
  *********************************************************************************************************************/
 static const pwm_t pwm_config[PWM_ID_LAST] =
 {
-    {.sct = LPC_SCT0, .pin_mov = SWM_SCT0_OUT0_O, .port = 0, .pin = 28, .index = 1},
-    {.sct = LPC_SCT0, .pin_mov = SWM_SCT0_OUT1_O, .port = 0, .pin = 27, .index = 2},
-    {.sct = LPC_SCT2, .pin_mov = SWM_SCT2_OUT0_O, .port = 0, .pin = 16, .index = 1},
-    {.sct = LPC_SCT2, .pin_mov = SWM_SCT2_OUT1_O, .port = 1, .pin = 3,  .index = 2},
+    {.sct = LPC_SCT0, .pin_mov = SWM_SCT0_OUT0_O, .port = 0, .pin = 28, .index = 1, .out = 0},
+    {.sct = LPC_SCT0, .pin_mov = SWM_SCT0_OUT1_O, .port = 0, .pin = 27, .index = 2, .out = 1},
+    {
+        .sct = LPC_SCT2, .pin_mov = SWM_SCT2_OUT0_O, .port = 0, .pin = 16, .index = PWM_2_EV_LEFT_OFF, .out = 0,
+        .shift = false, .sample = PWM_2_EV_LEFT_SAMPLE,
+    },
+    {
+        .sct = LPC_SCT2, .pin_mov = SWM_SCT2_OUT1_O, .port = 1, .pin = 3, .index = PWM_2_EV_RIGHT_OFF, .out = 1,
+        .shift = true, .sample = PWM_2_EV_RIGHT_SAMPLE,
+    },
 };
 
+/* Duty cycle in ticks. */
+static uint32_t pwm_duty[PWM_ID_LAST];
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
 static void pwm_0_init(void);
 static void pwm_2_init(void);
+static void pwm_sct_event(LPC_SCT_T *sct, uint8_t event, uint32_t match);
 
 /**********************************************************************************************************************
  * Prototypes of local functions
@@ -100,6 +123,7 @@ static void pwm_0_init(void)
 static void pwm_2_init(void)
 {
     uint8_t i = 0;
+    uint32_t period = 0;
 
     /* Setup Board specific output pin */
     /* Enable SWM clock before altering SWM */
@@ -114,13 +138,26 @@ static void pwm_2_init(void)
 
     Chip_SCTPWM_Init(LPC_SCT2);
     Chip_SCTPWM_SetRate(LPC_SCT2, PWM_2_RATE);
+    period = Chip_SCTPWM_GetTicksPerCycle(LPC_SCT2);
+
+    /* Left motor is on from period start */
+    Chip_SCTPWM_SetOutPin(LPC_SCT2, PWM_2_EV_LEFT_OFF, 0);
+    /* Right motor is on from half period */
+    pwm_sct_event(LPC_SCT2, PWM_2_EV_RIGHT_ON, period / 2);
+    pwm_sct_event(LPC_SCT2, PWM_2_EV_RIGHT_OFF, period / 2);
+    LPC_SCT2->OUT[1].SET = 1 << PWM_2_EV_RIGHT_ON;
+    LPC_SCT2->OUT[1].CLR = 1 << PWM_2_EV_RIGHT_OFF;
+    /* ADC trigger rises in middle of each on-time, ADC converts one motor current per edge */
+    pwm_sct_event(LPC_SCT2, PWM_2_EV_LEFT_SAMPLE, 1);
+    pwm_sct_event(LPC_SCT2, PWM_2_EV_RIGHT_SAMPLE, period / 2 + 1);
+    LPC_SCT2->OUT[PWM_2_ADC_OUT].SET = (1 << PWM_2_EV_LEFT_SAMPLE) | (1 << PWM_2_EV_RIGHT_SAMPLE);
+    LPC_SCT2->OUT[PWM_2_ADC_OUT].CLR = (1 << PWM_2_EV_LIMIT) | (1 << PWM_2_EV_RIGHT_ON);
+    LPC_SCT2->OUTPUTDIRCTRL = 0;
 
     for(i = 2; i < 4; i++)
     {
-        /* Use SCT2_OUTx pin. */
-        Chip_SCTPWM_SetOutPin(pwm_config[i].sct, pwm_config[i].index, i - 2);
         /* Start with 0% duty cycle */
-        Chip_SCTPWM_SetDutyCycle(pwm_config[i].sct, pwm_config[i].index, 0);
+        pwm_set((pwm_id_t)i, 0);
     }
 
     Chip_SCTPWM_Start(LPC_SCT2);
@@ -140,23 +177,56 @@ void pwm_init(void)
     return;
 }
 
+uint32_t pwm_get_period(pwm_id_t id)
+{
+    return Chip_SCTPWM_GetTicksPerCycle(pwm_config[id].sct);
+}
+
 uint32_t pwm_get_duty_cycle(pwm_id_t id)
 {
-    return Chip_SCTPWM_GetDutyCycle(pwm_config[id].sct, pwm_config[id].index);
+    return pwm_duty[id];
 }
 
 void pwm_set(pwm_id_t id, uint32_t duty_cycle)
 {
-    Chip_SCTPWM_SetDutyCycle(pwm_config[id].sct, pwm_config[id].index, duty_cycle);
+    const pwm_t *pwm = &pwm_config[id];
+    uint32_t period = Chip_SCTPWM_GetTicksPerCycle(pwm->sct);
+    uint32_t half = period / 2;
+    uint32_t sample = duty_cycle / 2;
+
+    if(duty_cycle > period)
+    {
+        duty_cycle = period;
+    }
+    pwm_duty[id] = duty_cycle;
+
+    /* Reload registers take effect at period end, so duty never changes mid period */
+    if(pwm->shift == false)
+    {
+        Chip_SCTPWM_SetDutyCycle(pwm->sct, pwm->index, duty_cycle);
+        sample = sample < 1 ? 1 : (sample >= half ? half - 1 : sample);
+    }
+    else
+    {
+        /* Off event wraps into next period when on-time is longer than half period */
+        Chip_SCT_SetMatchReload(pwm->sct, (CHIP_SCT_MATCH_REG_T)pwm->index, (half + duty_cycle) % period);
+        sample = half + (sample < 1 ? 1 : (sample >= half ? half - 1 : sample));
+    }
+    /* On and off events coincide at 100 %, conflict resolution keeps output on */
+    Chip_SCT_SetConflictResolution(pwm->sct, pwm->out,
+        duty_cycle >= period ? SCT_RES_SET_OUTPUT : SCT_RES_CLEAR_OUTPUT);
+    /* Sample point is kept strictly inside its half period, so ADC trigger always gets both edges */
+    if(pwm->sample != 0)
+    {
+        Chip_SCT_SetMatchReload(pwm->sct, (CHIP_SCT_MATCH_REG_T)pwm->sample, sample);
+    }
 
     return;
 }
 
 void pwm_set_percentage(pwm_id_t id, uint8_t percentage)
 {
-    uint32_t duty_cycle = Chip_SCTPWM_PercentageToTicks(pwm_config[id].sct, percentage);
-
-    Chip_SCTPWM_SetDutyCycle(pwm_config[id].sct, pwm_config[id].index, duty_cycle);
+    pwm_set(id, Chip_SCTPWM_PercentageToTicks(pwm_config[id].sct, percentage));
 
     return;
 }
@@ -164,3 +234,20 @@ void pwm_set_percentage(pwm_id_t id, uint8_t percentage)
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
+/**
+ * @brief   Setup event triggered by match register with same index, in single state.
+ *
+ * @param   sct     SCT to setup.
+ * @param   event   Event and match register index.
+ * @param   match   Initial match value.
+ */
+static void pwm_sct_event(LPC_SCT_T *sct, uint8_t event, uint32_t match)
+{
+    Chip_SCT_SetMatchCount(sct, (CHIP_SCT_MATCH_REG_T)event, match);
+    Chip_SCT_SetMatchReload(sct, (CHIP_SCT_MATCH_REG_T)event, match);
+    /* Match only condition */
+    sct->EVENT[event].CTRL = event | (1 << 12);
+    sct->EVENT[event].STATE = 1;
+
+    return;
+}
@@ -33,6 +33,7 @@ extern "C" {
  *********************************************************************************************************************/
 #define PWM_0_RATE    50    //!< PWM frequency in Hz.
 #define PWM_2_RATE    500 //!< PWM frequency in Hz.
+#define PWM_2_ADC_OUT 3   //!< SCT2 output rising in middle of each motor on-time, triggers ADC0 sequence B.
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -58,6 +59,7 @@ typedef enum
  * Prototypes of exported functions
  *********************************************************************************************************************/
 void pwm_init(void);
+uint32_t pwm_get_period(pwm_id_t id);
 uint32_t pwm_get_duty_cycle(pwm_id_t id);
 void pwm_set(pwm_id_t id, uint32_t duty_cycle);
 void pwm_set_percentage(pwm_id_t id, uint8_t percentage);
@@ -26,18 +26,20 @@
 #include "chip.h"
 
 #include "spi.h"
+#include "dma.h"
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
-#define SPI_0_TX_BUFFER_SIZE    128
-#define SPI_0_RX_BUFFER_SIZE    128
-#define SPI_1_TX_BUFFER_SIZE    128
-#define SPI_1_RX_BUFFER_SIZE    128
+/** Byte clocked out while only receiving. */
+#define SPI_DUMMY_BYTE          0xFF
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
+/** Transfer control: 8 bit frames, assert only SSEL0. */
+#define SPI_TXCTL_SSEL0_ONLY    (SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | \
+                                 SPI_TXCTL_DEASSERT_SSEL3)
 
 /**********************************************************************************************************************
  * Private typedef
@@ -46,14 +48,8 @@
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
-/** SPI-0 Transfer Setup */
-static SPI_DATA_SETUP_T spi_0_xfer;
-static uint16_t spi_0_tx_buffer[SPI_0_TX_BUFFER_SIZE] = {0};
-static uint16_t spi_0_rx_buffer[SPI_0_RX_BUFFER_SIZE] = {0};
-/** SPI-1 Transfer Setup */
-static SPI_DATA_SETUP_T spi_1_xfer;
-static uint16_t spi_1_tx_buffer[SPI_1_TX_BUFFER_SIZE] = {0};
-static uint16_t spi_1_rx_buffer[SPI_1_RX_BUFFER_SIZE] = {0};
+/** SPI-0 DMA completion callback */
+static spi_cb_t spi_0_dma_cb = NULL;
 
 /**********************************************************************************************************************
  * Exported variables
@@ -62,6 +58,8 @@ static uint16_t spi_1_rx_buffer[SPI_1_RX_BUFFER_SIZE] = {0};
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+static void spi_transfer(LPC_SPI_T *spi, const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size);
+static void spi_0_dma_done(dma_id_t id, bool error);
 
 /**********************************************************************************************************************
  * Exported functions
@@ -117,96 +115,56 @@ void spi_0_init(void)
     return;
 }
 
-void spi_0_read_buffer(uint8_t *buffer, uint16_t size)
+void spi_0_set_config(uint16_t clk_div, uint8_t mode)
 {
-    uint16_t i = 0;
-    uint16_t j = 0;
+    const SPI_CLOCK_MODE_T modes[] = {SPI_CLOCK_MODE0, SPI_CLOCK_MODE1, SPI_CLOCK_MODE2, SPI_CLOCK_MODE3};
+    SPI_CFG_T spi_cfg;
 
-    spi_0_xfer.pTx = NULL;                                                          /* Transmit Buffer */
-    spi_0_xfer.pRx = spi_0_rx_buffer;                                               /* Receive Buffer */
-    spi_0_xfer.DataSize = 8;                                                        /* Data size in bits */
-    spi_0_xfer.Length = size > SPI_0_RX_BUFFER_SIZE ? SPI_0_RX_BUFFER_SIZE : size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_0_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_0_xfer.TxCnt = 0;
-    spi_0_xfer.RxCnt = 0;
+    spi_cfg.ClkDiv      = clk_div;
+    spi_cfg.Mode        = SPI_MODE_MASTER;
+    spi_cfg.ClockMode   = modes[mode & 0x03];
+    spi_cfg.DataOrder   = SPI_DATA_MSB_FIRST;
+    spi_cfg.SSELPol     = (SPI_CFG_SPOL0_LO | SPI_CFG_SPOL1_LO | SPI_CFG_SPOL2_LO | SPI_CFG_SPOL3_LO);
+    Chip_SPI_SetConfig(LPC_SPI0, &spi_cfg);
 
-    Chip_SPI_RWFrames_Blocking(LPC_SPI0, &spi_0_xfer);
+    return;
+}
 
-    for(i = 1; i < (size + 1) && i < SPI_0_RX_BUFFER_SIZE; i++)
-    {
-        buffer[i - 1] = spi_0_rx_buffer[j];
-        if(i % 2)
-        {
-            buffer[i - 1] = (uint8_t)((spi_0_rx_buffer[j] >> 8) & 0xFF);
-        }
-        else
-        {
-            buffer[i - 1] = (uint8_t)(spi_0_rx_buffer[j] & 0xFF);
-        }
-    }
+void spi_0_read_buffer(uint8_t *buffer, uint16_t size)
+{
+    spi_transfer(LPC_SPI0, NULL, 0, buffer, size);
 
     return;
 }
 
-void spi_0_write_buffer(uint8_t *buffer, uint16_t size)
+void spi_0_write_buffer(const uint8_t *buffer, uint16_t size)
 {
-    uint16_t i = 0;
-    
-    for(i = 0; i < size && i < SPI_0_TX_BUFFER_SIZE; i++)
-    {
-        spi_0_tx_buffer[i] = buffer[i];
-    }    
+    spi_transfer(LPC_SPI0, buffer, size, NULL, 0);
 
-    spi_0_xfer.pTx = spi_0_tx_buffer;                                               /* Transmit Buffer */
-    spi_0_xfer.pRx = NULL;                                                          /* Receive Buffer */
-    spi_0_xfer.DataSize = 8;                                                        /* Data size in bits */
-    spi_0_xfer.Length = size > SPI_0_TX_BUFFER_SIZE ? SPI_0_TX_BUFFER_SIZE : size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_0_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_0_xfer.TxCnt = 0;
-    spi_0_xfer.RxCnt = 0;
+    return;
+}
 
-    Chip_SPI_WriteFrames_Blocking(LPC_SPI0, &spi_0_xfer);
+void spi_0_write_read(const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size)
+{
+    spi_transfer(LPC_SPI0, tx, tx_size, rx, rx_size);
 
     return;
 }
 
-void spi_0_write_read(uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size)
+bool spi_0_write_buffer_dma(uint8_t *buffer, uint16_t size, spi_cb_t cb)
 {
-    uint16_t i = 0;
-    uint16_t j = 0;
-
-    for(i = 0; i < tx_size && i < SPI_0_TX_BUFFER_SIZE; i++)
+    if(dma_is_busy(DMA_ID_SPI_0_TX))
     {
-        spi_0_tx_buffer[i] = tx[i];
+        return false;
     }
 
-    spi_0_xfer.pTx = spi_0_tx_buffer;       /* Transmit Buffer */
-    spi_0_xfer.pRx = spi_0_rx_buffer;       /* Receive Buffer */
-    spi_0_xfer.DataSize = 8;                /* Data size in bits */
-    spi_0_xfer.Length = tx_size + rx_size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_0_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_0_xfer.TxCnt = 0;
-    spi_0_xfer.RxCnt = 0;
-
-    Chip_SPI_RWFrames_Blocking(LPC_SPI0, &spi_0_xfer);
+    Chip_SPI_ClearStatus(LPC_SPI0, SPI_STAT_CLR_RXOV | SPI_STAT_CLR_TXUR | SPI_STAT_CLR_SSA | SPI_STAT_CLR_SSD);
+    /* Every byte written to TXDAT by DMA is sent as 8 bit frame, receive is ignored */
+    Chip_SPI_SetControlInfo(LPC_SPI0, 8, SPI_TXCTL_SSEL0_ONLY | SPI_TXCTL_EOF | SPI_TXCTL_RXIGNORE);
 
-    for(i = 1; i < (rx_size + 1) && i < SPI_0_RX_BUFFER_SIZE; i++)
-    {
-        rx[i - 1] = spi_0_rx_buffer[j];
-        if(i % 2)
-        {
-            rx[i - 1] = (uint8_t)((spi_0_rx_buffer[j] >> 8) & 0xFF);
-        }
-        else
-        {
-            rx[i - 1] = (uint8_t)(spi_0_rx_buffer[j] & 0xFF);
-        }
-    }
+    spi_0_dma_cb = cb;
 
-    return;
+    return dma_start(DMA_ID_SPI_0_TX, buffer, size, spi_0_dma_done);
 }
 
 void spi_1_init(void)
@@ -264,97 +222,95 @@ void spi_1_init(void)
 
 void spi_1_read_buffer(uint8_t *buffer, uint16_t size)
 {
-    uint16_t i = 0;
-    uint16_t j = 0;
-
-    spi_1_xfer.pTx = NULL;                                                          /* Transmit Buffer */
-    spi_1_xfer.pRx = spi_0_rx_buffer;                                               /* Receive Buffer */
-    spi_1_xfer.DataSize = 8;                                                        /* Data size in bits */
-    spi_1_xfer.Length = size > SPI_1_RX_BUFFER_SIZE ? SPI_1_RX_BUFFER_SIZE : size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_1_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_1_xfer.TxCnt = 0;
-    spi_1_xfer.RxCnt = 0;
-
-    Chip_SPI_RWFrames_Blocking(LPC_SPI1, &spi_1_xfer);
-
-    for(i = 1; i < (size + 1) && i < SPI_1_RX_BUFFER_SIZE; i++)
-    {
-        buffer[i - 1] = spi_1_rx_buffer[j];
-        if(i % 2)
-        {
-            buffer[i - 1] = (uint8_t)((spi_1_rx_buffer[j] >> 8) & 0xFF);
-        }
-        else
-        {
-            buffer[i - 1] = (uint8_t)(spi_1_rx_buffer[j] & 0xFF);
-        }
-    }
+    spi_transfer(LPC_SPI1, NULL, 0, buffer, size);
 
     return;
 }
 
-void spi_1_write_buffer(uint8_t *buffer, uint16_t size)
+void spi_1_write_buffer(const uint8_t *buffer, uint16_t size)
 {
-    uint16_t i = 0;
+    spi_transfer(LPC_SPI1, buffer, size, NULL, 0);
 
-    for(i = 0; i < size && i < SPI_1_TX_BUFFER_SIZE; i++)
-    {
-        spi_1_tx_buffer[i] = buffer[i];
-    }
-
-    spi_1_xfer.pTx = spi_1_tx_buffer;                                               /* Transmit Buffer */
-    spi_1_xfer.pRx = NULL;                                                          /* Receive Buffer */
-    spi_1_xfer.DataSize = 8;                                                        /* Data size in bits */
-    spi_1_xfer.Length = size > SPI_1_TX_BUFFER_SIZE ? SPI_1_TX_BUFFER_SIZE : size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_1_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_1_xfer.TxCnt = 0;
-    spi_1_xfer.RxCnt = 0;
+    return;
+}
 
-    Chip_SPI_WriteFrames_Blocking(LPC_SPI1, &spi_1_xfer);
+void spi_1_write_read(const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size)
+{
+    spi_transfer(LPC_SPI1, tx, tx_size, rx, rx_size);
 
     return;
 }
 
-void spi_1_write_read(uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size)
+/**
+ * ********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Blocking transfer straight between caller buffers and SPI data registers.
+ *
+ * @param   spi     SPI peripheral.
+ * @param   tx      Bytes sent first, can be NULL when tx_size is 0.
+ * @param   tx_size Number of bytes to send.
+ * @param   rx      Buffer for bytes received after tx part, dummy bytes are clocked out meanwhile. Can be NULL when
+ *                  rx_size is 0.
+ * @param   rx_size Number of bytes to receive.
+ */
+static void spi_transfer(LPC_SPI_T *spi, const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size)
 {
-    uint16_t i = 0;
-    uint16_t j = 0;
+    uint32_t i = 0;
+    uint32_t size = (uint32_t)tx_size + rx_size;
+    uint32_t control = SPI_TXCTL_SSEL0_ONLY | SPI_TXCTL_EOF;
+    uint16_t data = 0;
 
-    for(i = 1; i < tx_size && i < SPI_1_TX_BUFFER_SIZE; i++)
+    if(size == 0)
     {
-        spi_1_tx_buffer[i] = tx[i];
+        return;
     }
 
-    spi_1_xfer.pTx = spi_1_tx_buffer;       /* Transmit Buffer */
-    spi_1_xfer.pRx = spi_1_rx_buffer;       /* Receive Buffer */
-    spi_1_xfer.DataSize = 8;                /* Data size in bits */
-    spi_1_xfer.Length = tx_size + rx_size;  /* Total frame length */
-    /* Assert only SSEL0 */
-    spi_1_xfer.ssel = SPI_TXCTL_ASSERT_SSEL0 | SPI_TXCTL_DEASSERT_SSEL1 | SPI_TXCTL_DEASSERT_SSEL2 | SPI_TXCTL_DEASSERT_SSEL3;
-    spi_1_xfer.TxCnt = 0;
-    spi_1_xfer.RxCnt = 0;
-
-    Chip_SPI_RWFrames_Blocking(LPC_SPI1, &spi_1_xfer);
+    if(rx_size == 0)
+    {
+        control |= SPI_TXCTL_RXIGNORE;
+    }
+    Chip_SPI_ClearStatus(spi, SPI_STAT_CLR_RXOV | SPI_STAT_CLR_TXUR | SPI_STAT_CLR_SSA | SPI_STAT_CLR_SSD);
+    Chip_SPI_SetControlInfo(spi, 8, control);
 
-    for(i = 1; i < (rx_size + 1) && i < SPI_1_RX_BUFFER_SIZE; i++)
+    for(i = 0; i < size; i++)
     {
-        rx[i - 1] = spi_1_rx_buffer[j];
-        if(i % 2)
+        while(!(Chip_SPI_GetStatus(spi) & SPI_STAT_TXRDY)) {}
+        if(i == size - 1)
         {
-            rx[i - 1] = (uint8_t)((spi_1_rx_buffer[j] >> 8) & 0xFF);
+            Chip_SPI_SetControlInfo(spi, 8, control | SPI_TXCTL_EOT);
         }
-        else
+        Chip_SPI_SendMidFrame(spi, i < tx_size ? tx[i] : SPI_DUMMY_BYTE);
+
+        if(rx_size != 0)
         {
-            rx[i - 1] = (uint8_t)(spi_1_rx_buffer[j] & 0xFF);
+            /* Receive in lock step, data register holds single frame only */
+            while(!(Chip_SPI_GetStatus(spi) & SPI_STAT_RXRDY)) {}
+            data = Chip_SPI_ReceiveFrame(spi);
+            if(i >= tx_size)
+            {
+                rx[i - tx_size] = (uint8_t)data;
+            }
         }
     }
 
+    /* Wait for last frame to be shifted out */
+    while(!(Chip_SPI_GetStatus(spi) & SPI_STAT_MSTIDLE)) {}
+
     return;
 }
 
-/**
- * ********************************************************************************************************************
- * Private functions
- *********************************************************************************************************************/
+static void spi_0_dma_done(dma_id_t id, bool error)
+{
+    /* DMA is done when last byte is written to FIFO, wait for it to be shifted out */
+    while(!(Chip_SPI_GetStatus(LPC_SPI0) & SPI_STAT_MSTIDLE)) {}
+    Chip_SPI_ClearStatus(LPC_SPI0, SPI_STAT_FORCE_EOT);
+
+    if(spi_0_dma_cb != NULL)
+    {
+        spi_0_dma_cb(error);
+    }
+
+    return;
+}
@@ -27,6 +27,8 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported constants
@@ -39,6 +41,12 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
+/**
+ * @brief   SPI transfer completion callback. Called from interrupt context.
+ *
+ * @param   error   True if transfer ended with error.
+ */
+typedef void (*spi_cb_t)(bool error);
 
 /**********************************************************************************************************************
  * Prototypes of exported variables
@@ -48,14 +56,58 @@ extern "C" {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 void spi_0_init(void);
+
+/**
+ * @brief   Change SPI-0 clock and mode. Bus must be idle.
+ *
+ * @param   clk_div SPI clock divider, SPI clock = system clock / (clk_div + 1).
+ * @param   mode    SPI mode, 0 - 3.
+ */
+void spi_0_set_config(uint16_t clk_div, uint8_t mode);
+
+/**
+ * @brief   Blocking read, dummy bytes are sent meanwhile. Data goes straight to buffer, any size.
+ *
+ * @param   buffer  Buffer for received data.
+ * @param   size    Number of bytes to read.
+ */
 void spi_0_read_buffer(uint8_t *buffer, uint16_t size);
-void spi_0_write_buffer(uint8_t *buffer, uint16_t size);
-void spi_0_write_read(uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size);
+
+/**
+ * @brief   Blocking write straight from buffer, any size. Returns after last byte is shifted out.
+ *
+ * @param   buffer  Data to write.
+ * @param   size    Number of bytes to write.
+ */
+void spi_0_write_buffer(const uint8_t *buffer, uint16_t size);
+
+/**
+ * @brief   Blocking write followed by read in one transfer, e.g. command and its response.
+ *
+ * @param   tx      Data to write.
+ * @param   tx_size Number of bytes to write.
+ * @param   rx      Buffer for data received after tx part.
+ * @param   rx_size Number of bytes to read.
+ */
+void spi_0_write_read(const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size);
+
+/**
+ * @brief   Start non-blocking write of buffer using DMA.
+ *
+ * @param   buffer  Data to write. Must stay valid until completion callback.
+ * @param   size    Size of data in bytes, up to @ref DMA_MAX_TRANSFER.
+ * @param   cb      Completion callback, called after last frame is shifted out. Can be NULL.
+ *
+ * @return  State of start.
+ * @retval  0   failed, previous transfer still in progress.
+ * @retval  1   success.
+ */
+bool spi_0_write_buffer_dma(uint8_t *buffer, uint16_t size, spi_cb_t cb);
 
 void spi_1_init(void);
 void spi_1_read_buffer(uint8_t *buffer, uint16_t size);
-void spi_1_write_buffer(uint8_t *buffer, uint16_t size);
-void spi_1_write_read(uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size);
+void spi_1_write_buffer(const uint8_t *buffer, uint16_t size);
+void spi_1_write_read(const uint8_t *tx, uint16_t tx_size, uint8_t *rx, uint16_t rx_size);
 
 #ifdef __cplusplus
 }
@@ -21,8 +21,10 @@
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "chip.h"
+#include "cmsis_os2.h"
 
 #include "uart.h"
 
@@ -102,7 +104,31 @@ void uart_0_send(uint8_t *data, uint32_t size)
 
 void uart_0_send_rb(uint8_t *data, uint32_t size)
 {
-    Chip_UART_SendRB(LPC_USART0, (RINGBUFF_T *)&uart0_tx_rb, data, size);
+    uint32_t count = 0;
+    bool queued = false;
+    bool thread = osKernelGetState() == osKernelRunning && __get_IPSR() == 0U;
+
+    while(size > 0)
+    {
+        count = size > UART_0_TX_BUFFER_SIZE ? UART_0_TX_BUFFER_SIZE : size;
+        /* Free space is checked and taken in one step, other sender can not take it in between */
+        __disable_irq();
+        if((queued = uart_0_tx_free() >= count) == true)
+        {
+            Chip_UART_SendRB(LPC_USART0, (RINGBUFF_T *)&uart0_tx_rb, data, count);
+        }
+        __enable_irq();
+        if(queued == true)
+        {
+            data += count;
+            size -= count;
+        }
+        else if(thread)
+        {
+            /* Ring drains at baud rate, let other threads run meanwhile */
+            osDelay(1);
+        }
+    }
 
     return;
 }
@@ -112,6 +138,11 @@ uint32_t uart_0_read_rb(uint8_t *data, uint32_t size)
     return Chip_UART_ReadRB(LPC_USART0, (RINGBUFF_T *)&uart0_rx_rb, data, size);
 }
 
+uint32_t uart_0_tx_free(void)
+{
+    return RingBuffer_GetFree((RINGBUFF_T *)&uart0_tx_rb);
+}
+
 void UART0_IRQHandler(void)
 {
     Chip_UART_IRQRBHandler(LPC_USART0, (RINGBUFF_T *)&uart0_rx_rb, (RINGBUFF_T *)&uart0_tx_rb);
@@ -33,7 +33,7 @@ extern "C" {
  *********************************************************************************************************************/
 #define UART_0_BAUDRATE         115200
 #define UART_0_RX_BUFFER_SIZE   128
-#define UART_0_TX_BUFFER_SIZE   128
+#define UART_0_TX_BUFFER_SIZE   512
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -51,9 +51,27 @@ extern "C" {
  * Prototypes of exported functions
  *********************************************************************************************************************/
 void uart_0_init(void);
+
+/**
+ * @brief   Send data directly to transmitter, bypassing transmit ring. Only for error and fault handlers where UART
+ *          interrupt does not run, data can land in middle of queued data.
+ *
+ * @param   data    Data.
+ * @param   size    Data size.
+ */
 void uart_0_send(uint8_t *data, uint32_t size);
+
+/**
+ * @brief   Queue data into transmit ring, waiting while ring is full. Data of one call up to ring size is queued at
+ *          once, so data of senders from several threads is not mixed. Called from thread, sleeps one tick between
+ *          retries, before kernel start or from interrupt it spins.
+ *
+ * @param   data    Data.
+ * @param   size    Data size.
+ */
 void uart_0_send_rb(uint8_t *data, uint32_t size);
 uint32_t uart_0_read_rb(uint8_t *data, uint32_t size);
+uint32_t uart_0_tx_free(void);
 
 #ifdef __cplusplus
 }
@@ -26,6 +26,7 @@
 
 #include "bsp.h"
 #include "periph/adc.h"
+#include "periph/dma.h"
 #include "periph/gpio.h"
 #include "periph/spi.h"
 #include "periph/rtc.h"
@@ -66,6 +67,7 @@ void bsp_init(void)
     Chip_SYSCTL_PeriphReset(RESET_IOCON);
 
     gpio_init();
+    dma_init();
     adc_init();
     i2c_init();
     uart_0_init();
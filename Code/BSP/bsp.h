@@ -30,6 +30,7 @@ extern "C" {
 #include "chip.h"
 
 #include "periph/adc.h"
+#include "periph/dma.h"
 #include "periph/gpio.h"
 #include "periph/i2c.h"
 #include "periph/pwm.h"
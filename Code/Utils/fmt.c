@@ -0,0 +1,425 @@
+/**
+ **********************************************************************************************************************
+ * @file         fmt.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Small printf style formatter without floating point support.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "fmt.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define FMT_FLAG_LEFT       0x01    //!< '-' Align left.
+#define FMT_FLAG_ZERO       0x02    //!< '0' Pad number with zeros.
+#define FMT_FLAG_PLUS       0x04    //!< '+' Always print sign.
+#define FMT_FLAG_SPACE      0x08    //!< ' ' Space instead of plus sign.
+
+#define FMT_LENGTH_NONE     0       //!< int.
+#define FMT_LENGTH_HH       1       //!< 'hh' char.
+#define FMT_LENGTH_H        2       //!< 'h' short.
+#define FMT_LENGTH_L        3       //!< 'l' long.
+#define FMT_LENGTH_LL       4       //!< 'll' long long.
+#define FMT_LENGTH_Z        5       //!< 'z' size_t.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Read signed integer argument of given length. */
+#define FMT_ARG_SIGNED(ARGS, LENGTH)                                                                                \
+    ((LENGTH) == FMT_LENGTH_LL ? (int64_t)va_arg(ARGS, long long) :                                                 \
+     (LENGTH) == FMT_LENGTH_L ? (int64_t)va_arg(ARGS, long) :                                                       \
+     (LENGTH) == FMT_LENGTH_Z ? (int64_t)va_arg(ARGS, ptrdiff_t) :                                                  \
+     (LENGTH) == FMT_LENGTH_H ? (int64_t)(short)va_arg(ARGS, int) :                                                 \
+     (LENGTH) == FMT_LENGTH_HH ? (int64_t)(signed char)va_arg(ARGS, int) : (int64_t)va_arg(ARGS, int))
+
+/** Read unsigned integer argument of given length. */
+#define FMT_ARG_UNSIGNED(ARGS, LENGTH)                                                                              \
+    ((LENGTH) == FMT_LENGTH_LL ? (uint64_t)va_arg(ARGS, unsigned long long) :                                       \
+     (LENGTH) == FMT_LENGTH_L ? (uint64_t)va_arg(ARGS, unsigned long) :                                             \
+     (LENGTH) == FMT_LENGTH_Z ? (uint64_t)va_arg(ARGS, size_t) :                                                    \
+     (LENGTH) == FMT_LENGTH_H ? (uint64_t)(unsigned short)va_arg(ARGS, unsigned int) :                              \
+     (LENGTH) == FMT_LENGTH_HH ? (uint64_t)(unsigned char)va_arg(ARGS, unsigned int) :                              \
+     (uint64_t)va_arg(ARGS, unsigned int))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    char *buffer;
+    uint32_t size;
+    uint32_t len;
+} fmt_out_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static inline void fmt_putc(fmt_out_t *out, char c);
+static void fmt_pad(fmt_out_t *out, char c, int32_t count);
+static void fmt_string(fmt_out_t *out, const char *str, uint8_t flags, int32_t width, int32_t precision);
+static void fmt_number(fmt_out_t *out, uint64_t value, bool negative, uint8_t base, bool upper, uint8_t flags,
+                       int32_t width, int32_t precision);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+uint32_t fmt_vsnprintf(char *buffer, uint32_t size, const char *fmt, va_list args)
+{
+    fmt_out_t out = {buffer, size, 0};
+    uint8_t flags = 0;
+    int32_t width = 0;
+    int32_t precision = 0;
+    uint8_t length = 0;
+    int64_t value = 0;
+    char c = 0;
+
+    if(size == 0)
+    {
+        return 0;
+    }
+
+    while((c = *fmt++) != 0)
+    {
+        if(c != '%')
+        {
+            fmt_putc(&out, c);
+            continue;
+        }
+
+        /* Flags */
+        flags = 0;
+        while(1)
+        {
+            c = *fmt;
+            if(c == '-')
+            {
+                flags |= FMT_FLAG_LEFT;
+            }
+            else if(c == '0')
+            {
+                flags |= FMT_FLAG_ZERO;
+            }
+            else if(c == '+')
+            {
+                flags |= FMT_FLAG_PLUS;
+            }
+            else if(c == ' ')
+            {
+                flags |= FMT_FLAG_SPACE;
+            }
+            else
+            {
+                break;
+            }
+            fmt++;
+        }
+
+        /* Width */
+        width = 0;
+        if(*fmt == '*')
+        {
+            width = va_arg(args, int);
+            if(width < 0)
+            {
+                flags |= FMT_FLAG_LEFT;
+                width = -width;
+            }
+            fmt++;
+        }
+        while(*fmt >= '0' && *fmt <= '9')
+        {
+            width = width * 10 + (*fmt++ - '0');
+        }
+
+        /* Precision */
+        precision = -1;
+        if(*fmt == '.')
+        {
+            fmt++;
+            precision = 0;
+            if(*fmt == '*')
+            {
+                precision = va_arg(args, int);
+                fmt++;
+            }
+            while(*fmt >= '0' && *fmt <= '9')
+            {
+                precision = precision * 10 + (*fmt++ - '0');
+            }
+        }
+
+        /* Length */
+        length = FMT_LENGTH_NONE;
+        if(*fmt == 'h')
+        {
+            fmt++;
+            length = FMT_LENGTH_H;
+            if(*fmt == 'h')
+            {
+                fmt++;
+                length = FMT_LENGTH_HH;
+            }
+        }
+        else if(*fmt == 'l')
+        {
+            fmt++;
+            length = FMT_LENGTH_L;
+            if(*fmt == 'l')
+            {
+                fmt++;
+                length = FMT_LENGTH_LL;
+            }
+        }
+        else if(*fmt == 'z')
+        {
+            fmt++;
+            length = FMT_LENGTH_Z;
+        }
+
+        switch(c = *fmt++)
+        {
+            case 'd':
+            case 'i':
+                value = FMT_ARG_SIGNED(args, length);
+                fmt_number(&out, value < 0 ? -(uint64_t)value : (uint64_t)value, value < 0, 10, false, flags, width,
+                           precision);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                fmt_number(&out, FMT_ARG_UNSIGNED(args, length), false, c == 'u' ? 10 : (c == 'o' ? 8 : 16), c == 'X',
+                           flags, width, precision);
+                break;
+            case 'p':
+                fmt_putc(&out, '0');
+                fmt_putc(&out, 'x');
+                fmt_number(&out, (uintptr_t)va_arg(args, void *), false, 16, false, FMT_FLAG_ZERO,
+                           (int32_t)sizeof(void *) * 2, -1);
+                break;
+            case 'c':
+                c = (char)va_arg(args, int);
+                if(!(flags & FMT_FLAG_LEFT))
+                {
+                    fmt_pad(&out, ' ', width - 1);
+                }
+                fmt_putc(&out, c);
+                if(flags & FMT_FLAG_LEFT)
+                {
+                    fmt_pad(&out, ' ', width - 1);
+                }
+                break;
+            case 's':
+                fmt_string(&out, va_arg(args, const char *), flags, width, precision);
+                break;
+            case '%':
+                fmt_putc(&out, '%');
+                break;
+            case 0:
+                /* Format ends with '%' */
+                fmt--;
+                break;
+            default:
+                /* Unknown conversion, print it as is */
+                fmt_putc(&out, '%');
+                fmt_putc(&out, c);
+                break;
+        }
+    }
+
+    out.buffer[out.len] = 0;
+
+    return out.len;
+}
+
+uint32_t fmt_snprintf(char *buffer, uint32_t size, const char *fmt, ...)
+{
+    uint32_t len = 0;
+    va_list args;
+
+    va_start(args, fmt);
+    len = fmt_vsnprintf(buffer, size, fmt, args);
+    va_end(args);
+
+    return len;
+}
+
+const char *fmt_fixed(char *buffer, int32_t value, uint8_t decimals)
+{
+    uint32_t scale = 1;
+    uint32_t abs = value < 0 ? -(uint32_t)value : (uint32_t)value;
+    uint8_t i = 0;
+
+    decimals = decimals > 9 ? 9 : decimals;
+    for(i = 0; i < decimals; i++)
+    {
+        scale *= 10;
+    }
+
+    if(decimals == 0)
+    {
+        fmt_snprintf(buffer, FMT_FIXED_SIZE, "%d", value);
+    }
+    else
+    {
+        fmt_snprintf(buffer, FMT_FIXED_SIZE, "%s%u.%0*u", value < 0 ? "-" : "", abs / scale, decimals, abs % scale);
+    }
+
+    return buffer;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static inline void fmt_putc(fmt_out_t *out, char c)
+{
+    /* Keep space for terminating zero, drop what does not fit */
+    if(out->len < out->size - 1)
+    {
+        out->buffer[out->len++] = c;
+    }
+
+    return;
+}
+
+static void fmt_pad(fmt_out_t *out, char c, int32_t count)
+{
+    while(count-- > 0)
+    {
+        fmt_putc(out, c);
+    }
+
+    return;
+}
+
+static void fmt_string(fmt_out_t *out, const char *str, uint8_t flags, int32_t width, int32_t precision)
+{
+    int32_t len = 0;
+
+    if(str == 0)
+    {
+        str = "(null)";
+    }
+    while(str[len] != 0 && (precision < 0 || len < precision))
+    {
+        len++;
+    }
+
+    if(!(flags & FMT_FLAG_LEFT))
+    {
+        fmt_pad(out, ' ', width - len);
+    }
+    while(len--)
+    {
+        fmt_putc(out, *str++);
+        width--;
+    }
+    if(flags & FMT_FLAG_LEFT)
+    {
+        fmt_pad(out, ' ', width);
+    }
+
+    return;
+}
+
+static void fmt_number(fmt_out_t *out, uint64_t value, bool negative, uint8_t base, bool upper, uint8_t flags,
+                       int32_t width, int32_t precision)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[22];
+    uint32_t value32 = 0;
+    int32_t len = 0;
+    int32_t zeros = 0;
+    char sign = 0;
+
+    /* Digits in reverse order, 64 bit division only while upper half is used */
+    while(value >> 32 != 0)
+    {
+        tmp[len++] = digits[value % base];
+        value /= base;
+    }
+    value32 = (uint32_t)value;
+    do
+    {
+        tmp[len++] = digits[value32 % base];
+        value32 /= base;
+    } while(value32 != 0);
+    if(precision == 0 && len == 1 && tmp[0] == '0')
+    {
+        len = 0;
+    }
+
+    if(negative)
+    {
+        sign = '-';
+    }
+    else if(flags & FMT_FLAG_PLUS)
+    {
+        sign = '+';
+    }
+    else if(flags & FMT_FLAG_SPACE)
+    {
+        sign = ' ';
+    }
+
+    /* Precision gives minimum digits, otherwise '0' flag pads to width */
+    if(precision >= 0)
+    {
+        zeros = precision > len ? precision - len : 0;
+    }
+    else if((flags & FMT_FLAG_ZERO) && !(flags & FMT_FLAG_LEFT))
+    {
+        zeros = width - len - (sign ? 1 : 0);
+        zeros = zeros < 0 ? 0 : zeros;
+    }
+    width -= len + zeros + (sign ? 1 : 0);
+
+    if(!(flags & FMT_FLAG_LEFT))
+    {
+        fmt_pad(out, ' ', width);
+    }
+    if(sign)
+    {
+        fmt_putc(out, sign);
+    }
+    fmt_pad(out, '0', zeros);
+    while(len--)
+    {
+        fmt_putc(out, tmp[len]);
+    }
+    if(flags & FMT_FLAG_LEFT)
+    {
+        fmt_pad(out, ' ', width);
+    }
+
+    return;
+}
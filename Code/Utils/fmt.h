@@ -0,0 +1,100 @@
+/**
+ **********************************************************************************************************************
+ * @file        fmt.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Small printf style formatter without floating point support.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdarg.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define FMT_FIXED_SIZE      14  //!< Buffer size needed by @ref fmt_fixed().
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/** Let compiler check format string and arguments like for printf. */
+#if defined(__CC_ARM) || defined(__GNUC__)
+#define FMT_CHECK(f, a)     __attribute__((format(printf, f, a)))
+#else
+#define FMT_CHECK(f, a)
+#endif
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Format string to buffer. Supports subset of printf:
+ *          %d %i %u %x %X %o %c %s %p %%, flags '-' '0' '+' ' ', width and precision (also '*'), length modifiers
+ *          'hh', 'h', 'l', 'll' and 'z'. 64 bit division is used only for values that do not fit 32 bits. No
+ *          floating point.
+ *
+ * @param   buffer  Output buffer, always zero terminated when size is not 0.
+ * @param   size    Size of buffer.
+ * @param   fmt     Format string.
+ * @param   args    Arguments.
+ *
+ * @return  Number of characters written, without terminating zero. Unlike vsnprintf, never more than size - 1.
+ */
+uint32_t fmt_vsnprintf(char *buffer, uint32_t size, const char *fmt, va_list args);
+
+/**
+ * @brief   Format string to buffer. See @ref fmt_vsnprintf().
+ *
+ * @param   buffer  Output buffer, always zero terminated when size is not 0.
+ * @param   size    Size of buffer.
+ * @param   fmt     Format string.
+ *
+ * @return  Number of characters written, without terminating zero.
+ */
+uint32_t fmt_snprintf(char *buffer, uint32_t size, const char *fmt, ...) FMT_CHECK(3, 4);
+
+/**
+ * @brief   Format fixed point value, e.g. 2534 with 2 decimals gives "25.34". Result is meant for %s.
+ *
+ * @param   buffer      Output buffer of at least @ref FMT_FIXED_SIZE bytes.
+ * @param   value       Value scaled by 10^decimals.
+ * @param   decimals    Number of decimals, 0 - 9.
+ *
+ * @return  Pointer to buffer.
+ */
+const char *fmt_fixed(char *buffer, int32_t value, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FMT_H_ */
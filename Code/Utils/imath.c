@@ -0,0 +1,218 @@
+/**
+ **********************************************************************************************************************
+ * @file         imath.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Integer square root, CORDIC atan2 and sin/cos with binary angles.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "imath.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define IMATH_CORDIC_STEPS  20          //!< CORDIC iterations, angle error below 0.0002 degrees.
+#define IMATH_CORDIC_BITS   28          //!< Vector coordinates are scaled up to this many bits.
+#define IMATH_CORDIC_GAIN   652032874   //!< Inverse of CORDIC gain in Q30.
+#define IMATH_CORDIC_180    0x80000000UL    //!< 180 degrees in 32 bit binary angle.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** atan(2^-i) as 32 bit binary angle. */
+static const uint32_t imath_cordic_atan[IMATH_CORDIC_STEPS] =
+{
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245, 2670163, 1335087,
+    667544, 333772, 166886, 83443, 41722, 20861, 10430, 5215, 2608, 1304,
+};
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+uint32_t imath_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while(bit > value)
+    {
+        bit >>= 2;
+    }
+    while(bit != 0)
+    {
+        if(value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+uint32_t imath_vector(int32_t x, int32_t y, uint16_t *angle)
+{
+    uint32_t theta = 0;
+    uint32_t max = 0;
+    int32_t tmp = 0;
+    uint8_t shift = 0;
+    uint8_t i = 0;
+
+    if(x == 0 && y == 0)
+    {
+        if(angle != NULL)
+        {
+            *angle = 0;
+        }
+        return 0;
+    }
+
+    /* Rotate into right half plane */
+    if(x < 0)
+    {
+        x = -x;
+        y = -y;
+        theta = IMATH_CORDIC_180;
+    }
+    /* Scale up small vectors for precision, leave headroom for CORDIC gain */
+    max = (uint32_t)x > (uint32_t)(y < 0 ? -y : y) ? (uint32_t)x : (uint32_t)(y < 0 ? -y : y);
+    while((max << shift) < (1UL << (IMATH_CORDIC_BITS - 8)))
+    {
+        shift += 8;
+    }
+    while((max << shift) < (1UL << (IMATH_CORDIC_BITS - 1)))
+    {
+        shift++;
+    }
+    x = (int32_t)((uint32_t)x << shift);
+    y = (int32_t)((uint32_t)y << shift);
+
+    for(i = 0; i < IMATH_CORDIC_STEPS; i++)
+    {
+        tmp = x;
+        if(y > 0)
+        {
+            x += y >> i;
+            y -= tmp >> i;
+            theta += imath_cordic_atan[i];
+        }
+        else
+        {
+            x -= y >> i;
+            y += tmp >> i;
+            theta -= imath_cordic_atan[i];
+        }
+    }
+
+    if(angle != NULL)
+    {
+        *angle = (uint16_t)((theta + (1UL << 15)) >> 16);
+    }
+
+    tmp = (int32_t)(((int64_t)x * IMATH_CORDIC_GAIN) >> 30);
+    if(shift != 0)
+    {
+        tmp = (tmp + (1L << (shift - 1))) >> shift;
+    }
+
+    return (uint32_t)tmp;
+}
+
+uint16_t imath_atan2(int32_t y, int32_t x)
+{
+    uint16_t angle = 0;
+
+    imath_vector(x, y, &angle);
+
+    return angle;
+}
+
+void imath_sincos(uint16_t angle, int16_t *sin, int16_t *cos)
+{
+    int32_t x = IMATH_CORDIC_GAIN;
+    int32_t y = 0;
+    int32_t z = (int32_t)((uint32_t)angle << 16);
+    int32_t tmp = 0;
+    int8_t sign = 1;
+    uint8_t i = 0;
+
+    /* Rotate into right half plane, -90 to 90 degrees */
+    if(angle > IMATH_ANGLE_90 && angle < IMATH_ANGLE_270)
+    {
+        z = (int32_t)((uint32_t)z + IMATH_CORDIC_180);
+        sign = -1;
+    }
+
+    for(i = 0; i < IMATH_CORDIC_STEPS; i++)
+    {
+        tmp = x;
+        if(z >= 0)
+        {
+            x -= y >> i;
+            y += tmp >> i;
+            z -= (int32_t)imath_cordic_atan[i];
+        }
+        else
+        {
+            x += y >> i;
+            y -= tmp >> i;
+            z += (int32_t)imath_cordic_atan[i];
+        }
+    }
+
+    /* Q30 to Q15 */
+    x = sign * ((x + (1L << 14)) >> 15);
+    y = sign * ((y + (1L << 14)) >> 15);
+    if(sin != NULL)
+    {
+        *sin = (int16_t)(y > INT16_MAX ? INT16_MAX : y < INT16_MIN ? INT16_MIN : y);
+    }
+    if(cos != NULL)
+    {
+        *cos = (int16_t)(x > INT16_MAX ? INT16_MAX : x < INT16_MIN ? INT16_MIN : x);
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
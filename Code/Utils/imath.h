@@ -0,0 +1,102 @@
+/**
+ **********************************************************************************************************************
+ * @file        imath.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Integer square root, CORDIC atan2 and sin/cos with binary angles.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef IMATH_H_
+#define IMATH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+#define IMATH_ANGLE_90      0x4000  //!< Binary angle of 90 degrees, full circle is 65536.
+#define IMATH_ANGLE_180     0x8000  //!< Binary angle of 180 degrees.
+#define IMATH_ANGLE_270     0xC000  //!< Binary angle of 270 degrees.
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/** Binary angle to whole degrees 0 to 359, rounded down. */
+#define IMATH_ANGLE_TO_DEG(A)   ((int32_t)(((uint32_t)(uint16_t)(A) * 360) >> 16))
+/** Degrees to binary angle. */
+#define IMATH_DEG_TO_ANGLE(D)   ((uint16_t)(((int32_t)(D) * 65536) / 360))
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Integer square root.
+ *
+ * @param   value   Value.
+ *
+ * @return  Square root rounded down.
+ */
+uint32_t imath_sqrt(uint32_t value);
+
+/**
+ * @brief   Get magnitude and angle of vector with CORDIC.
+ *
+ * @param   x       X coordinate.
+ * @param   y       Y coordinate.
+ * @param   angle   Angle from positive X towards positive Y as binary angle. Can be NULL.
+ *
+ * @return  Magnitude, within 1 of exact value for coordinates below 2^24. Truncation in CORDIC steps adds error
+ *          up to 5e-8 of magnitude above it, coordinates must stay below 2^29.
+ */
+uint32_t imath_vector(int32_t x, int32_t y, uint16_t *angle);
+
+/**
+ * @brief   Get angle of vector, like atan2 of C library.
+ *
+ * @param   y   Y coordinate.
+ * @param   x   X coordinate.
+ *
+ * @return  Angle from positive X towards positive Y as binary angle, 0 for zero vector.
+ */
+uint16_t imath_atan2(int32_t y, int32_t x);
+
+/**
+ * @brief   Get sine and cosine with CORDIC.
+ *
+ * @param   angle   Binary angle.
+ * @param   sin     Sine in Q15, 1.0 saturates to largest value. Can be NULL.
+ * @param   cos     Cosine in Q15, 1.0 saturates to largest value. Can be NULL.
+ */
+void imath_sincos(uint16_t angle, int16_t *sin, int16_t *cos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMATH_H_ */
@@ -0,0 +1,242 @@
+/**
+ **********************************************************************************************************************
+ * @file         bench_display.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Benchmark of display drawing primitives and menu renders on virtual panel.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "display/ssd1306.h"
+#include "display/widget.h"
+#include "host_test.h"
+#include "common.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define BENCH_DISPLAY_ITERATIONS    20000   //!< Default iterations of every case.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define BENCH_DISPLAY_COLOR(I)      ((I) & 1 ? SSD1306_COLOR_BLACK : SSD1306_COLOR_WHITE)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*run)(uint32_t i);    //!< Runs case once, i is iteration.
+} bench_display_case_t;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static int32_t bench_display_get(uint32_t arg);
+static void bench_display_puts_small(uint32_t i);
+static void bench_display_puts_large(uint32_t i);
+static void bench_display_line_diagonal(uint32_t i);
+static void bench_display_line_horizontal(uint32_t i);
+static void bench_display_line_vertical(uint32_t i);
+static void bench_display_circle(uint32_t i);
+static void bench_display_filled_circle(uint32_t i);
+static void bench_display_filled_rectangle(uint32_t i);
+static void bench_display_filled_triangle(uint32_t i);
+static void bench_display_menu_full(uint32_t i);
+static void bench_display_menu_value(uint32_t i);
+static void bench_display_flush(uint32_t i);
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static int32_t bench_display_values[3] = {0, 75, -30};
+
+/* Motor menu like on target: labels, two numbers, bar and gauge */
+static widget_t bench_display_menu[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 0, .y = 0, .font = &fonts_7x10, .text = "Motors"},
+    {.type = WIDGET_TYPE_LABEL, .x = 0, .y = 12, .font = &fonts_7x10, .text = "Speed:"},
+    {.type = WIDGET_TYPE_NUMBER, .x = 49, .y = 12, .font = &fonts_7x10, .align = WIDGET_ALIGN_RIGHT,
+        .chars = 4, .get = bench_display_get, .arg = 0},
+    {.type = WIDGET_TYPE_LABEL, .x = 0, .y = 24, .font = &fonts_7x10, .text = "Target:"},
+    {.type = WIDGET_TYPE_NUMBER, .x = 56, .y = 24, .font = &fonts_7x10, .align = WIDGET_ALIGN_RIGHT,
+        .chars = 4, .get = bench_display_get, .arg = 1},
+    {.type = WIDGET_TYPE_BAR, .x = 0, .y = 38, .w = 127, .h = 8, .get = bench_display_get, .arg = 1, .min = 0,
+        .max = 100},
+    {.type = WIDGET_TYPE_GAUGE, .x = 0, .y = 52, .w = 127, .h = 8, .get = bench_display_get, .arg = 2, .min = -100,
+        .max = 100},
+};
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const bench_display_case_t cases[] =
+    {
+        {"puts 7x10, 16 chars", bench_display_puts_small},
+        {"puts 11x18, 8 chars", bench_display_puts_large},
+        {"line diagonal", bench_display_line_diagonal},
+        {"line horizontal", bench_display_line_horizontal},
+        {"line vertical", bench_display_line_vertical},
+        {"circle r30", bench_display_circle},
+        {"filled circle r30", bench_display_filled_circle},
+        {"filled rectangle 100x50", bench_display_filled_rectangle},
+        {"filled triangle", bench_display_filled_triangle},
+        {"menu full render", bench_display_menu_full},
+        {"menu one value", bench_display_menu_value},
+        {"full frame flush", bench_display_flush},
+    };
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DISPLAY_ITERATIONS;
+    uint64_t start = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    if(iterations == 0 || ssd1306_init() == false)
+    {
+        return 1;
+    }
+
+    printf("%-28s %12s\n", "case", "ns per call");
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        ssd1306_fill(SSD1306_COLOR_BLACK);
+        start = host_time_ns();
+        for(j = 0; j < iterations; j++)
+        {
+            cases[i].run(j);
+        }
+        printf("%-28s %12.1f\n", cases[i].name, (double)(host_time_ns() - start) / iterations);
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static int32_t bench_display_get(uint32_t arg)
+{
+    return bench_display_values[arg];
+}
+
+static void bench_display_puts_small(uint32_t i)
+{
+    ssd1306_goto_xy(1, 13);
+    ssd1306_puts((uint8_t *)"Hello, world 123", &fonts_7x10, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_puts_large(uint32_t i)
+{
+    ssd1306_goto_xy(3, 21);
+    ssd1306_puts((uint8_t *)"12:34:56", &fonts_11x18, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_line_diagonal(uint32_t i)
+{
+    ssd1306_draw_line(0, 0, 127, 63, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_line_horizontal(uint32_t i)
+{
+    ssd1306_draw_line(0, 33, 127, 33, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_line_vertical(uint32_t i)
+{
+    ssd1306_draw_line(64, 0, 64, 63, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_circle(uint32_t i)
+{
+    ssd1306_draw_circle(64, 32, 30, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_filled_circle(uint32_t i)
+{
+    ssd1306_draw_filled_circle(64, 32, 30, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_filled_rectangle(uint32_t i)
+{
+    ssd1306_draw_filled_rectangle(13, 7, 100, 50, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_filled_triangle(uint32_t i)
+{
+    ssd1306_draw_filled_triangle(5, 60, 64, 3, 122, 50, BENCH_DISPLAY_COLOR(i));
+
+    return;
+}
+
+static void bench_display_menu_full(uint32_t i)
+{
+    bench_display_values[0] = i % 100;
+    ssd1306_fill(SSD1306_COLOR_BLACK);
+    widget_reset(bench_display_menu, sizeof(bench_display_menu) / sizeof(bench_display_menu[0]));
+    widget_update(bench_display_menu, sizeof(bench_display_menu) / sizeof(bench_display_menu[0]));
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+
+    return;
+}
+
+static void bench_display_menu_value(uint32_t i)
+{
+    bench_display_values[0] = i % 100;
+    widget_update(bench_display_menu, sizeof(bench_display_menu) / sizeof(bench_display_menu[0]));
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+
+    return;
+}
+
+static void bench_display_flush(uint32_t i)
+{
+    UNUSED_PARAMETER(i);
+    ssd1306_invalidate();
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+
+    return;
+}
@@ -0,0 +1,305 @@
+/**
+ **********************************************************************************************************************
+ * @file         bench_render.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Benchmark of display drawing against reference renderer from before page based rewrite.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "display/ssd1306.h"
+#include "host_test.h"
+#include "ssd1306_ref.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define BENCH_RENDER_ITERATIONS     20000   //!< Default iterations of every case.
+#define BENCH_RENDER_RUNS           5       //!< Runs of every case, fastest one is reported.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define BENCH_RENDER_COLOR(I)       ((I) & 1 ? SSD1306_COLOR_BLACK : SSD1306_COLOR_WHITE)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*run)(uint32_t i);    //!< Runs case once on driver, i is iteration.
+    void (*ref)(uint32_t i);    //!< Runs same case once on reference renderer.
+} bench_render_case_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static double bench_render_time(void (*run)(uint32_t i), uint32_t iterations);
+static void bench_render_puts_small(uint32_t i);
+static void bench_render_puts_small_ref(uint32_t i);
+static void bench_render_puts_large(uint32_t i);
+static void bench_render_puts_large_ref(uint32_t i);
+static void bench_render_puts_huge(uint32_t i);
+static void bench_render_puts_huge_ref(uint32_t i);
+static void bench_render_line_diagonal(uint32_t i);
+static void bench_render_line_diagonal_ref(uint32_t i);
+static void bench_render_line_horizontal(uint32_t i);
+static void bench_render_line_horizontal_ref(uint32_t i);
+static void bench_render_line_vertical(uint32_t i);
+static void bench_render_line_vertical_ref(uint32_t i);
+static void bench_render_circle(uint32_t i);
+static void bench_render_circle_ref(uint32_t i);
+static void bench_render_filled_circle(uint32_t i);
+static void bench_render_filled_circle_ref(uint32_t i);
+static void bench_render_filled_rectangle(uint32_t i);
+static void bench_render_filled_rectangle_ref(uint32_t i);
+static void bench_render_filled_triangle(uint32_t i);
+static void bench_render_filled_triangle_ref(uint32_t i);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const bench_render_case_t cases[] =
+    {
+        {"puts 7x10, 16 chars", bench_render_puts_small, bench_render_puts_small_ref},
+        {"puts 11x18, 8 chars", bench_render_puts_large, bench_render_puts_large_ref},
+        {"puts 16x26, 7 chars", bench_render_puts_huge, bench_render_puts_huge_ref},
+        {"line diagonal", bench_render_line_diagonal, bench_render_line_diagonal_ref},
+        {"line horizontal", bench_render_line_horizontal, bench_render_line_horizontal_ref},
+        {"line vertical", bench_render_line_vertical, bench_render_line_vertical_ref},
+        {"circle r30", bench_render_circle, bench_render_circle_ref},
+        {"filled circle r30", bench_render_filled_circle, bench_render_filled_circle_ref},
+        {"filled rectangle 100x50", bench_render_filled_rectangle, bench_render_filled_rectangle_ref},
+        {"filled triangle", bench_render_filled_triangle, bench_render_filled_triangle_ref},
+    };
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_RENDER_ITERATIONS;
+    double time = 0;
+    double ref = 0;
+    uint32_t i = 0;
+
+    if(iterations == 0 || ssd1306_init() == false)
+    {
+        return 1;
+    }
+
+    printf("%-28s %12s %12s %8s\n", "case", "ns per call", "reference", "speedup");
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        time = bench_render_time(cases[i].run, iterations);
+        ref = bench_render_time(cases[i].ref, iterations);
+        printf("%-28s %12.1f %12.1f %7.1fx\n", cases[i].name, time, ref, ref / time);
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Time case on cleared frames. Fastest of @ref BENCH_RENDER_RUNS runs is taken, so scheduling noise
+ *          of host does not decide comparison.
+ *
+ * @param   run         Case.
+ * @param   iterations  Calls of case in every run.
+ *
+ * @return  Time per call in ns.
+ */
+static double bench_render_time(void (*run)(uint32_t i), uint32_t iterations)
+{
+    uint64_t start = 0;
+    uint64_t time = 0;
+    uint64_t best = UINT64_MAX;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for(i = 0; i < BENCH_RENDER_RUNS; i++)
+    {
+        ssd1306_fill(SSD1306_COLOR_BLACK);
+        ssd1306_ref_fill(SSD1306_COLOR_BLACK);
+        start = host_time_ns();
+        for(j = 0; j < iterations; j++)
+        {
+            run(j);
+        }
+        time = host_time_ns() - start;
+        best = time < best ? time : best;
+    }
+
+    return (double)best / iterations;
+}
+
+static void bench_render_puts_small(uint32_t i)
+{
+    ssd1306_goto_xy(1, 13);
+    ssd1306_puts((uint8_t *)"Hello, world 123", &fonts_7x10, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_puts_small_ref(uint32_t i)
+{
+    ssd1306_ref_goto_xy(1, 13);
+    ssd1306_ref_puts((uint8_t *)"Hello, world 123", &fonts_7x10, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_puts_large(uint32_t i)
+{
+    ssd1306_goto_xy(3, 21);
+    ssd1306_puts((uint8_t *)"12:34:56", &fonts_11x18, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_puts_large_ref(uint32_t i)
+{
+    ssd1306_ref_goto_xy(3, 21);
+    ssd1306_ref_puts((uint8_t *)"12:34:56", &fonts_11x18, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_puts_huge(uint32_t i)
+{
+    ssd1306_goto_xy(2, 19);
+    ssd1306_puts((uint8_t *)"-123.45", &fonts_16x26, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_puts_huge_ref(uint32_t i)
+{
+    ssd1306_ref_goto_xy(2, 19);
+    ssd1306_ref_puts((uint8_t *)"-123.45", &fonts_16x26, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_diagonal(uint32_t i)
+{
+    ssd1306_draw_line(0, 0, 127, 63, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_diagonal_ref(uint32_t i)
+{
+    ssd1306_ref_draw_line(0, 0, 127, 63, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_horizontal(uint32_t i)
+{
+    ssd1306_draw_line(0, 33, 127, 33, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_horizontal_ref(uint32_t i)
+{
+    ssd1306_ref_draw_line(0, 33, 127, 33, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_vertical(uint32_t i)
+{
+    ssd1306_draw_line(64, 0, 64, 63, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_line_vertical_ref(uint32_t i)
+{
+    ssd1306_ref_draw_line(64, 0, 64, 63, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_circle(uint32_t i)
+{
+    ssd1306_draw_circle(64, 32, 30, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_circle_ref(uint32_t i)
+{
+    ssd1306_ref_draw_circle(64, 32, 30, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_circle(uint32_t i)
+{
+    ssd1306_draw_filled_circle(64, 32, 30, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_circle_ref(uint32_t i)
+{
+    ssd1306_ref_draw_filled_circle(64, 32, 30, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_rectangle(uint32_t i)
+{
+    ssd1306_draw_filled_rectangle(13, 7, 100, 50, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_rectangle_ref(uint32_t i)
+{
+    ssd1306_ref_draw_filled_rectangle(13, 7, 100, 50, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_triangle(uint32_t i)
+{
+    ssd1306_draw_filled_triangle(5, 60, 64, 3, 122, 50, BENCH_RENDER_COLOR(i));
+
+    return;
+}
+
+static void bench_render_filled_triangle_ref(uint32_t i)
+{
+    ssd1306_ref_draw_filled_triangle(5, 60, 64, 3, 122, 50, BENCH_RENDER_COLOR(i));
+
+    return;
+}
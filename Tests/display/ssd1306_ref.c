@@ -0,0 +1,498 @@
+/**
+ **********************************************************************************************************************
+ * @file         ssd1306_ref.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Reference renderer, drawing code of SSD1306 driver before page based rewrite.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ssd1306_ref.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define ABS(x)   ((x) > 0 ? (x) : -(x))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static uint8_t ssd1306_ref_buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
+static uint16_t ssd1306_ref_x = 0;
+static uint16_t ssd1306_ref_y = 0;
+static bool ssd1306_ref_inverted = false;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void ssd1306_ref_fill(ssd1306_color_t color)
+{
+    memset(ssd1306_ref_buffer, (color == SSD1306_COLOR_BLACK) ? 0x00 : 0xFF, sizeof(ssd1306_ref_buffer));
+    return;
+}
+
+void ssd1306_ref_toggle_invert(void)
+{
+    uint16_t i = 0;
+
+    ssd1306_ref_inverted = !ssd1306_ref_inverted;
+    for(i = 0; i < sizeof(ssd1306_ref_buffer); i++)
+    {
+        ssd1306_ref_buffer[i] = ~ssd1306_ref_buffer[i];
+    }
+
+    return;
+}
+
+bool ssd1306_ref_get_pixel(uint16_t x, uint16_t y)
+{
+    return (ssd1306_ref_buffer[x + (y / 8) * SSD1306_WIDTH] >> (y % 8)) & 1;
+}
+
+void ssd1306_ref_draw_pixel(uint16_t x, uint16_t y, ssd1306_color_t c)
+{
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        return;
+    }
+
+    if(ssd1306_ref_inverted)
+    {
+        c = (ssd1306_color_t)!c;
+    }
+
+    if(c == SSD1306_COLOR_WHITE)
+    {
+        ssd1306_ref_buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+    }
+    else
+    {
+        ssd1306_ref_buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+    }
+
+    return;
+}
+
+void ssd1306_ref_goto_xy(uint16_t x, uint16_t y)
+{
+    ssd1306_ref_x = x;
+    ssd1306_ref_y = y;
+
+    return;
+}
+
+uint8_t ssd1306_ref_putc(uint8_t ch, fonts_t *font, ssd1306_color_t color)
+{
+    uint32_t i = 0;
+    uint32_t b = 0;
+    uint32_t j = 0;
+
+    if(SSD1306_WIDTH <= (ssd1306_ref_x + font->font_width) || SSD1306_HEIGHT <= (ssd1306_ref_y + font->font_height))
+    {
+        return 0;
+    }
+
+    for(i = 0; i < font->font_height; i++)
+    {
+        b = font->data[(ch - 32) * font->font_height + i];
+        for(j = 0; j < font->font_width; j++)
+        {
+            if((b << j) & 0x8000)
+            {
+                ssd1306_ref_draw_pixel(ssd1306_ref_x + j, (ssd1306_ref_y + i), (ssd1306_color_t)color);
+            }
+            else
+            {
+                ssd1306_ref_draw_pixel(ssd1306_ref_x + j, (ssd1306_ref_y + i), (ssd1306_color_t)!color);
+            }
+        }
+    }
+    ssd1306_ref_x += font->font_width;
+
+    return ch;
+}
+
+uint8_t ssd1306_ref_puts(uint8_t *str, fonts_t *font, ssd1306_color_t color)
+{
+    while(*str)
+    {
+        if(ssd1306_ref_putc(*str, font, color) != *str)
+        {
+            return *str;
+        }
+        str++;
+    }
+
+    return *str;
+}
+
+void ssd1306_ref_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ssd1306_color_t c)
+{
+    int16_t dx = 0;
+    int16_t dy =0;
+    int16_t sx = 0;
+    int16_t sy = 0;
+    int16_t err = 0;
+    int16_t e2 = 0;
+    int16_t i = 0;
+    int16_t tmp = 0;
+
+    /* Check for overflow */
+    if(x0 >= SSD1306_WIDTH)
+    {
+        x0 = SSD1306_WIDTH - 1;
+    }
+    if(x1 >= SSD1306_WIDTH)
+    {
+        x1 = SSD1306_WIDTH - 1;
+    }
+    if(y0 >= SSD1306_HEIGHT)
+    {
+        y0 = SSD1306_HEIGHT - 1;
+    }
+    if(y1 >= SSD1306_HEIGHT)
+    {
+        y1 = SSD1306_HEIGHT - 1;
+    }
+
+    dx = (x0 < x1) ? (x1 - x0) : (x0 - x1);
+    dy = (y0 < y1) ? (y1 - y0) : (y0 - y1);
+    sx = (x0 < x1) ? 1 : -1;
+    sy = (y0 < y1) ? 1 : -1;
+    err = ((dx > dy) ? dx : -dy) / 2;
+
+    if(dx == 0)
+    {
+        if(y1 < y0)
+        {
+            tmp = y1;
+            y1 = y0;
+            y0 = tmp;
+        }
+
+        if(x1 < x0)
+        {
+            tmp = x1;
+            x1 = x0;
+            x0 = tmp;
+        }
+
+        /* Vertical line */
+        for(i = y0; i <= y1; i++)
+        {
+            ssd1306_ref_draw_pixel(x0, i, c);
+        }
+
+        /* Return from function */
+        return;
+    }
+
+    if(dy == 0)
+    {
+        if(y1 < y0)
+        {
+            tmp = y1;
+            y1 = y0;
+            y0 = tmp;
+        }
+
+        if(x1 < x0)
+        {
+            tmp = x1;
+            x1 = x0;
+            x0 = tmp;
+        }
+
+        /* Horizontal line */
+        for(i = x0; i <= x1; i++)
+        {
+            ssd1306_ref_draw_pixel(i, y0, c);
+        }
+
+        /* Return from function */
+        return;
+    }
+
+    while(1)
+    {
+        ssd1306_ref_draw_pixel(x0, y0, c);
+        if(x0 == x1 && y0 == y1)
+        {
+            break;
+        }
+        e2 = err;
+        if(e2 > -dx)
+        {
+            err -= dy;
+            x0 += sx;
+        }
+        if(e2 < dy)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+
+    return;
+}
+
+void ssd1306_ref_draw_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1306_color_t c)
+{
+    /* Check input parameters */
+    if(x >= SSD1306_WIDTH ||  y >= SSD1306_HEIGHT)
+    {
+        /* Return error */
+        return;
+    }
+
+    /* Check width and height */
+    if((x + w) >= SSD1306_WIDTH)
+    {
+        w = SSD1306_WIDTH - x;
+    }
+    if((y + h) >= SSD1306_HEIGHT)
+    {
+        h = SSD1306_HEIGHT - y;
+    }
+
+    /* Draw 4 lines */
+    ssd1306_ref_draw_line(x, y, x + w, y, c);           /* Top line */
+    ssd1306_ref_draw_line(x, y + h, x + w, y + h, c);   /* Bottom line */
+    ssd1306_ref_draw_line(x, y, x, y + h, c);           /* Left line */
+    ssd1306_ref_draw_line(x + w, y, x + w, y + h, c);   /* Right line */
+
+    return;
+}
+
+void ssd1306_ref_draw_filled_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1306_color_t c)
+{
+    uint8_t i = 0;
+
+    /* Check input parameters */
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        /* Return error */
+        return;
+    }
+
+    /* Check width and height */
+    if((x + w) >= SSD1306_WIDTH)
+    {
+        w = SSD1306_WIDTH - x;
+    }
+    if((y + h) >= SSD1306_HEIGHT)
+    {
+        h = SSD1306_HEIGHT - y;
+    }
+
+    /* Draw lines */
+    for(i = 0; i <= h; i++)
+    {
+        /* Draw lines */
+        ssd1306_ref_draw_line(x, y + i, x + w, y + i, c);
+    }
+
+    return;
+}
+
+void ssd1306_ref_draw_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, ssd1306_color_t c)
+{
+    /* Draw lines */
+    ssd1306_ref_draw_line(x1, y1, x2, y2, c);
+    ssd1306_ref_draw_line(x2, y2, x3, y3, c);
+    ssd1306_ref_draw_line(x3, y3, x1, y1, c);
+
+    return;
+}
+
+void ssd1306_ref_draw_filled_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, ssd1306_color_t c)
+{
+    int16_t deltax = 0;
+    int16_t deltay = 0;
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t xinc1 = 0;
+    int16_t xinc2 = 0;
+    int16_t yinc1 = 0;
+    int16_t yinc2 = 0;
+    int16_t den = 0;
+    int16_t num = 0;
+    int16_t numadd = 0;
+    int16_t numpixels = 0;
+    int16_t curpixel = 0;
+
+    deltax = ABS(x2 - x1);
+    deltay = ABS(y2 - y1);
+    x = x1;
+    y = y1;
+
+    if(x2 >= x1)
+    {
+        xinc1 = 1;
+        xinc2 = 1;
+    }
+    else
+    {
+        xinc1 = -1;
+        xinc2 = -1;
+    }
+
+    if(y2 >= y1)
+    {
+        yinc1 = 1;
+        yinc2 = 1;
+    }
+    else
+    {
+        yinc1 = -1;
+        yinc2 = -1;
+    }
+
+    if(deltax >= deltay)
+    {
+        xinc1 = 0;
+        yinc2 = 0;
+        den = deltax;
+        num = deltax / 2;
+        numadd = deltay;
+        numpixels = deltax;
+    }
+    else
+    {
+        xinc2 = 0;
+        yinc1 = 0;
+        den = deltay;
+        num = deltay / 2;
+        numadd = deltax;
+        numpixels = deltay;
+    }
+
+    for(curpixel = 0; curpixel <= numpixels; curpixel++)
+    {
+        ssd1306_ref_draw_line(x, y, x3, y3, c);
+
+        num += numadd;
+        if(num >= den)
+        {
+            num -= den;
+            x += xinc1;
+            y += yinc1;
+        }
+        x += xinc2;
+        y += yinc2;
+    }
+
+    return;
+}
+
+void ssd1306_ref_draw_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color_t c)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    ssd1306_ref_draw_pixel(x0, y0 + r, c);
+    ssd1306_ref_draw_pixel(x0, y0 - r, c);
+    ssd1306_ref_draw_pixel(x0 + r, y0, c);
+    ssd1306_ref_draw_pixel(x0 - r, y0, c);
+
+    while(x < y)
+    {
+        if(f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        ssd1306_ref_draw_pixel(x0 + x, y0 + y, c);
+        ssd1306_ref_draw_pixel(x0 - x, y0 + y, c);
+        ssd1306_ref_draw_pixel(x0 + x, y0 - y, c);
+        ssd1306_ref_draw_pixel(x0 - x, y0 - y, c);
+
+        ssd1306_ref_draw_pixel(x0 + y, y0 + x, c);
+        ssd1306_ref_draw_pixel(x0 - y, y0 + x, c);
+        ssd1306_ref_draw_pixel(x0 + y, y0 - x, c);
+        ssd1306_ref_draw_pixel(x0 - y, y0 - x, c);
+    }
+
+    return;
+}
+
+void ssd1306_ref_draw_filled_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color_t c)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    ssd1306_ref_draw_pixel(x0, y0 + r, c);
+    ssd1306_ref_draw_pixel(x0, y0 - r, c);
+    ssd1306_ref_draw_pixel(x0 + r, y0, c);
+    ssd1306_ref_draw_pixel(x0 - r, y0, c);
+    ssd1306_ref_draw_line(x0 - r, y0, x0 + r, y0, c);
+
+    while(x < y)
+    {
+        if(f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        ssd1306_ref_draw_line(x0 - x, y0 + y, x0 + x, y0 + y, c);
+        ssd1306_ref_draw_line(x0 + x, y0 - y, x0 - x, y0 - y, c);
+
+        ssd1306_ref_draw_line(x0 + y, y0 + x, x0 - y, y0 + x, c);
+        ssd1306_ref_draw_line(x0 + y, y0 - x, x0 - y, y0 - x, c);
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
@@ -0,0 +1,102 @@
+/**
+ **********************************************************************************************************************
+ * @file        ssd1306_ref.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Reference renderer, drawing code of SSD1306 driver before page based rewrite.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SSD1306_REF_H_
+#define SSD1306_REF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "display/ssd1306.h"
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Fill reference frame.
+ *
+ * @param   color   Fill color. See @ref ssd1306_color_t.
+ */
+void ssd1306_ref_fill(ssd1306_color_t color);
+
+/**
+ * @brief   Invert reference frame, later drawing swaps colors.
+ */
+void ssd1306_ref_toggle_invert(void);
+
+/**
+ * @brief   Get pixel of reference frame.
+ *
+ * @param   x   X of pixel.
+ * @param   y   Y of pixel.
+ *
+ * @return  True if pixel is lit.
+ */
+bool ssd1306_ref_get_pixel(uint16_t x, uint16_t y);
+
+void ssd1306_ref_draw_pixel(uint16_t x, uint16_t y, ssd1306_color_t c);
+void ssd1306_ref_goto_xy(uint16_t x, uint16_t y);
+
+/**
+ * @brief   Draw character pixel by pixel from row font, see @ref FONTS_FORMAT_ROWS.
+ */
+uint8_t ssd1306_ref_putc(uint8_t ch, fonts_t *font, ssd1306_color_t color);
+uint8_t ssd1306_ref_puts(uint8_t *str, fonts_t *font, ssd1306_color_t color);
+
+/**
+ * @brief   Draw shapes pixel by pixel and line by line.
+ */
+void ssd1306_ref_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, ssd1306_color_t c);
+void ssd1306_ref_draw_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1306_color_t c);
+void ssd1306_ref_draw_filled_rectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ssd1306_color_t c);
+void ssd1306_ref_draw_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3,
+    ssd1306_color_t c);
+void ssd1306_ref_draw_filled_triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3,
+    ssd1306_color_t c);
+void ssd1306_ref_draw_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color_t c);
+void ssd1306_ref_draw_filled_circle(int16_t x0, int16_t y0, int16_t r, ssd1306_color_t c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSD1306_REF_H_ */
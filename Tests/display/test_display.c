@@ -0,0 +1,373 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_display.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Golden image tests of display stack on virtual panel.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "display/ssd1306.h"
+#include "display/ssd1306_vpanel.h"
+#include "display/widget.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_DISPLAY_PATH_SIZE  512                     //!< Longest golden image path.
+#define TEST_DISPLAY_PBM_SIZE   (16 + (SSD1306_WIDTH + 1) * SSD1306_HEIGHT) //!< Size of dumped PBM frame.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;           //!< Golden image name.
+    void (*draw)(void);         //!< Draws scene on cleared frame.
+} test_display_scene_t;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static int32_t test_display_get(uint32_t arg);
+static void test_display_draw_text(void);
+static void test_display_draw_text_large(void);
+static void test_display_draw_lines(void);
+static void test_display_draw_shapes(void);
+static void test_display_draw_clipped(void);
+static void test_display_draw_inverted(void);
+static void test_display_draw_menu(void);
+static void test_display_draw_menu_update(void);
+static void test_display_writer(const uint8_t *data, uint32_t size);
+static bool test_display_golden(const char *name, bool update);
+static void test_display_incremental(void);
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static const char *test_display_dir = NULL;
+static int32_t test_display_values[4] = {0};
+static uint8_t test_display_pbm[TEST_DISPLAY_PBM_SIZE];
+static uint32_t test_display_pbm_size = 0;
+
+static widget_t test_display_menu[] =
+{
+    {.type = WIDGET_TYPE_LABEL, .x = 0, .y = 0, .font = &fonts_7x10, .text = "Motor"},
+    {.type = WIDGET_TYPE_LABEL, .x = 0, .y = 12, .font = &fonts_7x10, .text = "Speed:"},
+    {.type = WIDGET_TYPE_NUMBER, .x = 49, .y = 12, .font = &fonts_7x10, .align = WIDGET_ALIGN_RIGHT,
+        .chars = 4, .get = test_display_get, .arg = 0},
+    {.type = WIDGET_TYPE_BAR, .x = 0, .y = 24, .w = 127, .h = 8, .get = test_display_get, .arg = 1, .min = 0,
+        .max = 100},
+    {.type = WIDGET_TYPE_GAUGE, .x = 0, .y = 36, .w = 127, .h = 8, .get = test_display_get, .arg = 2, .min = -100,
+        .max = 100},
+    {.type = WIDGET_TYPE_NUMBER, .x = 0, .y = 45, .font = &fonts_11x18, .align = WIDGET_ALIGN_CENTER,
+        .chars = 11, .get = test_display_get, .arg = 3},
+};
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const test_display_scene_t scenes[] =
+    {
+        {"text", test_display_draw_text},
+        {"text_large", test_display_draw_text_large},
+        {"lines", test_display_draw_lines},
+        {"shapes", test_display_draw_shapes},
+        {"clipped", test_display_draw_clipped},
+        {"inverted", test_display_draw_inverted},
+        {"menu", test_display_draw_menu},
+        {"menu_update", test_display_draw_menu_update},
+    };
+    ssd1306_vpanel_stats_t before;
+    ssd1306_vpanel_stats_t after;
+    bool update = argc > 2 && strcmp(argv[2], "--update") == 0;
+    uint32_t i = 0;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s <golden dir> [--update]\n", argv[0]);
+        return 2;
+    }
+    test_display_dir = argv[1];
+
+    HOST_CHECK(ssd1306_init());
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++)
+    {
+        ssd1306_fill(SSD1306_COLOR_BLACK);
+        scenes[i].draw();
+        ssd1306_update_screen();
+        ssd1306_update_screen_wait();
+        HOST_CHECK(test_display_golden(scenes[i].name, update));
+
+        /* Unchanged frame sends nothing */
+        ssd1306_vpanel_get_stats(&before);
+        ssd1306_update_screen();
+        ssd1306_update_screen_wait();
+        ssd1306_vpanel_get_stats(&after);
+        HOST_CHECK(after.data == before.data);
+    }
+    test_display_incremental();
+
+    return host_test_result("display");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static int32_t test_display_get(uint32_t arg)
+{
+    return test_display_values[arg];
+}
+
+/**
+ * @brief   Every glyph of small font.
+ */
+static void test_display_draw_text(void)
+{
+    uint8_t line[SSD1306_WIDTH / 7 + 1] = {0};
+    uint8_t ch = ' ';
+    uint8_t i = 0;
+    uint16_t y = 0;
+
+    while(ch <= '~')
+    {
+        for(i = 0; i < sizeof(line) - 1 && ch <= '~'; i++)
+        {
+            line[i] = ch++;
+        }
+        line[i] = '\0';
+        ssd1306_goto_xy(0, y);
+        ssd1306_puts(line, &fonts_7x10, SSD1306_COLOR_WHITE);
+        y += 10;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Large font at unaligned rows in both colors.
+ */
+static void test_display_draw_text_large(void)
+{
+    ssd1306_goto_xy(0, 3);
+    ssd1306_puts((uint8_t *)"0123456789", &fonts_11x18, SSD1306_COLOR_WHITE);
+    ssd1306_goto_xy(5, 25);
+    ssd1306_puts((uint8_t *)"-12:34.5", &fonts_11x18, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_rectangle(0, 44, 127, 19, SSD1306_COLOR_WHITE);
+    ssd1306_goto_xy(20, 45);
+    ssd1306_puts((uint8_t *)"DS 42", &fonts_11x18, SSD1306_COLOR_BLACK);
+
+    return;
+}
+
+/**
+ * @brief   Fan of lines in all octants, axis lines and lines running past screen edge.
+ */
+static void test_display_draw_lines(void)
+{
+    uint16_t i = 0;
+
+    for(i = 0; i <= 120; i += 15)
+    {
+        ssd1306_draw_line(63, 31, i, 0, SSD1306_COLOR_WHITE);
+        ssd1306_draw_line(63, 31, 120 - i, 63, SSD1306_COLOR_WHITE);
+    }
+    ssd1306_draw_line(0, 5, 127, 5, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(125, 0, 125, 63, SSD1306_COLOR_WHITE);
+    ssd1306_draw_line(63, 31, 63, 31, SSD1306_COLOR_BLACK);
+    ssd1306_draw_line(100, 40, 200, 90, SSD1306_COLOR_WHITE);
+
+    return;
+}
+
+/**
+ * @brief   Outlined and filled shapes, filled ones overlapping outlines in both colors.
+ */
+static void test_display_draw_shapes(void)
+{
+    ssd1306_draw_rectangle(2, 3, 30, 20, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_rectangle(6, 7, 22, 12, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_rectangle(10, 9, 5, 3, SSD1306_COLOR_BLACK);
+    ssd1306_draw_circle(52, 15, 12, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_circle(52, 15, 8, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_circle(52, 15, 3, SSD1306_COLOR_BLACK);
+    ssd1306_draw_triangle(70, 30, 126, 2, 100, 40, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_triangle(75, 60, 120, 45, 90, 35, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_triangle(5, 62, 5, 30, 60, 62, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_triangle(10, 58, 30, 58, 20, 58, SSD1306_COLOR_BLACK);
+
+    return;
+}
+
+/**
+ * @brief   Shapes crossing screen edges.
+ */
+static void test_display_draw_clipped(void)
+{
+    ssd1306_draw_filled_rectangle(100, 50, 60, 30, SSD1306_COLOR_WHITE);
+    ssd1306_draw_rectangle(90, 30, 50, 40, SSD1306_COLOR_WHITE);
+    ssd1306_draw_circle(0, 0, 20, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_circle(5, 60, 10, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_circle(64, -5, 12, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_triangle(40, 63, 80, 63, 60, 40, SSD1306_COLOR_WHITE);
+    ssd1306_goto_xy(120, 30);
+    ssd1306_puts((uint8_t *)"AB", &fonts_7x10, SSD1306_COLOR_WHITE);
+
+    return;
+}
+
+/**
+ * @brief   Drawing after frame inversion swaps colors.
+ */
+static void test_display_draw_inverted(void)
+{
+    ssd1306_goto_xy(0, 0);
+    ssd1306_puts((uint8_t *)"Normal", &fonts_7x10, SSD1306_COLOR_WHITE);
+    ssd1306_toggle_invert();
+    ssd1306_goto_xy(0, 20);
+    ssd1306_puts((uint8_t *)"Inverted", &fonts_7x10, SSD1306_COLOR_WHITE);
+    ssd1306_draw_filled_circle(100, 40, 10, SSD1306_COLOR_WHITE);
+    ssd1306_toggle_invert();
+    ssd1306_draw_filled_rectangle(90, 55, 30, 5, SSD1306_COLOR_WHITE);
+
+    return;
+}
+
+static void test_display_draw_menu(void)
+{
+    test_display_values[0] = 42;
+    test_display_values[1] = 42;
+    test_display_values[2] = -25;
+    test_display_values[3] = 1234;
+    widget_reset(test_display_menu, sizeof(test_display_menu) / sizeof(test_display_menu[0]));
+    widget_update(test_display_menu, sizeof(test_display_menu) / sizeof(test_display_menu[0]));
+
+    return;
+}
+
+/**
+ * @brief   Menu drawn with other values, same as redraw of changed widgets only, see
+ *          @ref test_display_incremental.
+ */
+static void test_display_draw_menu_update(void)
+{
+    test_display_values[0] = -7;
+    test_display_values[1] = 100;
+    test_display_values[2] = 60;
+    test_display_values[3] = -5;
+    widget_reset(test_display_menu, sizeof(test_display_menu) / sizeof(test_display_menu[0]));
+    widget_update(test_display_menu, sizeof(test_display_menu) / sizeof(test_display_menu[0]));
+
+    return;
+}
+
+static void test_display_writer(const uint8_t *data, uint32_t size)
+{
+    if(test_display_pbm_size + size <= sizeof(test_display_pbm))
+    {
+        memcpy(&test_display_pbm[test_display_pbm_size], data, size);
+        test_display_pbm_size += size;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Compare panel with golden image, or write panel as golden image. Different frame is written to
+ *          working directory for inspection.
+ *
+ * @param   name    Image name without extension.
+ * @param   update  Write golden image instead of comparing.
+ *
+ * @return  True if panel matches golden image or image was written.
+ */
+static bool test_display_golden(const char *name, bool update)
+{
+    char path[TEST_DISPLAY_PATH_SIZE];
+    uint8_t *golden = NULL;
+    uint32_t size = 0;
+    uint32_t diff = UINT32_MAX;
+
+    test_display_pbm_size = 0;
+    ssd1306_vpanel_dump(test_display_writer, SSD1306_VPANEL_FORMAT_PBM);
+    snprintf(path, sizeof(path), "%s/%s.pbm", test_display_dir, name);
+    if(update)
+    {
+        return host_file_write(path, test_display_pbm, test_display_pbm_size);
+    }
+
+    if((golden = host_file_read(path, &size)) != NULL)
+    {
+        diff = ssd1306_vpanel_compare(golden, size);
+        free(golden);
+    }
+    if(diff != 0)
+    {
+        snprintf(path, sizeof(path), "%s.pbm", name);
+        host_file_write(path, test_display_pbm, test_display_pbm_size);
+        fprintf(stderr, "%s: %d pixels differ from golden image, frame written to %s\n", name,
+            diff == UINT32_MAX ? -1 : (int)diff, path);
+    }
+
+    return diff == 0;
+}
+
+/**
+ * @brief   Update of changed widgets only, flushed as dirty areas, ends in same panel content as full redraw.
+ */
+static void test_display_incremental(void)
+{
+    ssd1306_vpanel_stats_t before;
+    ssd1306_vpanel_stats_t after;
+
+    ssd1306_fill(SSD1306_COLOR_BLACK);
+    test_display_draw_menu();
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+
+    test_display_values[0] = -7;
+    test_display_values[1] = 100;
+    test_display_values[2] = 60;
+    test_display_values[3] = -5;
+    ssd1306_vpanel_get_stats(&before);
+    HOST_CHECK(widget_update(test_display_menu, sizeof(test_display_menu) / sizeof(test_display_menu[0])));
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+    ssd1306_vpanel_get_stats(&after);
+
+    HOST_CHECK(test_display_golden("menu_update", false));
+    /* Label rows are not sent again */
+    HOST_CHECK(after.data - before.data < SSD1306_WIDTH * SSD1306_HEIGHT / 8);
+
+    return;
+}
@@ -0,0 +1,492 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_render.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Pixel identity of display drawing with reference renderer from before page based rewrite.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "display/ssd1306.h"
+#include "display/ssd1306_vpanel.h"
+#include "host_test.h"
+#include "ssd1306_ref.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_RENDER_FRAMES      64      //!< Frames of random shapes per shape.
+#define TEST_RENDER_SHAPES      8       //!< Shapes drawn on every frame.
+#define TEST_RENDER_TRIANGLES   500     //!< Filled triangles checked one by one.
+#define TEST_RENDER_SEED        0x2545F491  //!< Seed of random background and shapes.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*params)(int16_t *p);                                 //!< Random parameters of shape.
+    void (*draw)(const int16_t *p, ssd1306_color_t c, bool ref);  //!< Draw shape on driver or reference.
+} test_render_shape_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static int16_t test_render_range(int16_t min, int16_t max);
+static void test_render_begin(bool inverted);
+static bool test_render_end(const char *what, bool inverted);
+static void test_render_glyphs(fonts_t *font, uint16_t offset, ssd1306_color_t color, bool inverted);
+static void test_render_shapes(const test_render_shape_t *shape);
+static void test_render_filled_triangles(void);
+static void test_render_line_params(int16_t *p);
+static void test_render_line(const int16_t *p, ssd1306_color_t c, bool ref);
+static void test_render_rectangle_params(int16_t *p);
+static void test_render_rectangle(const int16_t *p, ssd1306_color_t c, bool ref);
+static void test_render_filled_rectangle(const int16_t *p, ssd1306_color_t c, bool ref);
+static void test_render_triangle_params(int16_t *p);
+static void test_render_triangle(const int16_t *p, ssd1306_color_t c, bool ref);
+static void test_render_circle_params(int16_t *p);
+static void test_render_circle(const int16_t *p, ssd1306_color_t c, bool ref);
+static void test_render_filled_circle_params(int16_t *p);
+static void test_render_filled_circle(const int16_t *p, ssd1306_color_t c, bool ref);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    /* Filled circles stay on screen, old code wrapped negative coordinates, see test_render_filled_circle_params */
+    static const test_render_shape_t shapes[] =
+    {
+        {"line", test_render_line_params, test_render_line},
+        {"rectangle", test_render_rectangle_params, test_render_rectangle},
+        {"filled rectangle", test_render_rectangle_params, test_render_filled_rectangle},
+        {"triangle", test_render_triangle_params, test_render_triangle},
+        {"circle", test_render_circle_params, test_render_circle},
+        {"filled circle", test_render_filled_circle_params, test_render_filled_circle},
+    };
+    fonts_t *fonts[] = {&fonts_7x10, &fonts_11x18, &fonts_16x26};
+    uint32_t i = 0;
+    uint16_t offset = 0;
+
+    host_random_seed(TEST_RENDER_SEED);
+    HOST_CHECK(ssd1306_init());
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++)
+    {
+        for(offset = 0; offset < 8; offset++)
+        {
+            test_render_glyphs(fonts[i], offset, SSD1306_COLOR_WHITE, false);
+            test_render_glyphs(fonts[i], offset, SSD1306_COLOR_BLACK, false);
+            test_render_glyphs(fonts[i], offset, SSD1306_COLOR_WHITE, true);
+        }
+    }
+    for(i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+    {
+        test_render_shapes(&shapes[i]);
+    }
+    test_render_filled_triangles();
+
+    return host_test_result("render");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Random number in range.
+ *
+ * @param   min     Smallest number.
+ * @param   max     Number after largest one.
+ */
+static int16_t test_render_range(int16_t min, int16_t max)
+{
+    return min + (int16_t)(host_random() % (uint32_t)(max - min));
+}
+
+/**
+ * @brief   Same random pixels on both frames, so drawing has to keep pixels around it.
+ *
+ * @param   inverted    Invert both frames after background is drawn.
+ */
+static void test_render_begin(bool inverted)
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint32_t bits = 0;
+
+    ssd1306_fill(SSD1306_COLOR_BLACK);
+    ssd1306_ref_fill(SSD1306_COLOR_BLACK);
+    for(y = 0; y < SSD1306_HEIGHT; y++)
+    {
+        for(x = 0; x < SSD1306_WIDTH; x++)
+        {
+            if((x % 32) == 0)
+            {
+                bits = host_random();
+            }
+            if((bits >> (x % 32)) & 1)
+            {
+                ssd1306_draw_pixel(x, y, SSD1306_COLOR_WHITE);
+                ssd1306_ref_draw_pixel(x, y, SSD1306_COLOR_WHITE);
+            }
+        }
+    }
+    if(inverted)
+    {
+        ssd1306_toggle_invert();
+        ssd1306_ref_toggle_invert();
+    }
+
+    return;
+}
+
+/**
+ * @brief   Flush frame to panel and compare panel with reference frame.
+ *
+ * @param   what        Description of drawn content for failure report.
+ * @param   inverted    Frames were inverted by @ref test_render_begin, invert them back.
+ *
+ * @return  True if all pixels are same.
+ */
+static bool test_render_end(const char *what, bool inverted)
+{
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint32_t diff = 0;
+
+    if(inverted)
+    {
+        ssd1306_toggle_invert();
+        ssd1306_ref_toggle_invert();
+    }
+    ssd1306_update_screen();
+    ssd1306_update_screen_wait();
+    for(y = 0; y < SSD1306_HEIGHT; y++)
+    {
+        for(x = 0; x < SSD1306_WIDTH; x++)
+        {
+            if(ssd1306_vpanel_get_pixel(x, y) != ssd1306_ref_get_pixel(x, y))
+            {
+                if(diff == 0)
+                {
+                    fprintf(stderr, "%s: first difference at %u,%u\n", what, x, y);
+                }
+                diff++;
+            }
+        }
+    }
+
+    return diff == 0;
+}
+
+/**
+ * @brief   Draw every glyph of font on both renderers and compare frames.
+ *
+ * @param   font        Font.
+ * @param   offset      Offset of first row and column, rows are not page aligned for offset other than 0.
+ * @param   color       Glyph color.
+ * @param   inverted    Draw on inverted frame.
+ */
+static void test_render_glyphs(fonts_t *font, uint16_t offset, ssd1306_color_t color, bool inverted)
+{
+    char what[64];
+    uint8_t ch = ' ';
+    uint16_t x = offset;
+    uint16_t y = offset;
+
+    snprintf(what, sizeof(what), "font %ux%u offset %u color %d%s", font->font_width, font->font_height, offset,
+        color, inverted ? " inverted" : "");
+    test_render_begin(inverted);
+    while(ch <= '~')
+    {
+        if(SSD1306_WIDTH <= x + font->font_width)
+        {
+            x = offset;
+            y += font->font_height + 1;
+        }
+        if(SSD1306_HEIGHT <= y + font->font_height)
+        {
+            HOST_CHECK(test_render_end(what, inverted));
+            test_render_begin(inverted);
+            y = offset;
+        }
+        ssd1306_goto_xy(x, y);
+        ssd1306_ref_goto_xy(x, y);
+        HOST_CHECK(ssd1306_putc(ch, font, color) == ssd1306_ref_putc(ch, font, color));
+        x += font->font_width;
+        ch++;
+    }
+    HOST_CHECK(test_render_end(what, inverted));
+
+    return;
+}
+
+/**
+ * @brief   Draw random shapes in random colors on both renderers and compare frames.
+ *
+ * @param   shape   Shape.
+ */
+static void test_render_shapes(const test_render_shape_t *shape)
+{
+    char what[64];
+    int16_t p[6] = {0};
+    ssd1306_color_t c = SSD1306_COLOR_WHITE;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for(i = 0; i < TEST_RENDER_FRAMES; i++)
+    {
+        test_render_begin(i & 1);
+        for(j = 0; j < TEST_RENDER_SHAPES; j++)
+        {
+            shape->params(p);
+            c = (ssd1306_color_t)(host_random() & 1);
+            shape->draw(p, c, false);
+            shape->draw(p, c, true);
+        }
+        snprintf(what, sizeof(what), "%s frame %u, last %d %d %d %d %d %d", shape->name, i, p[0], p[1], p[2], p[3],
+            p[4], p[5]);
+        HOST_CHECK(test_render_end(what, i & 1));
+    }
+
+    return;
+}
+
+/**
+ * @brief   Filled triangle is filled between leftmost and rightmost pixel of old outline on every row. Old filler
+ *          drew lines to third vertex, which left holes and spilled past outline, so it is not compared.
+ */
+static void test_render_filled_triangles(void)
+{
+    char what[64];
+    int16_t p[6] = {0};
+    ssd1306_color_t c = SSD1306_COLOR_WHITE;
+    uint32_t i = 0;
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t x_min = 0;
+    int16_t x_max = 0;
+
+    for(i = 0; i < TEST_RENDER_TRIANGLES; i++)
+    {
+        test_render_triangle_params(p);
+        c = (ssd1306_color_t)(host_random() & 1);
+        ssd1306_fill((ssd1306_color_t)!c);
+        ssd1306_ref_fill((ssd1306_color_t)!c);
+        ssd1306_draw_filled_triangle(p[0], p[1], p[2], p[3], p[4], p[5], c);
+        ssd1306_ref_draw_triangle(p[0], p[1], p[2], p[3], p[4], p[5], c);
+        for(y = 0; y < SSD1306_HEIGHT; y++)
+        {
+            x_min = SSD1306_WIDTH;
+            x_max = -1;
+            for(x = 0; x < SSD1306_WIDTH; x++)
+            {
+                if(ssd1306_ref_get_pixel(x, y) == (c == SSD1306_COLOR_WHITE))
+                {
+                    x_min = x < x_min ? x : x_min;
+                    x_max = x;
+                }
+            }
+            for(x = x_min; x <= x_max; x++)
+            {
+                ssd1306_ref_draw_pixel(x, y, c);
+            }
+        }
+        snprintf(what, sizeof(what), "filled triangle %d,%d %d,%d %d,%d", p[0], p[1], p[2], p[3], p[4], p[5]);
+        HOST_CHECK(test_render_end(what, false));
+    }
+
+    return;
+}
+
+/**
+ * @brief   Lines running past screen edges, every fourth one horizontal and every fourth one vertical.
+ */
+static void test_render_line_params(int16_t *p)
+{
+    p[0] = test_render_range(0, SSD1306_WIDTH + 32);
+    p[1] = test_render_range(0, SSD1306_HEIGHT + 16);
+    p[2] = test_render_range(0, SSD1306_WIDTH + 32);
+    p[3] = test_render_range(0, SSD1306_HEIGHT + 16);
+    switch(host_random() % 4)
+    {
+        case 0:
+            p[3] = p[1];
+            break;
+        case 1:
+            p[2] = p[0];
+            break;
+        default:
+            break;
+    }
+
+    return;
+}
+
+static void test_render_line(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_line(p[0], p[1], p[2], p[3], c);
+    }
+    else
+    {
+        ssd1306_draw_line(p[0], p[1], p[2], p[3], c);
+    }
+
+    return;
+}
+
+/**
+ * @brief   Rectangles starting on screen, size may run past screen edges.
+ */
+static void test_render_rectangle_params(int16_t *p)
+{
+    p[0] = test_render_range(0, SSD1306_WIDTH);
+    p[1] = test_render_range(0, SSD1306_HEIGHT);
+    p[2] = test_render_range(0, SSD1306_WIDTH / 2);
+    p[3] = test_render_range(0, SSD1306_HEIGHT / 2);
+
+    return;
+}
+
+static void test_render_rectangle(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_rectangle(p[0], p[1], p[2], p[3], c);
+    }
+    else
+    {
+        ssd1306_draw_rectangle(p[0], p[1], p[2], p[3], c);
+    }
+
+    return;
+}
+
+static void test_render_filled_rectangle(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_filled_rectangle(p[0], p[1], p[2], p[3], c);
+    }
+    else
+    {
+        ssd1306_draw_filled_rectangle(p[0], p[1], p[2], p[3], c);
+    }
+
+    return;
+}
+
+/**
+ * @brief   Triangles with vertices past screen edges.
+ */
+static void test_render_triangle_params(int16_t *p)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < 6; i += 2)
+    {
+        p[i] = test_render_range(0, SSD1306_WIDTH + 32);
+        p[i + 1] = test_render_range(0, SSD1306_HEIGHT + 16);
+    }
+
+    return;
+}
+
+static void test_render_triangle(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_triangle(p[0], p[1], p[2], p[3], p[4], p[5], c);
+    }
+    else
+    {
+        ssd1306_draw_triangle(p[0], p[1], p[2], p[3], p[4], p[5], c);
+    }
+
+    return;
+}
+
+/**
+ * @brief   Circles crossing any screen edge.
+ */
+static void test_render_circle_params(int16_t *p)
+{
+    p[0] = test_render_range(-20, SSD1306_WIDTH + 20);
+    p[1] = test_render_range(-20, SSD1306_HEIGHT + 20);
+    p[2] = test_render_range(0, 40);
+
+    return;
+}
+
+static void test_render_circle(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_circle(p[0], p[1], p[2], c);
+    }
+    else
+    {
+        ssd1306_draw_circle(p[0], p[1], p[2], c);
+    }
+
+    return;
+}
+
+/**
+ * @brief   Circles fully on screen. Old code clamped spans past an edge to last row or column instead of clipping
+ *          them, those are covered by golden image clipped.
+ */
+static void test_render_filled_circle_params(int16_t *p)
+{
+    p[2] = test_render_range(0, SSD1306_HEIGHT / 2);
+    p[0] = test_render_range(p[2], SSD1306_WIDTH - p[2]);
+    p[1] = test_render_range(p[2], SSD1306_HEIGHT - p[2]);
+
+    return;
+}
+
+static void test_render_filled_circle(const int16_t *p, ssd1306_color_t c, bool ref)
+{
+    if(ref)
+    {
+        ssd1306_ref_draw_filled_circle(p[0], p[1], p[2], c);
+    }
+    else
+    {
+        ssd1306_draw_filled_circle(p[0], p[1], p[2], c);
+    }
+
+    return;
+}
@@ -0,0 +1,149 @@
+/**
+ **********************************************************************************************************************
+ * @file         host_test.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Helpers of host tests and benchmarks.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static uint32_t host_random_state = 0x9E3779B9;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+uint32_t host_test_failures = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool host_test_check(bool ok, const char *expr, const char *file, int line)
+{
+    if(!ok)
+    {
+        host_test_failures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+
+    return ok;
+}
+
+int host_test_result(const char *name)
+{
+    if(host_test_failures != 0)
+    {
+        printf("%s: %u checks failed\n", name, host_test_failures);
+        return 1;
+    }
+    printf("%s: passed\n", name);
+
+    return 0;
+}
+
+void host_random_seed(uint32_t seed)
+{
+    /* Xorshift state must not be zero */
+    host_random_state = seed != 0 ? seed : 0x9E3779B9;
+
+    return;
+}
+
+uint32_t host_random(void)
+{
+    host_random_state ^= host_random_state << 13;
+    host_random_state ^= host_random_state >> 17;
+    host_random_state ^= host_random_state << 5;
+
+    return host_random_state;
+}
+
+uint64_t host_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint8_t *host_file_read(const char *path, uint32_t *size)
+{
+    FILE *file = NULL;
+    uint8_t *data = NULL;
+    long length = 0;
+
+    if((file = fopen(path, "rb")) == NULL)
+    {
+        return NULL;
+    }
+    if(fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        if((data = malloc(length + 1)) != NULL && fread(data, 1, length, file) != (size_t)length)
+        {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    *size = (uint32_t)length;
+
+    return data;
+}
+
+bool host_file_write(const char *path, const uint8_t *data, uint32_t size)
+{
+    FILE *file = NULL;
+    bool ok = false;
+
+    if((file = fopen(path, "wb")) == NULL)
+    {
+        return false;
+    }
+    ok = fwrite(data, 1, size, file) == size;
+
+    return fclose(file) == 0 && ok;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
@@ -0,0 +1,125 @@
+/**
+ **********************************************************************************************************************
+ * @file        host_test.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Helpers of host tests and benchmarks.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/** Check condition, failed check is reported with location and counted, test goes on. */
+#define HOST_CHECK(C)       host_test_check((C), #C, __FILE__, __LINE__)
+/** Keep benchmark result alive, so compiler does not drop measured code. */
+#define HOST_KEEP(X)        __asm__ volatile("" : : "g"(X) : "memory")
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+extern uint32_t host_test_failures;
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Count and report failed check.
+ *
+ * @param   ok      Check result.
+ * @param   expr    Checked expression.
+ * @param   file    Source file.
+ * @param   line    Source line.
+ *
+ * @return  Check result.
+ */
+bool host_test_check(bool ok, const char *expr, const char *file, int line);
+
+/**
+ * @brief   Print summary of checks.
+ *
+ * @param   name    Test name.
+ *
+ * @return  Process exit code, 0 when all checks passed.
+ */
+int host_test_result(const char *name);
+
+/**
+ * @brief   Restart random sequence of @ref host_random(). Same seed gives same sequence, so runs are reproducible.
+ *
+ * @param   seed    Seed, 0 selects default seed.
+ */
+void host_random_seed(uint32_t seed);
+
+/**
+ * @brief   Get next pseudo random number, xorshift generator.
+ *
+ * @return  Random number.
+ */
+uint32_t host_random(void);
+
+/**
+ * @brief   Get monotonic time.
+ *
+ * @return  Time in ns.
+ */
+uint64_t host_time_ns(void);
+
+/**
+ * @brief   Read whole file to allocated buffer.
+ *
+ * @param   path    File path.
+ * @param   size    Size of file.
+ *
+ * @return  Buffer to free, NULL if file can not be read.
+ */
+uint8_t *host_file_read(const char *path, uint32_t *size);
+
+/**
+ * @brief   Write whole file.
+ *
+ * @param   path    File path.
+ * @param   data    Data.
+ * @param   size    Size of data.
+ *
+ * @return  False if file can not be written.
+ */
+bool host_file_write(const char *path, const uint8_t *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_TEST_H_ */
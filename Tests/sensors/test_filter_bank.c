@@ -0,0 +1,423 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_filter_bank.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Host test of fixed-point biquad and FIR kernels of filter bank against double reference.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "sensors/filter_bank.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_FILTER_BANK_COUNT      1024    //!< Samples per signal.
+#define TEST_FILTER_BANK_RATE       200.0f  //!< Sample rate, like joystick.
+#define TEST_FILTER_BANK_FREQ       8.0f    //!< Cut off or center frequency, like joystick smoothing.
+#define TEST_FILTER_BANK_Q          0.7071f //!< Butterworth section.
+#define TEST_FILTER_BANK_STEP       (1L << 20)  //!< Step amplitude, joystick range with 8 fraction bits and more.
+#define TEST_FILTER_BANK_TAPS       15      //!< FIR taps.
+#define TEST_FILTER_BANK_BLOCK_MAX  37      //!< Longest random block.
+#define TEST_FILTER_BANK_SEED       0x6A09E667  //!< Seed of random signals and blocks.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Fixed-point biquad coefficient to double. */
+#define TEST_FILTER_BANK_COEF(X)    ((double)(X) / (1L << FILTER_BANK_IIR_FRAC))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Designed section and DC gain it must have.
+ */
+typedef struct
+{
+    const char *name;
+    filter_bank_type_t type;
+    double dc_gain;
+} test_filter_bank_design_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static const test_filter_bank_design_t test_filter_bank_designs[] =
+{
+    {"low pass", FILTER_BANK_LOW_PASS, 1.0},
+    {"high pass", FILTER_BANK_HIGH_PASS, 0.0},
+    {"band pass", FILTER_BANK_BAND_PASS, 0.0},
+    {"notch", FILTER_BANK_NOTCH, 1.0},
+};
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void test_filter_bank_reference(const filter_bank_biquad_t *coef, uint8_t stages, const int32_t *in,
+                                       double *out, uint16_t count);
+static double test_filter_bank_l1(const filter_bank_biquad_t *coef, bool poles_only);
+static void test_filter_bank_random(int32_t *data, uint16_t count, int32_t amplitude);
+static void test_filter_bank_iir_step(const test_filter_bank_design_t *design);
+static void test_filter_bank_fir_impulse(uint8_t taps);
+static void test_filter_bank_blocks(void);
+static void test_filter_bank_channels(void);
+static void test_filter_bank_invalid(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    uint32_t i = 0;
+
+    host_random_seed(TEST_FILTER_BANK_SEED);
+    for(i = 0; i < sizeof(test_filter_bank_designs) / sizeof(test_filter_bank_designs[0]); i++)
+    {
+        test_filter_bank_iir_step(&test_filter_bank_designs[i]);
+    }
+    test_filter_bank_fir_impulse(1);
+    test_filter_bank_fir_impulse(TEST_FILTER_BANK_TAPS);
+    test_filter_bank_fir_impulse(FILTER_BANK_TAPS_MAX);
+    test_filter_bank_blocks();
+    test_filter_bank_channels();
+    test_filter_bank_invalid();
+
+    return host_test_result("filter_bank");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Cascaded direct form I biquads in double with same fixed-point coefficients.
+ *
+ * @param   coef    Coefficients of sections.
+ * @param   stages  Number of sections.
+ * @param   in      Input samples.
+ * @param   out     Output samples.
+ * @param   count   Number of samples.
+ */
+static void test_filter_bank_reference(const filter_bank_biquad_t *coef, uint8_t stages, const int32_t *in,
+                                       double *out, uint16_t count)
+{
+    double x[FILTER_BANK_STAGES_MAX][2] = {{0}};
+    double y[FILTER_BANK_STAGES_MAX][2] = {{0}};
+    double value = 0;
+    double result = 0;
+    uint8_t stage = 0;
+    uint16_t n = 0;
+
+    for(n = 0; n < count; n++)
+    {
+        value = in[n];
+        for(stage = 0; stage < stages; stage++)
+        {
+            result = TEST_FILTER_BANK_COEF(coef[stage].b0) * value +
+                TEST_FILTER_BANK_COEF(coef[stage].b1) * x[stage][0] +
+                TEST_FILTER_BANK_COEF(coef[stage].b2) * x[stage][1] -
+                TEST_FILTER_BANK_COEF(coef[stage].a1) * y[stage][0] -
+                TEST_FILTER_BANK_COEF(coef[stage].a2) * y[stage][1];
+            x[stage][1] = x[stage][0];
+            x[stage][0] = value;
+            y[stage][1] = y[stage][0];
+            y[stage][0] = result;
+            value = result;
+        }
+        out[n] = value;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Sum of absolute impulse response of section, bounds how much error at its output can grow.
+ *
+ * @param   coef        Coefficients of section.
+ * @param   poles_only  Response of feedback part 1 / A(z) only, path of rounding error of output.
+ *
+ * @return  L1 norm of impulse response.
+ */
+static double test_filter_bank_l1(const filter_bank_biquad_t *coef, bool poles_only)
+{
+    double b0 = poles_only ? 1 : TEST_FILTER_BANK_COEF(coef->b0);
+    double b1 = poles_only ? 0 : TEST_FILTER_BANK_COEF(coef->b1);
+    double b2 = poles_only ? 0 : TEST_FILTER_BANK_COEF(coef->b2);
+    double x[3] = {1, 0, 0};
+    double y[3] = {0};
+    double norm = 0;
+    uint32_t n = 0;
+
+    for(n = 0; n < 100 * TEST_FILTER_BANK_COUNT; n++)
+    {
+        y[0] = b0 * x[0] + b1 * x[1] + b2 * x[2] - TEST_FILTER_BANK_COEF(coef->a1) * y[1] -
+            TEST_FILTER_BANK_COEF(coef->a2) * y[2];
+        norm += fabs(y[0]);
+        x[2] = x[1];
+        x[1] = x[0];
+        x[0] = 0;
+        y[2] = y[1];
+        y[1] = y[0];
+    }
+
+    return norm;
+}
+
+static void test_filter_bank_random(int32_t *data, uint16_t count, int32_t amplitude)
+{
+    uint16_t n = 0;
+
+    for(n = 0; n < count; n++)
+    {
+        data[n] = (int32_t)(host_random() % (2 * (uint32_t)amplitude + 1)) - amplitude;
+    }
+
+    return;
+}
+
+/**
+ * @brief   DC gain of designed section and step response of one and two sections against double filter.
+ */
+static void test_filter_bank_iir_step(const test_filter_bank_design_t *design)
+{
+    filter_bank_biquad_t coef[2] = {{0}};
+    filter_bank_iir_t iir = {0};
+    int32_t data[TEST_FILTER_BANK_COUNT];
+    int32_t step[TEST_FILTER_BANK_COUNT];
+    double ref[TEST_FILTER_BANK_COUNT];
+    double gain = 0;
+    double error = 0;
+    double bound = 0;
+    uint8_t stages = 0;
+    uint16_t n = 0;
+
+    HOST_CHECK(filter_bank_biquad_design(&coef[0], design->type, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ,
+                                         TEST_FILTER_BANK_Q));
+    coef[1] = coef[0];
+
+    /* Gain at z = 1 of quantized coefficients */
+    gain = (TEST_FILTER_BANK_COEF(coef[0].b0) + TEST_FILTER_BANK_COEF(coef[0].b1) + TEST_FILTER_BANK_COEF(coef[0].b2)) /
+        (1 + TEST_FILTER_BANK_COEF(coef[0].a1) + TEST_FILTER_BANK_COEF(coef[0].a2));
+    if(!HOST_CHECK(fabs(gain - design->dc_gain) < 1e-4))
+    {
+        printf("  %s: DC gain %.7f\n", design->name, gain);
+    }
+
+    for(n = 0; n < TEST_FILTER_BANK_COUNT; n++)
+    {
+        step[n] = TEST_FILTER_BANK_STEP;
+    }
+    for(stages = 1; stages <= 2; stages++)
+    {
+        HOST_CHECK(filter_bank_iir_init(&iir, coef, stages, 1));
+        memcpy(data, step, sizeof(data));
+        filter_bank_iir_process(&iir, data, TEST_FILTER_BANK_COUNT);
+        test_filter_bank_reference(coef, stages, step, ref, TEST_FILTER_BANK_COUNT);
+
+        /* Half LSB rounding of every output is fed back through poles, error of first section then passes second
+           section as whole */
+        bound = 0.5 * test_filter_bank_l1(&coef[0], true);
+        bound = stages == 1 ? bound : bound * (test_filter_bank_l1(&coef[0], false) + 1);
+        error = 0;
+        for(n = 0; n < TEST_FILTER_BANK_COUNT; n++)
+        {
+            error = fmax(error, fabs(data[n] - ref[n]));
+        }
+        if(!HOST_CHECK(error <= bound))
+        {
+            printf("  %s, %u sections: step error %.2f LSB, bound %.2f\n", design->name, stages, error, bound);
+        }
+        /* Settled output is step times DC gain */
+        if(!HOST_CHECK(fabs(data[TEST_FILTER_BANK_COUNT - 1] - TEST_FILTER_BANK_STEP * design->dc_gain) <=
+                       TEST_FILTER_BANK_STEP * 1e-4 * stages + bound))
+        {
+            printf("  %s, %u sections: settled at %d\n", design->name, stages, data[TEST_FILTER_BANK_COUNT - 1]);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief   Impulse of one in Q15 gives taps back, designed taps have unity DC gain.
+ */
+static void test_filter_bank_fir_impulse(uint8_t taps)
+{
+    int16_t coef[FILTER_BANK_TAPS_MAX] = {0};
+    filter_bank_fir_t fir = {0};
+    int32_t data[2 * FILTER_BANK_TAPS_MAX] = {0};
+    int32_t sum = 0;
+    uint8_t i = 0;
+
+    HOST_CHECK(filter_bank_fir_design(coef, taps, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ));
+    for(i = 0; i < taps; i++)
+    {
+        sum += coef[i];
+    }
+    /* Each tap is rounded by half LSB at most, single tap of 1.0 saturates to INT16_MAX */
+    HOST_CHECK(fabs(sum - (1 << FILTER_BANK_FIR_FRAC)) <= (taps + 1) / 2.0);
+
+    HOST_CHECK(filter_bank_fir_init(&fir, coef, taps, 1));
+    data[0] = 1 << FILTER_BANK_FIR_FRAC;
+    filter_bank_fir_process(&fir, data, 2 * taps);
+    for(i = 0; i < 2 * taps; i++)
+    {
+        HOST_CHECK(data[i] == (i < taps ? coef[i] : 0));
+    }
+
+    return;
+}
+
+/**
+ * @brief   Signal filtered in random blocks gives same output as in one block, state carries over boundaries.
+ */
+static void test_filter_bank_blocks(void)
+{
+    filter_bank_biquad_t coef[2] = {{0}};
+    int16_t taps[TEST_FILTER_BANK_TAPS] = {0};
+    filter_bank_iir_t iir = {0};
+    filter_bank_iir_t iir_blocks = {0};
+    filter_bank_fir_t fir = {0};
+    filter_bank_fir_t fir_blocks = {0};
+    int32_t whole[TEST_FILTER_BANK_COUNT];
+    int32_t blocks[TEST_FILTER_BANK_COUNT];
+    uint16_t size = 0;
+    uint16_t n = 0;
+
+    HOST_CHECK(filter_bank_biquad_design(&coef[0], FILTER_BANK_LOW_PASS, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ,
+                                         TEST_FILTER_BANK_Q));
+    HOST_CHECK(filter_bank_biquad_design(&coef[1], FILTER_BANK_NOTCH, TEST_FILTER_BANK_RATE, 50.0f, 2.0f));
+    HOST_CHECK(filter_bank_fir_design(taps, TEST_FILTER_BANK_TAPS, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ));
+    HOST_CHECK(filter_bank_iir_init(&iir, coef, 2, 1) && filter_bank_iir_init(&iir_blocks, coef, 2, 1));
+    HOST_CHECK(filter_bank_fir_init(&fir, taps, TEST_FILTER_BANK_TAPS, 1) &&
+               filter_bank_fir_init(&fir_blocks, taps, TEST_FILTER_BANK_TAPS, 1));
+
+    test_filter_bank_random(whole, TEST_FILTER_BANK_COUNT, TEST_FILTER_BANK_STEP);
+    memcpy(blocks, whole, sizeof(blocks));
+
+    filter_bank_iir_process(&iir, whole, TEST_FILTER_BANK_COUNT);
+    filter_bank_fir_process(&fir, whole, TEST_FILTER_BANK_COUNT);
+    for(n = 0; n < TEST_FILTER_BANK_COUNT; n += size)
+    {
+        size = 1 + host_random() % TEST_FILTER_BANK_BLOCK_MAX;
+        size = size > TEST_FILTER_BANK_COUNT - n ? TEST_FILTER_BANK_COUNT - n : size;
+        filter_bank_iir_process(&iir_blocks, &blocks[n], size);
+        filter_bank_fir_process(&fir_blocks, &blocks[n], size);
+    }
+
+    HOST_CHECK(memcmp(whole, blocks, sizeof(whole)) == 0);
+
+    return;
+}
+
+/**
+ * @brief   Channels of one filter are laid out block after block and filtered like separate filters.
+ */
+static void test_filter_bank_channels(void)
+{
+    static int32_t input[FILTER_BANK_CHANNELS_MAX][TEST_FILTER_BANK_COUNT];
+    static int32_t output[FILTER_BANK_CHANNELS_MAX][TEST_FILTER_BANK_COUNT];
+    filter_bank_biquad_t coef = {0};
+    int16_t taps[TEST_FILTER_BANK_TAPS] = {0};
+    filter_bank_iir_t iir = {0};
+    filter_bank_fir_t fir = {0};
+    int32_t block[FILTER_BANK_CHANNELS_MAX * TEST_FILTER_BANK_BLOCK_MAX];
+    uint8_t channels = 0;
+    uint8_t ch = 0;
+    uint16_t size = 0;
+    uint16_t n = 0;
+
+    HOST_CHECK(filter_bank_biquad_design(&coef, FILTER_BANK_LOW_PASS, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ,
+                                         TEST_FILTER_BANK_Q));
+    HOST_CHECK(filter_bank_fir_design(taps, TEST_FILTER_BANK_TAPS, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ));
+
+    for(channels = 2; channels <= FILTER_BANK_CHANNELS_MAX; channels++)
+    {
+        for(ch = 0; ch < channels; ch++)
+        {
+            /* Different amplitude per channel, so mixed up channels show */
+            test_filter_bank_random(input[ch], TEST_FILTER_BANK_COUNT, TEST_FILTER_BANK_STEP >> (4 * ch));
+        }
+
+        /* All channels in one filter, random blocks */
+        HOST_CHECK(filter_bank_iir_init(&iir, &coef, 1, channels));
+        HOST_CHECK(filter_bank_fir_init(&fir, taps, TEST_FILTER_BANK_TAPS, channels));
+        for(n = 0; n < TEST_FILTER_BANK_COUNT; n += size)
+        {
+            size = 1 + host_random() % TEST_FILTER_BANK_BLOCK_MAX;
+            size = size > TEST_FILTER_BANK_COUNT - n ? TEST_FILTER_BANK_COUNT - n : size;
+            for(ch = 0; ch < channels; ch++)
+            {
+                memcpy(&block[ch * size], &input[ch][n], size * sizeof(int32_t));
+            }
+            filter_bank_iir_process(&iir, block, size);
+            filter_bank_fir_process(&fir, block, size);
+            for(ch = 0; ch < channels; ch++)
+            {
+                memcpy(&output[ch][n], &block[ch * size], size * sizeof(int32_t));
+            }
+        }
+
+        /* Each channel alone */
+        for(ch = 0; ch < channels; ch++)
+        {
+            HOST_CHECK(filter_bank_iir_init(&iir, &coef, 1, 1));
+            HOST_CHECK(filter_bank_fir_init(&fir, taps, TEST_FILTER_BANK_TAPS, 1));
+            filter_bank_iir_process(&iir, input[ch], TEST_FILTER_BANK_COUNT);
+            filter_bank_fir_process(&fir, input[ch], TEST_FILTER_BANK_COUNT);
+            if(!HOST_CHECK(memcmp(input[ch], output[ch], sizeof(output[ch])) == 0))
+            {
+                printf("  %u channels: channel %u differs\n", channels, ch);
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief   Out of range parameters are rejected.
+ */
+static void test_filter_bank_invalid(void)
+{
+    filter_bank_biquad_t coef = {0};
+    int16_t taps[FILTER_BANK_TAPS_MAX] = {0};
+    filter_bank_iir_t iir = {0};
+    filter_bank_fir_t fir = {0};
+
+    HOST_CHECK(!filter_bank_biquad_design(&coef, FILTER_BANK_LAST, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ,
+                                          TEST_FILTER_BANK_Q));
+    HOST_CHECK(!filter_bank_biquad_design(&coef, FILTER_BANK_LOW_PASS, TEST_FILTER_BANK_RATE,
+                                          TEST_FILTER_BANK_RATE / 2, TEST_FILTER_BANK_Q));
+    HOST_CHECK(!filter_bank_fir_design(taps, FILTER_BANK_TAPS_MAX + 1, TEST_FILTER_BANK_RATE, TEST_FILTER_BANK_FREQ));
+    HOST_CHECK(!filter_bank_iir_init(&iir, &coef, FILTER_BANK_STAGES_MAX + 1, 1));
+    HOST_CHECK(!filter_bank_iir_init(&iir, &coef, 1, FILTER_BANK_CHANNELS_MAX + 1));
+    HOST_CHECK(!filter_bank_fir_init(&fir, taps, 0, 1));
+    HOST_CHECK(!filter_bank_fir_init(&fir, taps, 1, 0));
+
+    return;
+}
@@ -0,0 +1,213 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_filters.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Accuracy of fixed-point filters against double formulas they replaced.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sensors/filters.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_FILTERS_COUNT      4096    //!< Filter updates per signal.
+#define TEST_FILTERS_FRAC       4       //!< Fraction bits of fixed-point values, like motor and light sensor.
+#define TEST_FILTERS_CUT_OFF    0.25    //!< Cut off of low and high pass.
+#define TEST_FILTERS_PROC_COV   (1.0 / 256) //!< Kalman process noise covariance.
+#define TEST_FILTERS_MEAS_COV   0.25    //!< Kalman measurement noise covariance.
+#define TEST_FILTERS_EST_ERROR  1.0     //!< Kalman initial estimation error covariance.
+#define TEST_FILTERS_COV_ONE    65536   //!< Covariance 1.0 of fixed-point Kalman filter.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Fixed-point value to double. */
+#define TEST_FILTERS_FROM_Q(X)  ((double)(X) / (1 << TEST_FILTERS_FRAC))
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Largest errors of one signal, in input LSB.
+ */
+typedef struct
+{
+    double low_pass_q;
+    double high_pass_q;
+    double kalman_q;
+    double low_pass;
+    double high_pass;
+    double kalman;
+} test_filters_error_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static q31_t test_filters_signal(uint32_t i, uint8_t kind);
+static void test_filters_run(uint8_t kind, test_filters_error_t *error);
+static void test_filters_max(double *error, double value, double ref);
+static void test_filters_saturation(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    test_filters_error_t error;
+    uint8_t kind = 0;
+
+    for(kind = 0; kind < 2; kind++)
+    {
+        test_filters_run(kind, &error);
+        printf("signal %u, max error in LSB: low pass Q %.4f, double %.5f; high pass Q %.4f, double %.5f; "
+            "kalman Q %.4f, double %.4f\n", kind, error.low_pass_q, error.low_pass, error.high_pass_q,
+            error.high_pass, error.kalman_q, error.kalman);
+
+        /* Rounding towards minus infinity loses up to 1 LSB of Q format per update, divided by cut off */
+        HOST_CHECK(error.low_pass_q <= 0.25);
+        HOST_CHECK(error.high_pass_q <= 0.25);
+        /* Gain is Q15 and estimation error has 16 fraction bits */
+        HOST_CHECK(error.kalman_q <= 1.0);
+        /* Double wrappers work on 12 fraction bits */
+        HOST_CHECK(error.low_pass <= 0.002);
+        HOST_CHECK(error.high_pass <= 0.002);
+        HOST_CHECK(error.kalman <= 0.5);
+    }
+    test_filters_saturation();
+
+    return host_test_result("filters");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Test signals in Q format of @ref TEST_FILTERS_FRAC.
+ *
+ * @param   i       Sample index.
+ * @param   kind    0 is noisy 12 bit ramp like ADC, 1 is noisy sine of +-1000.
+ *
+ * @return  Sample.
+ */
+static q31_t test_filters_signal(uint32_t i, uint8_t kind)
+{
+    if(kind == 0)
+    {
+        return ((i * 16 + (i * 7919) % 509) & 0xFFF) << TEST_FILTERS_FRAC;
+    }
+
+    return (q31_t)lround((1000 * sin(i * 0.05) + (int32_t)((i * 7919) % 201) - 100) * (1 << TEST_FILTERS_FRAC));
+}
+
+/**
+ * @brief   Run fixed-point filters, double wrappers and double formulas they replaced over same signal.
+ *
+ * @param   kind    Signal, see @ref test_filters_signal.
+ * @param   error   Largest errors against double formulas.
+ */
+static void test_filters_run(uint8_t kind, test_filters_error_t *error)
+{
+    filters_low_pass_q_t low_pass_q = {.cut_off = FILTERS_Q15(TEST_FILTERS_CUT_OFF)};
+    filters_high_pass_q_t high_pass_q = {.cut_off = FILTERS_Q15(TEST_FILTERS_CUT_OFF)};
+    filters_kalman_q_t kalman_q = filter_kalman_q_init(TEST_FILTERS_PROC_COV * TEST_FILTERS_COV_ONE,
+        TEST_FILTERS_MEAS_COV * TEST_FILTERS_COV_ONE, TEST_FILTERS_EST_ERROR * TEST_FILTERS_COV_ONE, 0);
+    filters_low_pass_t low_pass = {0};
+    filters_high_pass_t high_pass = {0};
+    filters_kalman_t kalman = filter_kalman_init(TEST_FILTERS_PROC_COV, TEST_FILTERS_MEAS_COV,
+        TEST_FILTERS_EST_ERROR, 0);
+    double low_pass_ref = 0;
+    double high_pass_ref = 0;
+    double kalman_ref = 0;
+    double kalman_error = TEST_FILTERS_EST_ERROR;
+    double kalman_gain = 0;
+    double input = 0;
+    q31_t sample = 0;
+    uint32_t i = 0;
+
+    *error = (test_filters_error_t){0};
+    for(i = 0; i < TEST_FILTERS_COUNT; i++)
+    {
+        sample = test_filters_signal(i, kind);
+        input = TEST_FILTERS_FROM_Q(sample);
+
+        /* Double formulas before fixed-point rewrite */
+        low_pass_ref = low_pass_ref + TEST_FILTERS_CUT_OFF * (input - low_pass_ref);
+        high_pass_ref = input - (high_pass_ref + TEST_FILTERS_CUT_OFF * (input - high_pass_ref));
+        kalman_error = kalman_error + TEST_FILTERS_PROC_COV;
+        kalman_gain = kalman_error / (kalman_error + TEST_FILTERS_MEAS_COV);
+        kalman_ref = kalman_ref + kalman_gain * (input - kalman_ref);
+        kalman_error = (1 - kalman_gain) * kalman_error;
+
+        test_filters_max(&error->low_pass_q, TEST_FILTERS_FROM_Q(filter_low_pass_q(&low_pass_q, sample)),
+            low_pass_ref);
+        test_filters_max(&error->high_pass_q, TEST_FILTERS_FROM_Q(filter_high_pass_q(&high_pass_q, sample)),
+            high_pass_ref);
+        test_filters_max(&error->kalman_q, TEST_FILTERS_FROM_Q(filters_kalman_q_update(&kalman_q, sample)),
+            kalman_ref);
+        test_filters_max(&error->low_pass, filter_low_pass(&low_pass, input, TEST_FILTERS_CUT_OFF), low_pass_ref);
+        test_filters_max(&error->high_pass, filter_high_pass(&high_pass, input, TEST_FILTERS_CUT_OFF),
+            high_pass_ref);
+        test_filters_max(&error->kalman, filters_kalman_update(&kalman, input), kalman_ref);
+    }
+
+    return;
+}
+
+static void test_filters_max(double *error, double value, double ref)
+{
+    double diff = fabs(value - ref);
+
+    *error = diff > *error ? diff : *error;
+
+    return;
+}
+
+/**
+ * @brief   Full scale steps saturate instead of wrapping.
+ */
+static void test_filters_saturation(void)
+{
+    filters_low_pass_q_t low_pass = {.output = INT32_MIN, .cut_off = FILTERS_Q15(1.0)};
+    filters_high_pass_q_t high_pass = {.output = INT32_MIN, .cut_off = FILTERS_Q15(0.5)};
+    filters_kalman_q_t kalman = filter_kalman_q_init(UINT32_MAX, 1, UINT32_MAX, INT32_MIN);
+
+    HOST_CHECK(filters_q31_sat((int64_t)INT32_MAX + 1) == INT32_MAX);
+    HOST_CHECK(filters_q31_sat((int64_t)INT32_MIN - 1) == INT32_MIN);
+    HOST_CHECK(filters_q31_mul(INT64_C(1) << 40, INT16_MAX) == INT32_MAX);
+
+    HOST_CHECK(filter_low_pass_q(&low_pass, INT32_MAX) > 0);
+    HOST_CHECK(filter_high_pass_q(&high_pass, INT32_MAX) >= 0);
+    HOST_CHECK(filters_kalman_q_update(&kalman, INT32_MAX) > 0);
+    HOST_CHECK(kalman.gain > 0);
+
+    return;
+}
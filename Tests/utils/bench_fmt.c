@@ -0,0 +1,216 @@
+/**
+ **********************************************************************************************************************
+ * @file         bench_fmt.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Benchmark of formatter against C library snprintf on formats used by firmware.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fmt.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define BENCH_FMT_ITERATIONS    200000  //!< Default iterations of every case.
+#define BENCH_FMT_RUNS          5       //!< Runs of every case, fastest one is reported.
+#define BENCH_FMT_SIZE          64      //!< Output buffer size.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*run)(char *buffer, uint32_t i);  //!< Formats once with fmt, i is iteration.
+    void (*ref)(char *buffer, uint32_t i);  //!< Formats same once with C library.
+} bench_fmt_case_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static double bench_fmt_time(void (*run)(char *buffer, uint32_t i), uint32_t iterations);
+static void bench_fmt_clock(char *buffer, uint32_t i);
+static void bench_fmt_clock_ref(char *buffer, uint32_t i);
+static void bench_fmt_boot(char *buffer, uint32_t i);
+static void bench_fmt_boot_ref(char *buffer, uint32_t i);
+static void bench_fmt_fixed(char *buffer, uint32_t i);
+static void bench_fmt_fixed_ref(char *buffer, uint32_t i);
+static void bench_fmt_hex(char *buffer, uint32_t i);
+static void bench_fmt_hex_ref(char *buffer, uint32_t i);
+static void bench_fmt_64(char *buffer, uint32_t i);
+static void bench_fmt_64_ref(char *buffer, uint32_t i);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const bench_fmt_case_t cases[] =
+    {
+        {"clock %02d:%02d:%02d", bench_fmt_clock, bench_fmt_clock_ref},
+        {"boot %-15.15s %u", bench_fmt_boot, bench_fmt_boot_ref},
+        {"fixed 2 decimals", bench_fmt_fixed, bench_fmt_fixed_ref},
+        {"hex %08x", bench_fmt_hex, bench_fmt_hex_ref},
+        {"64 bit %llu", bench_fmt_64, bench_fmt_64_ref},
+    };
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_FMT_ITERATIONS;
+    double time = 0;
+    double ref = 0;
+    uint32_t i = 0;
+
+    if(iterations == 0)
+    {
+        return 1;
+    }
+
+    printf("%-28s %12s %12s %8s\n", "case", "ns per call", "snprintf", "speedup");
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        time = bench_fmt_time(cases[i].run, iterations);
+        ref = bench_fmt_time(cases[i].ref, iterations);
+        printf("%-28s %12.1f %12.1f %7.1fx\n", cases[i].name, time, ref, ref / time);
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Time case. Fastest of @ref BENCH_FMT_RUNS runs is taken, so scheduling noise of host does not decide
+ *          comparison.
+ *
+ * @param   run         Case.
+ * @param   iterations  Calls of case in every run.
+ *
+ * @return  Time per call in ns.
+ */
+static double bench_fmt_time(void (*run)(char *buffer, uint32_t i), uint32_t iterations)
+{
+    char buffer[BENCH_FMT_SIZE];
+    uint64_t start = 0;
+    uint64_t time = 0;
+    uint64_t best = UINT64_MAX;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for(i = 0; i < BENCH_FMT_RUNS; i++)
+    {
+        start = host_time_ns();
+        for(j = 0; j < iterations; j++)
+        {
+            run(buffer, j);
+            HOST_KEEP(buffer);
+        }
+        time = host_time_ns() - start;
+        best = time < best ? time : best;
+    }
+
+    return (double)best / iterations;
+}
+
+static void bench_fmt_clock(char *buffer, uint32_t i)
+{
+    fmt_snprintf(buffer, BENCH_FMT_SIZE, "%02d:%02d:%02d", (int)(i % 24), (int)(i % 60), (int)(i % 59));
+
+    return;
+}
+
+static void bench_fmt_clock_ref(char *buffer, uint32_t i)
+{
+    snprintf(buffer, BENCH_FMT_SIZE, "%02d:%02d:%02d", (int)(i % 24), (int)(i % 60), (int)(i % 59));
+
+    return;
+}
+
+static void bench_fmt_boot(char *buffer, uint32_t i)
+{
+    fmt_snprintf(buffer, BENCH_FMT_SIZE, "%-15.15s %u MHz.", "Core Clock:", 72U + i % 2);
+
+    return;
+}
+
+static void bench_fmt_boot_ref(char *buffer, uint32_t i)
+{
+    snprintf(buffer, BENCH_FMT_SIZE, "%-15.15s %u MHz.", "Core Clock:", 72U + i % 2);
+
+    return;
+}
+
+static void bench_fmt_fixed(char *buffer, uint32_t i)
+{
+    char tmp[FMT_FIXED_SIZE];
+
+    fmt_snprintf(buffer, BENCH_FMT_SIZE, "Tmp: %s degC.", fmt_fixed(tmp, 2534 - (int32_t)(i % 5000), 2));
+
+    return;
+}
+
+/* Firmware printed temperature with float before fmt_fixed */
+static void bench_fmt_fixed_ref(char *buffer, uint32_t i)
+{
+    snprintf(buffer, BENCH_FMT_SIZE, "Tmp: %.2f degC.", (2534 - (int32_t)(i % 5000)) / 100.0);
+
+    return;
+}
+
+static void bench_fmt_hex(char *buffer, uint32_t i)
+{
+    fmt_snprintf(buffer, BENCH_FMT_SIZE, "%08x", i * 2654435761U);
+
+    return;
+}
+
+static void bench_fmt_hex_ref(char *buffer, uint32_t i)
+{
+    snprintf(buffer, BENCH_FMT_SIZE, "%08x", i * 2654435761U);
+
+    return;
+}
+
+static void bench_fmt_64(char *buffer, uint32_t i)
+{
+    fmt_snprintf(buffer, BENCH_FMT_SIZE, "%llu", (unsigned long long)i * 0x100000001ULL);
+
+    return;
+}
+
+static void bench_fmt_64_ref(char *buffer, uint32_t i)
+{
+    snprintf(buffer, BENCH_FMT_SIZE, "%llu", (unsigned long long)i * 0x100000001ULL);
+
+    return;
+}
@@ -0,0 +1,214 @@
+/**
+ **********************************************************************************************************************
+ * @file         bench_imath.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Benchmark of integer math against double sqrt, pow and atan2 of old joystick vector code.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "imath.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define BENCH_IMATH_ITERATIONS  1000000 //!< Default iterations of every case.
+#define BENCH_IMATH_RUNS        5       //!< Runs of every case, fastest one is reported.
+#define BENCH_IMATH_RANGE       1024    //!< Joystick range of axis.
+#define BENCH_IMATH_PI          3.14159265358979f
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Joystick like vector of iteration, spread over whole range of both axes. */
+#define BENCH_IMATH_X(I)        ((int32_t)(((I) * 37) % (2 * BENCH_IMATH_RANGE + 1)) - BENCH_IMATH_RANGE)
+#define BENCH_IMATH_Y(I)        ((int32_t)(((I) * 101) % (2 * BENCH_IMATH_RANGE + 1)) - BENCH_IMATH_RANGE)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+typedef struct
+{
+    const char *name;
+    int32_t (*run)(uint32_t i);     //!< Runs integer code once, i is iteration.
+    int32_t (*ref)(uint32_t i);     //!< Runs same with double code.
+} bench_imath_case_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static double bench_imath_time(int32_t (*run)(uint32_t i), uint32_t iterations);
+static int32_t bench_imath_vector(uint32_t i);
+static int32_t bench_imath_vector_ref(uint32_t i);
+static int32_t bench_imath_sqrt(uint32_t i);
+static int32_t bench_imath_sqrt_ref(uint32_t i);
+static int32_t bench_imath_atan2(uint32_t i);
+static int32_t bench_imath_atan2_ref(uint32_t i);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const bench_imath_case_t cases[] =
+    {
+        {"joystick vector", bench_imath_vector, bench_imath_vector_ref},
+        {"magnitude sqrt", bench_imath_sqrt, bench_imath_sqrt_ref},
+        {"direction atan2", bench_imath_atan2, bench_imath_atan2_ref},
+    };
+    uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_IMATH_ITERATIONS;
+    double time = 0;
+    double ref = 0;
+    uint32_t i = 0;
+
+    if(iterations == 0)
+    {
+        return 1;
+    }
+
+    printf("%-28s %12s %12s %8s\n", "case", "ns per call", "double", "speedup");
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        time = bench_imath_time(cases[i].run, iterations);
+        ref = bench_imath_time(cases[i].ref, iterations);
+        printf("%-28s %12.1f %12.1f %7.1fx\n", cases[i].name, time, ref, ref / time);
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Time case. Fastest of @ref BENCH_IMATH_RUNS runs is taken, so scheduling noise of host does not decide
+ *          comparison.
+ *
+ * @param   run         Case.
+ * @param   iterations  Calls of case in every run.
+ *
+ * @return  Time per call in ns.
+ */
+static double bench_imath_time(int32_t (*run)(uint32_t i), uint32_t iterations)
+{
+    uint64_t start = 0;
+    uint64_t time = 0;
+    uint64_t best = UINT64_MAX;
+    int32_t result = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for(i = 0; i < BENCH_IMATH_RUNS; i++)
+    {
+        start = host_time_ns();
+        for(j = 0; j < iterations; j++)
+        {
+            result = run(j);
+            HOST_KEEP(result);
+        }
+        time = host_time_ns() - start;
+        best = time < best ? time : best;
+    }
+
+    return (double)best / iterations;
+}
+
+/**
+ * @brief   Vector of joystick_get_vector().
+ */
+static int32_t bench_imath_vector(uint32_t i)
+{
+    uint32_t magn = 0;
+    int32_t x = BENCH_IMATH_X(i);
+    int32_t y = BENCH_IMATH_Y(i);
+
+    magn = imath_sqrt((uint32_t)(x * x + y * y));
+    if(magn > BENCH_IMATH_RANGE)
+    {
+        magn = BENCH_IMATH_RANGE;
+    }
+
+    return (int32_t)magn + IMATH_ANGLE_TO_DEG(imath_atan2(x, y));
+}
+
+/**
+ * @brief   Vector code of joystick_get_vector() before integer math.
+ */
+static int32_t bench_imath_vector_ref(uint32_t i)
+{
+    double magn = 0;
+    double dir = 0;
+    int16_t x = BENCH_IMATH_X(i);
+    int16_t y = BENCH_IMATH_Y(i);
+
+    magn = sqrt(pow(x, 2) + pow(y, 2));
+    if(magn > BENCH_IMATH_RANGE)
+    {
+        magn = BENCH_IMATH_RANGE;
+    }
+
+    dir = atan2(x, y);
+    if(dir < 0)
+    {
+        dir += 2 * BENCH_IMATH_PI;
+    }
+    dir = dir * 180 / BENCH_IMATH_PI;
+
+    return (int32_t)magn + (int32_t)dir;
+}
+
+static int32_t bench_imath_sqrt(uint32_t i)
+{
+    int32_t x = BENCH_IMATH_X(i);
+    int32_t y = BENCH_IMATH_Y(i);
+
+    return (int32_t)imath_sqrt((uint32_t)(x * x + y * y));
+}
+
+static int32_t bench_imath_sqrt_ref(uint32_t i)
+{
+    int16_t x = BENCH_IMATH_X(i);
+    int16_t y = BENCH_IMATH_Y(i);
+
+    return (int32_t)sqrt(pow(x, 2) + pow(y, 2));
+}
+
+static int32_t bench_imath_atan2(uint32_t i)
+{
+    return IMATH_ANGLE_TO_DEG(imath_atan2(BENCH_IMATH_X(i), BENCH_IMATH_Y(i)));
+}
+
+static int32_t bench_imath_atan2_ref(uint32_t i)
+{
+    double dir = atan2(BENCH_IMATH_X(i), BENCH_IMATH_Y(i));
+
+    return (int32_t)((dir < 0 ? dir + 2 * BENCH_IMATH_PI : dir) * 180 / BENCH_IMATH_PI);
+}
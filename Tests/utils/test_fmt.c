@@ -0,0 +1,185 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_fmt.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Host test of formatter against C library snprintf.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <limits.h>
+
+#include "fmt.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_FMT_SIZE           64      //!< Output buffer size.
+#define TEST_FMT_RANDOM         100000  //!< Random values per conversion.
+#define TEST_FMT_SEED           0x7F4A7C15  //!< Seed of random values.
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void test_fmt_compare(uint32_t size, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void test_fmt_conversions(void);
+static void test_fmt_lengths(void);
+static void test_fmt_truncation(void);
+static void test_fmt_random_values(void);
+static void test_fmt_fixed(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    host_random_seed(TEST_FMT_SEED);
+    test_fmt_conversions();
+    test_fmt_lengths();
+    test_fmt_truncation();
+    test_fmt_random_values();
+    test_fmt_fixed();
+
+    return host_test_result("fmt");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Format with both formatters and check that outputs are same. Length returned by fmt is what fits.
+ *
+ * @param   size    Buffer size given to both.
+ * @param   fmt     Format string.
+ */
+static void test_fmt_compare(uint32_t size, const char *fmt, ...)
+{
+    char out[TEST_FMT_SIZE];
+    char ref[TEST_FMT_SIZE];
+    uint32_t len = 0;
+    int ref_len = 0;
+    va_list args;
+    va_list ref_args;
+
+    va_start(args, fmt);
+    va_copy(ref_args, args);
+    len = fmt_vsnprintf(out, size, fmt, args);
+    ref_len = vsnprintf(ref, size, fmt, ref_args);
+    va_end(ref_args);
+    va_end(args);
+
+    if(!HOST_CHECK(strcmp(out, ref) == 0 && len == strlen(ref) && (uint32_t)ref_len >= len))
+    {
+        printf("  format \"%s\": \"%s\" expected \"%s\"\n", fmt, out, ref);
+    }
+
+    return;
+}
+
+static void test_fmt_conversions(void)
+{
+    test_fmt_compare(TEST_FMT_SIZE, "plain text");
+    test_fmt_compare(TEST_FMT_SIZE, "%d %i %d %d", 0, 42, -42, INT_MIN);
+    test_fmt_compare(TEST_FMT_SIZE, "%u %u %x %X %o", 0U, UINT_MAX, 0xDEADBEEFU, 0xDEADBEEFU, 0777U);
+    test_fmt_compare(TEST_FMT_SIZE, "[%5d] [%-5d] [%05d] [%+d] [% d] [%+05d]", 42, 42, -42, 42, 42, -42);
+    test_fmt_compare(TEST_FMT_SIZE, "[%.3d] [%8.3d] [%-8.3d] [%.0d] [%5.0d]", 7, -7, 7, 0, 0);
+    test_fmt_compare(TEST_FMT_SIZE, "[%*d] [%-*d] [%*d] [%.*d]", 6, 1, 6, 2, -6, 3, 4, 5);
+    test_fmt_compare(TEST_FMT_SIZE, "[%c] [%3c] [%-3c]", 'a', 'b', 'c');
+    test_fmt_compare(TEST_FMT_SIZE, "[%s] [%8s] [%-8s] [%.2s] [%-13.13s]", "abc", "abc", "abc", "abc", "A long string");
+    test_fmt_compare(TEST_FMT_SIZE, "100%% [%02d:%02d:%02d]", 1, 2, 3);
+
+    return;
+}
+
+static void test_fmt_lengths(void)
+{
+    test_fmt_compare(TEST_FMT_SIZE, "%hhd %hhu %hd %hu", 200, 300, 70000, 70000);
+    test_fmt_compare(TEST_FMT_SIZE, "%ld %lu %lx", LONG_MIN, ULONG_MAX, 0x12345678UL);
+    test_fmt_compare(TEST_FMT_SIZE, "%lld %lld", LLONG_MIN, LLONG_MAX);
+    test_fmt_compare(TEST_FMT_SIZE, "%llu %llx %llX %llo", ULLONG_MAX, ULLONG_MAX, 0x123456789ABCDEFULL, ULLONG_MAX);
+    test_fmt_compare(TEST_FMT_SIZE, "[%24lld] [%-24llu] [%024lld] [%+lld]", -1LL, 1ULL << 40, -(1LL << 50),
+                     1LL << 33);
+    test_fmt_compare(TEST_FMT_SIZE, "%zu %zx %d", sizeof(uint64_t), (size_t)-1, 7);
+    /* Argument after 64 bit one must be read from right place */
+    test_fmt_compare(TEST_FMT_SIZE, "%d %llu %d %lld %s", 1, 1ULL << 63, 2, -3LL, "end");
+
+    return;
+}
+
+static void test_fmt_truncation(void)
+{
+    uint32_t size = 0;
+
+    for(size = 1; size <= 24; size++)
+    {
+        test_fmt_compare(size, "%s %llu %-6d|", "truncated", ULLONG_MAX, -12);
+    }
+
+    return;
+}
+
+static void test_fmt_random_values(void)
+{
+    uint64_t value = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < TEST_FMT_RANDOM; i++)
+    {
+        /* Random magnitudes, so short values are tested as often as long ones */
+        value = (((uint64_t)host_random() << 32) | host_random()) >> (host_random() % 64);
+        test_fmt_compare(TEST_FMT_SIZE, "%d %u %x %o", (int)value, (unsigned)value, (unsigned)value, (unsigned)value);
+        test_fmt_compare(TEST_FMT_SIZE, "%lld %llu %llx %llo", (long long)value, (unsigned long long)value,
+                         (unsigned long long)value, (unsigned long long)value);
+        test_fmt_compare(TEST_FMT_SIZE, "%*lld|%-*.*llu", (int)(i % 24), -(long long)value, (int)(i % 30),
+                         (int)(i % 22), (unsigned long long)value);
+    }
+
+    return;
+}
+
+static void test_fmt_fixed(void)
+{
+    char buffer[FMT_FIXED_SIZE];
+
+    HOST_CHECK(strcmp(fmt_fixed(buffer, 2534, 2), "25.34") == 0);
+    HOST_CHECK(strcmp(fmt_fixed(buffer, -5, 2), "-0.05") == 0);
+    HOST_CHECK(strcmp(fmt_fixed(buffer, -17, 0), "-17") == 0);
+    HOST_CHECK(strcmp(fmt_fixed(buffer, INT32_MIN, 9), "-2.147483648") == 0);
+
+    return;
+}
@@ -0,0 +1,245 @@
+/**
+ **********************************************************************************************************************
+ * @file         test_imath.c
+ * @author       Diamond Sparrow
+ * @version      1.0.0.0
+ * @date         2026-10-17
+ * @brief        Accuracy of integer math against C library.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "imath.h"
+#include "host_test.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+#define TEST_IMATH_RANGE        1024    //!< Vector grid range, like joystick.
+#define TEST_IMATH_SQRT_COUNT   (1UL << 22) //!< Square roots checked one by one from 0.
+#define TEST_IMATH_VECTORS      100000  //!< Random large vectors.
+#define TEST_IMATH_SEED         0x9E3779B9  //!< Seed of random vectors.
+#define TEST_IMATH_PI           3.14159265358979323846
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+/** Binary angle to degrees. */
+#define TEST_IMATH_DEG(A)       ((double)(A) * 360 / 65536)
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static double test_imath_angle_diff(double a, double b);
+static void test_imath_sqrt(void);
+static void test_imath_joystick(void);
+static void test_imath_vector(void);
+static void test_imath_sincos(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    host_random_seed(TEST_IMATH_SEED);
+    test_imath_sqrt();
+    test_imath_joystick();
+    test_imath_vector();
+    test_imath_sincos();
+
+    return host_test_result("imath");
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Difference of angles on circle.
+ *
+ * @param   a   Angle in degrees.
+ * @param   b   Angle in degrees.
+ *
+ * @return  Difference 0 to 180 degrees.
+ */
+static double test_imath_angle_diff(double a, double b)
+{
+    double diff = fmod(fabs(a - b), 360);
+
+    return diff > 180 ? 360 - diff : diff;
+}
+
+/**
+ * @brief   Square root is rounded down, checked for small values one by one, around squares and at range end.
+ */
+static void test_imath_sqrt(void)
+{
+    uint64_t root = 0;
+    uint32_t value = 0;
+    uint32_t wrong = 0;
+    uint32_t i = 0;
+
+    for(value = 0; value < TEST_IMATH_SQRT_COUNT; value++)
+    {
+        root = imath_sqrt(value);
+        wrong += root * root > value || (root + 1) * (root + 1) <= value;
+    }
+    for(root = 1; root < 65536; root += 7)
+    {
+        wrong += imath_sqrt((uint32_t)(root * root)) != root;
+        wrong += imath_sqrt((uint32_t)(root * root - 1)) != root - 1;
+    }
+    for(i = 0; i < TEST_IMATH_VECTORS; i++)
+    {
+        value = host_random();
+        root = imath_sqrt(value);
+        wrong += root * root > value || (root + 1) * (root + 1) <= value;
+    }
+    HOST_CHECK(imath_sqrt(UINT32_MAX) == 65535);
+    HOST_CHECK(wrong == 0);
+
+    return;
+}
+
+/**
+ * @brief   Magnitude and direction of joystick vector, computed like joystick_get_vector, against double code it
+ *          replaced.
+ */
+static void test_imath_joystick(void)
+{
+    double error = 0;
+    double diff = 0;
+    uint32_t degrees = 0;
+    uint32_t wrong = 0;
+    int32_t ref = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+
+    for(x = -TEST_IMATH_RANGE; x <= TEST_IMATH_RANGE; x++)
+    {
+        for(y = -TEST_IMATH_RANGE; y <= TEST_IMATH_RANGE; y++)
+        {
+            if(x == 0 && y == 0)
+            {
+                continue;
+            }
+
+            /* Magnitude is unchanged */
+            wrong += imath_sqrt((uint32_t)(x * x + y * y)) != (uint32_t)sqrt(pow(x, 2) + pow(y, 2));
+
+            diff = test_imath_angle_diff(TEST_IMATH_DEG(imath_atan2(x, y)), atan2(x, y) * 180 / TEST_IMATH_PI);
+            error = diff > error ? diff : error;
+
+            /* Whole degrees differ only at rounding boundary */
+            ref = (int32_t)floor(atan2(x, y) * 180 / TEST_IMATH_PI);
+            ref = ref < 0 ? ref + 360 : ref;
+            if(IMATH_ANGLE_TO_DEG(imath_atan2(x, y)) != ref)
+            {
+                degrees++;
+                wrong += test_imath_angle_diff(IMATH_ANGLE_TO_DEG(imath_atan2(x, y)), ref) > 1;
+            }
+        }
+    }
+    printf("joystick: max direction error %.4f deg, whole degrees differ for %u vectors\n", error, degrees);
+
+    /* Half of binary angle step is 0.0027 degrees */
+    HOST_CHECK(error < 0.003);
+    HOST_CHECK(wrong == 0);
+
+    return;
+}
+
+/**
+ * @brief   Magnitude of large vectors, within 1 of exact value for coordinates below 2^24, error above it grows
+ *          with magnitude.
+ */
+static void test_imath_vector(void)
+{
+    double error = 0;
+    double relative = 0;
+    double exact = 0;
+    double diff = 0;
+    uint16_t angle = 0;
+    uint32_t magn = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < TEST_IMATH_VECTORS; i++)
+    {
+        x = (int32_t)host_random() >> 8;
+        y = (int32_t)host_random() >> 8;
+        magn = imath_vector(x, y, &angle);
+        diff = fabs((double)magn - hypot(x, y));
+        error = diff > error ? diff : error;
+
+        x = (int32_t)host_random() >> 3;
+        y = (int32_t)host_random() >> 3;
+        magn = imath_vector(x, y, &angle);
+        exact = hypot(x, y);
+        diff = (fabs((double)magn - exact) - 1) / exact;
+        relative = diff > relative ? diff : relative;
+    }
+    printf("vector: max magnitude error %.3f below 2^24, %.2e of magnitude besides 1 below 2^29\n", error,
+        relative);
+
+    HOST_CHECK(error <= 1.0);
+    HOST_CHECK(relative <= 5e-8);
+    HOST_CHECK(imath_vector(0, 0, &angle) == 0 && angle == 0);
+    HOST_CHECK(imath_atan2(0, 0) == 0);
+
+    return;
+}
+
+/**
+ * @brief   Sine and cosine of every binary angle within 1 LSB of Q15.
+ */
+static void test_imath_sincos(void)
+{
+    double error = 0;
+    double ref = 0;
+    int16_t sin_q = 0;
+    int16_t cos_q = 0;
+    uint32_t angle = 0;
+
+    for(angle = 0; angle < 65536; angle++)
+    {
+        imath_sincos((uint16_t)angle, &sin_q, &cos_q);
+        ref = fmin(sin(angle * 2 * TEST_IMATH_PI / 65536) * 32768, INT16_MAX);
+        error = fmax(error, fabs(sin_q - ref));
+        ref = fmin(cos(angle * 2 * TEST_IMATH_PI / 65536) * 32768, INT16_MAX);
+        error = fmax(error, fabs(cos_q - ref));
+    }
+    printf("sincos: max error %.3f LSB\n", error);
+
+    HOST_CHECK(error <= 1.0);
+
+    return;
+}
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary ADC stream of the controller CLI.
+
+Frames are described in Code/APP/adc_stream.h:
+    A5 5A id n seq(16) n * sample(16) crc8
+multi-byte fields are little endian, CRC-8 has polynomial 0x07 and covers
+bytes from id to the last sample. Text printed by the firmware between frames
+is skipped. Sequence numbers are unwrapped per channel, so gaps show samples
+the stream could not keep up with.
+
+Samples are the decimated filter output of each channel; rate and resolution
+follow the channel filter. With --raw the firmware streams raw 12 bit
+conversions instead and marks their frames with bit 7 of id, which is masked
+off here. UART bandwidth limits raw streams, gaps count as lost samples.
+
+Output rows are (channel, sequence, sample). CSV has a header line, NPY is a
+two dimensional int64 array of the same columns.
+
+Example:
+    python3 Tools/adc_stream.py --port /dev/ttyUSB0 --channels 1 2 \\
+        --duration 10 --csv current.csv
+    python3 Tools/adc_stream.py --input capture.bin --npy capture.npy
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+SYNC = b'\xa5\x5a'
+HEADER = 6
+SAMPLES_MAX = 16
+RAW = 0x80
+
+
+def crc8(data):
+    """CRC-8, polynomial 0x07, initial value 0."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class Decoder:
+    """Incremental frame decoder."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.next_seq = {}
+        self.rows = []
+        self.lost = 0
+        self.bad = 0
+
+    def feed(self, data):
+        """Decode all complete frames of data, keep the rest for next call."""
+        self.buffer += data
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                del self.buffer[:max(len(self.buffer) - 1, 0)]
+                return
+            del self.buffer[:start]
+            if len(self.buffer) < HEADER:
+                return
+            count = self.buffer[3]
+            size = HEADER + 2 * count + 1
+            if count == 0 or count > SAMPLES_MAX:
+                self.bad += 1
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < size:
+                return
+            frame = bytes(self.buffer[:size])
+            if crc8(frame[2:size - 1]) != frame[size - 1]:
+                self.bad += 1
+                del self.buffer[:1]
+                continue
+            del self.buffer[:size]
+            self.add(frame[2] & ~RAW, struct.unpack_from('<H', frame, 4)[0],
+                     struct.unpack_from('<%dH' % count, frame, HEADER))
+
+    def add(self, channel, seq, samples):
+        """Store samples with unwrapped sequence numbers."""
+        expected = self.next_seq.get(channel)
+        if expected is None:
+            index = seq
+        else:
+            gap = (seq - expected) & 0xFFFF
+            self.lost += gap
+            index = expected + gap
+        for i, sample in enumerate(samples):
+            self.rows.append((channel, index + i, sample))
+        self.next_seq[channel] = index + len(samples)
+
+
+def write_csv(path, rows):
+    with open(path, 'w') as f:
+        f.write('channel,sequence,sample\n')
+        for row in rows:
+            f.write('%d,%d,%d\n' % row)
+
+
+def write_npy(path, rows):
+    """Write NPY version 1.0 file without numpy."""
+    header = "{'descr': '<i8', 'fortran_order': False, 'shape': (%d, 3), }" % len(rows)
+    pad = 64 - (10 + len(header) + 1) % 64
+    header = header + ' ' * (pad % 64) + '\n'
+    with open(path, 'wb') as f:
+        f.write(b'\x93NUMPY\x01\x00' + struct.pack('<H', len(header)) + header.encode('latin1'))
+        for row in rows:
+            f.write(struct.pack('<3q', *row))
+
+
+def read_serial(args, decoder):
+    try:
+        import serial
+    except ImportError:
+        sys.exit('adc_stream: pyserial is needed for --port')
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    if args.channels:
+        action = 'raw' if args.raw else 'start'
+        port.write(('stream %s %s\r' % (action, ' '.join(str(c) for c in args.channels))).encode())
+    end = time.monotonic() + args.duration
+    try:
+        while time.monotonic() < end:
+            decoder.feed(port.read(4096))
+    except KeyboardInterrupt:
+        pass
+    if args.channels:
+        port.write(b'stream stop\r')
+    port.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode binary ADC stream.')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--port', help='serial port of controller')
+    source.add_argument('--input', help='captured stream file, - for stdin')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--channels', type=int, nargs='*', help='adc_id_t channels to start, needs --port')
+    parser.add_argument('--raw', action='store_true', help='stream raw conversions, needs --channels')
+    parser.add_argument('--duration', type=float, default=5.0, help='capture time in seconds')
+    parser.add_argument('--csv', help='CSV output file')
+    parser.add_argument('--npy', help='NPY output file')
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    if args.port:
+        read_serial(args, decoder)
+    elif args.input == '-':
+        decoder.feed(sys.stdin.buffer.read())
+    else:
+        with open(args.input, 'rb') as f:
+            decoder.feed(f.read())
+
+    if args.csv:
+        write_csv(args.csv, decoder.rows)
+    if args.npy:
+        write_npy(args.npy, decoder.rows)
+    sys.stderr.write('%d samples, %d lost, %d bad frames\n' % (len(decoder.rows), decoder.lost, decoder.bad))
+
+
+if __name__ == '__main__':
+    main()
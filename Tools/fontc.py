@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+Font compiler for the SSD1306 driver.
+
+Reads the row bitmaps (uint16_t per row, MSB is left pixel, ASCII 32-126) from
+Code/APP/display/fonts.c and writes flash resident fonts_t tables in SSD1306
+page layout: for every glyph page 0 bytes of all columns come first, then page 1
+and so on, bit 0 of a byte is the top row of the page. Glyphs can be run length
+encoded and the font can be limited to characters the firmware prints.
+
+RLE stream is made of blocks, control byte c:
+    c & 0x80    (c & 0x7F) + 1 copies of next byte,
+    otherwise   c + 1 literal bytes follow.
+
+Example:
+    python3 Tools/fontc.py --source Code/APP/display/fonts.c \\
+        --output Code/APP/display/fonts_packed.c --rle \\
+        --font fonts_7x10:7x10 --font "fonts_11x18:11x18: -.0123456789:DS"
+"""
+
+import argparse
+import re
+import sys
+
+FIRST_CHAR = 32
+LAST_CHAR = 126
+RUN_MAX = 128
+
+
+def read_rows(source, name):
+    """Return list of row values of array <name>_data from C source."""
+    m = re.search(r'%s_data\s*\[\s*\]\s*=\s*\{(.*?)\};' % re.escape(name), source, re.S)
+    if m is None:
+        sys.exit('fontc: array %s_data not found' % name)
+    body = re.sub(r'//[^\n]*', '', m.group(1))
+    return [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', body)]
+
+
+def glyph_pages(rows, width, height):
+    """Convert glyph rows to page major bytes."""
+    pages = (height + 7) // 8
+    out = bytearray(pages * width)
+    for y in range(height):
+        for x in range(width):
+            if (rows[y] << x) & 0x8000:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return out
+
+
+def rle(data):
+    """Encode bytes with run length encoding described above."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < RUN_MAX:
+            run += 1
+        if run >= 2:
+            if literal:
+                out += bytes([len(literal) - 1]) + literal
+                literal = bytearray()
+            out += bytes([0x80 | (run - 1), data[i]])
+            i += run
+        else:
+            literal.append(data[i])
+            if len(literal) == RUN_MAX:
+                out += bytes([len(literal) - 1]) + literal
+                literal = bytearray()
+            i += 1
+    if literal:
+        out += bytes([len(literal) - 1]) + literal
+    return out
+
+
+def c_bytes(data, indent='    '):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ', '.join('0x%02X' % b for b in data[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+
+def c_string(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def compile_font(source, spec, use_rle):
+    parts = spec.split(':', 2)
+    if len(parts) < 2:
+        sys.exit('fontc: font must be given as name:WxH[:charset]')
+    name = parts[0]
+    width, height = (int(v) for v in parts[1].lower().split('x'))
+    charset = parts[2] if len(parts) == 3 else None
+    if width > 16 or height > 32:
+        sys.exit('fontc: %s is too big, max 16x32' % name)
+
+    rows = read_rows(source, name)
+    if len(rows) != (LAST_CHAR - FIRST_CHAR + 1) * height:
+        sys.exit('fontc: %s has %d rows, expected %d' % (name, len(rows), (LAST_CHAR - FIRST_CHAR + 1) * height))
+
+    chars = charset if charset is not None else ''.join(chr(c) for c in range(FIRST_CHAR, LAST_CHAR + 1))
+    for ch in chars:
+        if not FIRST_CHAR <= ord(ch) <= LAST_CHAR:
+            sys.exit('fontc: %s character %r is not in font' % (name, ch))
+
+    glyphs = []
+    for ch in chars:
+        index = (ord(ch) - FIRST_CHAR) * height
+        glyphs.append(glyph_pages(rows[index:index + height], width, height))
+
+    packed = bytearray()
+    offsets = []
+    if use_rle:
+        for g in glyphs:
+            offsets.append(len(packed))
+            packed += rle(g)
+        if len(packed) + 2 * len(offsets) >= sum(len(g) for g in glyphs):
+            # Compression does not pay off for this font
+            packed = bytearray()
+            offsets = []
+    if not offsets:
+        for g in glyphs:
+            packed += g
+    if len(packed) > 0xFFFF:
+        sys.exit('fontc: %s does not fit 16 bit offsets' % name)
+
+    text = []
+    text.append('/* %dx%d, %d glyphs, %d bytes%s */' % (width, height, len(chars), len(packed) + 2 * len(offsets),
+                                                          ', RLE' if offsets else ''))
+    text.append('static const uint8_t %s_pages[] =' % name)
+    text.append('{')
+    text.append(c_bytes(packed))
+    text.append('};')
+    text.append('')
+    if offsets:
+        text.append('static const uint16_t %s_offsets[] =' % name)
+        text.append('{')
+        for i in range(0, len(offsets), 12):
+            text.append('    ' + ', '.join('%d' % v for v in offsets[i:i + 12]) + ',')
+        text.append('};')
+        text.append('')
+    text.append('fonts_t %s =' % name)
+    text.append('{')
+    text.append('    .font_width = %d,' % width)
+    text.append('    .font_height = %d,' % height)
+    text.append('    .format = %s,' % ('FONTS_FORMAT_PAGES_RLE' if offsets else 'FONTS_FORMAT_PAGES'))
+    text.append('    .pages = %s_pages,' % name)
+    if offsets:
+        text.append('    .offsets = %s_offsets,' % name)
+    if charset is not None:
+        text.append('    .charset = %s,' % c_string(charset))
+    text.append('};')
+    text.append('')
+    return '\n'.join(text), len(packed) + 2 * len(offsets)
+
+
+HEADER = '''/**
+ **********************************************************************************************************************
+ * @file        %s
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-17
+ * @brief       Page packed fonts. Generated by Tools/fontc.py, do not edit.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \\n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+#include "fonts.h"
+
+#if !FONTS_ROW_FONTS
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+/* %s */
+
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile row fonts to SSD1306 page packed fonts.')
+    parser.add_argument('--source', required=True, help='C file with <name>_data row arrays')
+    parser.add_argument('--output', required=True, help='C file to write')
+    parser.add_argument('--font', action='append', required=True, help='name:WxH[:charset]')
+    parser.add_argument('--rle', action='store_true', help='run length encode glyphs when it saves space')
+    args = parser.parse_args()
+
+    with open(args.source) as f:
+        source = f.read()
+
+    command = 'fontc.py' + (' --rle' if args.rle else '') + ''.join(' --font "%s"' % s for s in args.font)
+    out = HEADER % (args.output.replace('\\', '/').split('/')[-1], command)
+    for spec in args.font:
+        text, size = compile_font(source, spec, args.rle)
+        out += text + '\n'
+        print('%s: %d bytes' % (spec.split(':')[0], size))
+    out += '#endif // !FONTS_ROW_FONTS\n'
+
+    with open(args.output, 'w', newline='\n') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main()